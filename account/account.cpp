@@ -1,8 +1,9 @@
 #include "account/account.hpp"
+#include "snapshot/snapshot.hpp"
 
 account::account(double equity) : equity(equity), freeCash(equity), reservedMargin(0.0) {
     profitAndLoss.realizedPnL = 0.0;
-    profitAndLoss.realizedPnL = 0.0;
+    profitAndLoss.unrealizedPnL = 0.0;
 }
 
 void account::updateEquity(){
@@ -29,10 +30,28 @@ double account::availableFreeCash(){
     return freeCash;
 }
 
+double account::currentEquity() const {
+    return equity;
+}
+
 void account::updateReservedMargin(double amount){
     reservedMargin += amount;
 }
 
 void account::updateFreeCash(double amount){
     freeCash += amount;
-}
\ No newline at end of file
+}
+
+void account::save(snapshotWriter& out) const {
+    out.put(profitAndLoss);
+    out.put(equity);
+    out.put(freeCash);
+    out.put(reservedMargin);
+}
+
+void account::load(snapshotReader& in){
+    profitAndLoss = in.get<struct profitAndLoss>();
+    equity = in.get<double>();
+    freeCash = in.get<double>();
+    reservedMargin = in.get<double>();
+}
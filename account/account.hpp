@@ -1,6 +1,9 @@
 #pragma once
 #include "marketTypes/marketTypes.hpp"
 
+class snapshotWriter;
+class snapshotReader;
+
 struct profitAndLoss {
     double realizedPnL;
     double unrealizedPnL;
@@ -17,6 +20,7 @@ private:
 public:
     account(double equity);
     double availableFreeCash();
+    double currentEquity() const;
 
     double markToMarket(double currentPrice, double entryPrice, double qty, ordertype side);
     
@@ -25,4 +29,7 @@ public:
     void updateFreeCash(double amount);
     void updateReservedMargin(double amount);
     void updateUnrealizedPnl(double amount);
+
+    void save(snapshotWriter& out) const;
+    void load(snapshotReader& in);
 };
\ No newline at end of file
@@ -1,9 +1,57 @@
 #include "BacktestCtrl.h"
-#include "Parser.hpp"
-#include "Lexer.hpp"
+#include "strategyCache.hpp"
+#include "rabbitQueue/apiConnection.h"
+#include "rabbitQueue/publishRabbit.h"
 #include <drogon/HttpAppFramework.h>
 #include <json/json.h>
+#include <format>
 #include <memory>
+#include <mutex>
+
+#define STRATEGY_CACHE_ENTRIES 512
+#define BACKTEST_QUEUE "backtest_tasks"
+
+// ==== Compiled strategies, shared by every Drogon worker thread ==== //
+static strategyCache& compiledStrategies(){
+    static strategyCache cache(STRATEGY_CACHE_ENTRIES);
+    return cache;
+}
+
+// ==== One AMQP channel, opened on first use: channels are not thread-safe, publishes are serialized ==== //
+static void publishImage(const std::vector<char>& image, const std::unordered_map<std::string, double>& parameters){
+    static std::mutex mutex;
+    static std::unique_ptr<rabbitMQ> rabbit;
+    std::lock_guard<std::mutex> lock(mutex);
+
+    try {
+        if (!rabbit){
+            APIConnect api("guest", "guest");
+            api.init_options("localhost", "/", 5672);
+            api.authorize();
+            rabbit = std::make_unique<rabbitMQ>();
+            rabbit->channel_ = api.channel_;
+        }
+        rabbit->publish_to_queue(BACKTEST_QUEUE, image, parameters);
+    } catch (...) {
+        // ==== Broken channel: reopened by the next request ==== //
+        rabbit.reset();
+        throw;
+    }
+}
+
+// ==== "parameters": { name: number, ... } -> overrides, anything else is rejected ==== //
+static std::unordered_map<std::string, double> parameterOverrides(const Json::Value& json){
+    std::unordered_map<std::string, double> overrides;
+    if (json.isNull()) return overrides;
+    if (!json.isObject()) throw std::runtime_error("'parameters' must be an object");
+
+    for (const auto& name : json.getMemberNames()){
+        const auto& value = json[name];
+        if (!value.isNumeric()) throw std::runtime_error(std::format("Parameter '{}' must be a number", name));
+        overrides[name] = value.asDouble();
+    }
+    return overrides;
+}
 
 void BacktestCtrl::asyncHandleHttpRequest(const drogon::HttpRequestPtr& req, std::function<void (const drogon::HttpResponsePtr &)> &&callback)
 {
@@ -26,18 +74,36 @@ void BacktestCtrl::asyncHandleHttpRequest(const drogon::HttpRequestPtr& req, std
 
     try {
 
-        // ==== Lexer init ==== //
-        Lexer lexer(strategyText);
-        std::vector<Token> tokens_ = lexer.get_tokens();
+        // ==== Lex + parse only when this script was never seen (whitespace-insensitive) ==== //
+        bool cached = false;
+        auto compiled = compiledStrategies().get(strategyText, &cached);
+
+        // ==== Overrides bind onto the cached program, the tree is not touched ==== //
+        const auto bound = compiled->bind(parameterOverrides((*json)["parameters"]));
 
-        // ==== Create parser class object ==== //
-        Parser parser(tokens_);
+        Json::Value body;
+        body["status"] = "ok";
+        body["strategy"] = compiled->name;
+        body["cached"] = cached;
+        body["hash"] = std::format("{:016x}", compiled->hash);
+        for (const auto& [name, value] : bound) body["parameters"][name] = value;
+        for (const auto& request : compiled->data) body["tickers"].append(request.ticker);
 
-        // ==== Parsed AST tree ==== //
-        auto ast = parser.parse_strategy(); // возвращает AST дерева стратегии
+        // ==== The worker runs the image in place with the same overrides ==== //
+        try {
+            publishImage(compiled->image, bound);
+        } catch (const std::exception& e) {
+            Json::Value error;
+            error["status"] = "error";
+            error["message"] = std::format("Backtest queue unavailable: {}", e.what());
+            auto resp = drogon::HttpResponse::newHttpJsonResponse(error);
+            resp->setStatusCode(drogon::k503ServiceUnavailable);
+            callback(resp);
+            return;
+        }
 
-        // publish_to_rabbitmq(ast);
-        auto resp = drogon::HttpResponse::newHttpJsonResponse({{"status","ok"}});
+        body["queued"] = true;
+        auto resp = drogon::HttpResponse::newHttpJsonResponse(body);
         callback(resp);
 
     } catch (const std::exception &e) {
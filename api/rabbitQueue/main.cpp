@@ -1,6 +1,7 @@
 #include "apiConnection.h"
 #include "publishRabbit.h"
 #include "worker.h"
+#include <cstdlib>
 
 int main() {
     try {
@@ -11,7 +12,8 @@ int main() {
         rabbitMQ rabbit;
         rabbit.channel_ = API.channel_;
         rabbit.publish_to_queue("backtest_tasks","Daniel!");
-        Worker Worker(API.channel_);
+        const char* api_key = std::getenv("OCTURN_API_KEY");
+        Worker Worker(API.channel_, api_key ? api_key : "");
         Worker.subscribe_to_queue("backtest_tasks");
         Worker.consume_message();
 
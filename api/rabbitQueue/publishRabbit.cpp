@@ -19,3 +19,22 @@ void rabbitMQ::publish_to_queue(std::string queue_name,std::string backtest_stra
     auto message = AmqpClient::BasicMessage::Create(backtest_strategy);
     channel_->BasicPublish("", queue_name, message);
 }
+
+void rabbitMQ::publish_to_queue(std::string queue_name,const std::vector<char>& strategy_image,
+                                const std::unordered_map<std::string,double>& parameters){
+
+    if (!channel_) {
+    throw std::runtime_error("Channel is not authorized. Call authorize() first.");
+    }
+
+    channel_->DeclareQueue(queue_name, false, true, false, false);
+
+    auto message = AmqpClient::BasicMessage::Create(std::string(strategy_image.begin(), strategy_image.end()));
+    message->ContentType("application/octet-stream");
+    if (!parameters.empty()) {
+        AmqpClient::Table headers;
+        for (const auto& [name, value] : parameters) headers[name] = AmqpClient::TableValue(value);
+        message->HeaderTable(headers);
+    }
+    channel_->BasicPublish("", queue_name, message);
+}
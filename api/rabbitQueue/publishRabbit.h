@@ -1,6 +1,9 @@
 #pragma once
 #include <SimpleAmqpClient/SimpleAmqpClient.h>
 #include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 class rabbitMQ{
     public:
@@ -9,6 +12,9 @@ class rabbitMQ{
 
     // ==== Publish to queue channel ==== //
     void publish_to_queue(std::string queue_name,std::string backtest_strategy);
+    // ==== Compiled strategy image (compiler/strategyImage.hpp), sent as raw bytes, parameter overrides as headers ==== //
+    void publish_to_queue(std::string queue_name,const std::vector<char>& strategy_image,
+                          const std::unordered_map<std::string,double>& parameters = {});
 
     AmqpClient::Channel::ptr_t channel_;
     AmqpClient::Channel::OpenOpts connection_options;
@@ -1,8 +1,42 @@
 #include <SimpleAmqpClient/SimpleAmqpClient.h>
+#include <cstring>
+#include <format>
 #include "log/logHandler.hpp"
+#include "compiler/strategyImage.hpp"
+#include "interpreter/Interpreter.hpp"
+#include "marketDataView/DataLayer.hpp"
+#include "backtester/backtestRunner.hpp"
 #include "worker.h"
 
-Worker::Worker(AmqpClient::Channel::ptr_t channel_ptr) : channel_(std::move(channel_ptr)){}
+Worker::Worker(AmqpClient::Channel::ptr_t channel_ptr, std::string api_key)
+    : channel_(std::move(channel_ptr)), api_key_(std::move(api_key)){}
+
+// ==== Numeric headers of the message = parameter overrides bound by the API ==== //
+static std::unordered_map<std::string,double> parameter_headers(const AmqpClient::BasicMessage& message){
+    std::unordered_map<std::string,double> parameters;
+    if (!message.HeaderTableIsSet()) return parameters;
+
+    for (const auto& [name, value] : message.HeaderTable()){
+        if (value.GetType() == AmqpClient::TableValue::VT_double) parameters[name] = value.GetDouble();
+    }
+    return parameters;
+}
+
+void Worker::run_image(const std::vector<uint64_t>& buffer, size_t size, const std::unordered_map<std::string,double>& parameters){
+    strategyImage image(reinterpret_cast<const char*>(buffer.data()), size);
+    const auto requests = image.requests();
+    if (requests.empty()) throw std::runtime_error("Strategy image has no data block");
+
+    // ==== The buffer outlives the interpreter: the image is read in place, never rebuilt into a tree ==== //
+    Interpreter interpreter(image, MarketDataView(api_key_));
+    interpreter.run();
+    const auto [entries, exits] = interpreter.evaluate_signals(parameters);
+
+    config cfg = interpreter.get_config();
+    const auto result = runBacktest(interpreter.get_data(), cfg, requests.front().ticker, entries, exits);
+    g_logger.report(std::format("[RABBIT] Strategy {} on {}: {} trades, realized PnL {}",
+        image.name(), requests.front().ticker, result.tradeCount(), result.realizedPnL));
+}
 
 void Worker::subscribe_to_queue(std::string queue_name){
     consumer_tag = channel_->BasicConsume(queue_name);
@@ -13,8 +47,19 @@ void Worker::consume_message(){
             AmqpClient::Envelope::ptr_t envelope = channel_->BasicConsumeMessage(consumer_tag);
             std::string message = envelope->Message()->Body();
 
-            g_logger.report(std::string("[RABBIT] Received: ") + message);
+            if (envelope->Message()->ContentType() != "application/octet-stream") {
+                g_logger.report(std::string("[RABBIT] Received: ") + message);
+                continue;
+            }
+
+            // ==== Strategy image: copied once to an 8-byte aligned buffer, then validated and run in place ==== //
+            std::vector<uint64_t> buffer((message.size() + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+            std::memcpy(buffer.data(), message.data(), message.size());
 
-            // Тут можно сделать обработку, например вызвать функцию бэктеста
+            try {
+                run_image(buffer, message.size(), parameter_headers(*envelope->Message()));
+            } catch (const std::exception& e) {
+                g_logger.report(std::format("[RABBIT] Rejected strategy image: {}", e.what()));
+            }
         }
 }
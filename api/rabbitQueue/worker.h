@@ -1,11 +1,14 @@
 #include <SimpleAmqpClient/SimpleAmqpClient.h>
 #include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 class Worker{
     public:
 
-    // ==== Constructor ==== //
-    Worker(AmqpClient::Channel::ptr_t channel_ptr);
+    // ==== Constructor, api_key is used to fetch the market data of every strategy image ==== //
+    Worker(AmqpClient::Channel::ptr_t channel_ptr, std::string api_key);
 
     // ==== Attach worker to the queue ==== //
     void subscribe_to_queue(std::string queue_name);
@@ -15,6 +18,10 @@ class Worker{
 
     private:
 
+    // ==== Fetches the image's data, evaluates it in place and backtests its first ticker ==== //
+    void run_image(const std::vector<uint64_t>& buffer, size_t size, const std::unordered_map<std::string,double>& parameters);
+
     std::string consumer_tag;
     AmqpClient::Channel::ptr_t channel_;
+    std::string api_key_;
 };
\ No newline at end of file
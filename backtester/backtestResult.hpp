@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "metrics/performanceMetrics.hpp"
+#include "trade/tradeLog.hpp"
+
+// ====================================================== //
+//                   Backtest result
+// - Common output of the event loop and the vectorized path
+// - Closed trades kept column-wise (one row per trade)
+// - Metrics / equity curve are filled while the run steps
+// ====================================================== //
+struct backtestResult {
+    double finalEquity = 0.0;
+    double realizedPnL = 0.0;
+    bool vectorized = false;
+    performanceMetrics metrics;
+    tradeLog trades;
+
+    void append(uint32_t ticker, ordertype type, size_t entry, size_t exit,
+                double filledQty, double avgPrice, double closePrice, double tradePnL) {
+        trades.append(ticker, type, entry, exit, filledQty, avgPrice, closePrice, tradePnL);
+        realizedPnL += tradePnL;
+    }
+
+    size_t tradeCount() const { return trades.size(); }
+};
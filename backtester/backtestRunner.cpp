@@ -0,0 +1,31 @@
+#include "backtestRunner.hpp"
+
+#include <format>
+
+#include "backtester/portfolioBacktester.hpp"
+#include "backtester/vectorizedBacktester.hpp"
+#include "config/slippageTable.hpp"
+#include "execution/executionEngine.hpp"
+#include "log/logHandler.hpp"
+
+backtestResult runBacktest(const std::unordered_map<std::string, AnyValue>& data, config& cfg,
+                           const std::string& ticker, const std::vector<bool>& entries, const std::vector<bool>& exits,
+                           size_t begin, size_t end){
+
+    cfg.slippage = ExecutionEngine::getSlippageParams(cfg, slippageTable);
+
+    backtestResult result;
+    if (vectorizedBacktester::qualifies(cfg)){
+        vectorizedBacktester fastPath(data, cfg);
+        if (fastPath.run(ticker, entries, exits, result, begin, end)){
+            return result;
+        }
+        g_logger.report(std::format("[BACKTEST] {} needs the event loop, vectorized path declined", ticker));
+    }
+
+    portfolioBacktester eventLoop(data, cfg);
+    eventLoop.addTicker(ticker, entries, exits, begin, end);
+    eventLoop.execute();
+
+    return eventLoop.result();
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "config/config.hpp"
+#include "types/types.hpp"
+#include "backtester/backtestResult.hpp"
+
+using Octurn::AnyValue;
+
+// ====================================================== //
+//                 Single ticker backtest
+// - Picks the vectorized fast path when the strategy qualifies
+// - Falls back to the portfolio event loop otherwise, or when
+//   the fast path meets an order it cannot reproduce
+// - [begin, end) restricts the run to a bar window
+// ====================================================== //
+backtestResult runBacktest(const std::unordered_map<std::string, AnyValue>& data, config& cfg,
+                           const std::string& ticker, const std::vector<bool>& entries, const std::vector<bool>& exits,
+                           size_t begin = 0, size_t end = std::numeric_limits<size_t>::max());
@@ -1,18 +1,28 @@
 #include "backtesterCore.hpp"
-#include "execution/ExecutionEngine.hpp"
+#include "execution/executionEngine.hpp"
+#include "utils/timeIndex.hpp"
+#include <format>
 
 #define MIN_BARS_REQ 2
 
 backtesterCore::backtesterCore(std::unordered_map<std::string, AnyValue>& data, config& cfg, MarketDataView& viewer,ExecutionEngine& executionLayer) : data_(std::move(data)), cfg_(std::move(cfg)), account_(account(cfg_.equity)), marketViewer_(viewer), executionLayer_(executionLayer) {
-    timestampVec_ = *std::get_if<std::vector<std::string>>(&data_["timestamp"]);
+    auto* stamps = std::get_if<Octurn::timeSeries>(&data_["timestamp"]);
+    if (!stamps) {
+        throw std::runtime_error("Backtester requires an int64 \"timestamp\" column");
+    }
+    timestampVec_ = *stamps;
     maxSize_ = timestampVec_.size();
-    openTrades_.reserve(maxSize_);
+    closedTrades_.reserve(maxSize_ / 2 + 1);
 };
 
-std::string backtesterCore::idx2stamp(size_t& idx){
+int64_t backtesterCore::idx2stamp(size_t idx) const {
     return timestampVec_[idx];
 };
 
+std::pair<size_t, size_t> backtesterCore::barRange(int64_t fromNs, int64_t toNs) const {
+    return stampRange(timestampVec_, fromNs, toNs);
+}
+
 void backtesterCore::setEntryExit(size_t& i, trade& trade, action actiontype){
     if (actiontype == action::Entry) {
         trade.timestamp.entryIdx = i+1;
@@ -24,32 +34,37 @@ void backtesterCore::setEntryExit(size_t& i, trade& trade, action actiontype){
 }
 
 void backtesterCore::checkEntryExit(size_t iteration,trade& trade_, bool& inTrade, const std::vector<bool>& entries, const std::vector<bool>& exits){
-    std::string tradeID = trade_.ID;
     if (!inTrade){
         if (entries[iteration] == true && exits[iteration] == false){
             inTrade = true;
-            openTrades_[tradeID] = trade_;
-            setEntryExit(iteration,trade_,action::Entry);}
+            setEntryExit(iteration,trade_,action::Entry);
+            trade_.ID = nextTradeId_++;
+            ledger_.onFill(tickerId_, trade_.type, trade_.qty.filledQty, trade_.price.avgPrice);
+            openTrades_.push_back(trade_);}
         } 
         else {
             if (exits[iteration] == true){
                 setEntryExit(iteration,trade_,action::Exit);
-                closedTrades_[tradeID] = trade_;
-                openTrades_.erase(tradeID);
+                closedTrades_.append(tickerId_, trade_.type, trade_.timestamp.entryIdx, trade_.timestamp.exitIdx,
+                    trade_.qty.filledQty, trade_.price.avgPrice, trade_.price.exitPrice, trade_.realizedPnL);
+                ledger_.onFill(tickerId_, trade_.type == ordertype::Buy ? ordertype::Sell : ordertype::Buy,
+                    trade_.qty.filledQty, trade_.price.exitPrice);
+
+                // ==== Swap-and-pop by ID ==== //
+                auto it = std::find_if(openTrades_.begin(), openTrades_.end(), [&](const trade& open){ return open.ID == trade_.ID; });
+                if (it != openTrades_.end()){
+                    if (it != openTrades_.end() - 1) *it = std::move(openTrades_.back());
+                    openTrades_.pop_back();
+                }
                 inTrade = false;
                 trade_ = trade(trade_.ticker);
             }
         }
 }
 
+// ==== Net positions per held ticker, not one pass per open trade ==== //
 void backtesterCore::markOpenTradesToMarket(size_t idx){
-    double accruedUnrealizedPnl{0};
-    for (auto& IdTrade:openTrades_){
-        auto& trade = IdTrade.second;
-        double marketPrice = executionLayer_.getValue(marketViewer_.makeField(trade.ticker, "open"), idx);
-        double delta = account_.markToMarket(marketPrice,trade.price.avgPrice,trade.qty.filledQty,trade.type);
-        accruedUnrealizedPnl+=delta;
-    }
+    const double accruedUnrealizedPnl = ledger_.unrealizedPnL([&](uint32_t id){ return (*openColumns_[id])[idx]; });
     account_.updateUnrealizedPnl(accruedUnrealizedPnl);
     account_.updateEquity();
 }
@@ -58,6 +73,14 @@ void backtesterCore::execute(const std::string& ticker,const std::vector<bool>&
 
     bool inTrade{false};
     trade trade(ticker);
+    tickerId_ = closedTrades_.addTicker(ticker);
+    ledger_.addTicker(ticker);
+
+    auto open = data_.find(marketViewer_.makeField(ticker, "open"));
+    if (open == data_.end() || !std::holds_alternative<std::vector<double>>(open->second)) {
+        throw std::runtime_error(std::format("Series {} not found", marketViewer_.makeField(ticker, "open")));
+    }
+    openColumns_.push_back(&std::get<std::vector<double>>(open->second));
 
     size_t vectSize{entries.size()};
 
@@ -5,17 +5,23 @@
 #include "interpreter/Interpreter.hpp"
 #include "config/config.hpp"
 #include "trade/trade.hpp"
+#include "trade/tradeLog.hpp"
+#include "trade/positionLedger.hpp"
 #include "account/account.hpp"
-#include "execution/ExecutionEngine.hpp"
-#include "marketDataView/MarketDataView.hpp"
+#include "execution/executionEngine.hpp"
+#include "marketDataView/DataLayer.hpp"
 
 class backtesterCore {
     private:
 
         std::unordered_map<std::string, AnyValue> data_;
-        std::unordered_map<std::string,trade> openTrades_;
-        std::unordered_map<std::string,trade> closedTrades_;
-        std::vector<std::string> timestampVec_;
+        std::vector<trade> openTrades_;
+        tradeLog closedTrades_;
+        positionLedger ledger_;
+        std::vector<const std::vector<double>*> openColumns_;   // by ticker id, marks skip the data map
+        uint32_t tickerId_ = 0;
+        uint64_t nextTradeId_ = 0;
+        Octurn::timeSeries timestampVec_;
         ExecutionEngine executionLayer_;
         MarketDataView marketViewer_;
 
@@ -24,7 +30,7 @@ class backtesterCore {
 
         void setEntryExit(size_t& i, trade& trade, action actiontype);
 
-        std::string idx2stamp(size_t& idx);
+        int64_t idx2stamp(size_t idx) const;
 
     public:
         config cfg_;
@@ -33,4 +39,7 @@ class backtesterCore {
         void execute(const std::string& ticker,const std::vector<bool>& entries,const std::vector<bool>& exits);
         void checkEntryExit(size_t iteration, trade& trade_, bool& inTrade, const std::vector<bool>& entries, const std::vector<bool>& exits);
         void markOpenTradesToMarket(size_t idx);
+
+        // ==== Bars [first, last) whose timestamps fall into [fromNs, toNs] ==== //
+        std::pair<size_t, size_t> barRange(int64_t fromNs, int64_t toNs) const;
 };
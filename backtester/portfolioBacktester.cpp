@@ -0,0 +1,594 @@
+#include "portfolioBacktester.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <stdexcept>
+
+#include "log/logHandler.hpp"
+#include "marketDataView/DataLayer.hpp"
+#include "utils/timeIndex.hpp"
+
+#define MIN_BARS_REQ 2
+
+portfolioBacktester::portfolioBacktester(const std::unordered_map<std::string, AnyValue>& data, config& cfg)
+    : data_(data), cfg_(cfg), account_(cfg_.equity), executionLayer_(data_, cfg_, account_) {}
+
+// ====================================================== //
+//                     Add ticker
+// - Resolves the ticker columns once (no per-bar map lookups)
+// - Runs the same entry/exit state machine as
+//   backtesterCore::checkEntryExit, but only once per ticker,
+//   keeping the bars where an order must be executed
+// ====================================================== //
+
+uint32_t portfolioBacktester::addTicker(const std::string& ticker, const std::vector<bool>& entries, const std::vector<bool>& exits,
+                                        size_t begin, size_t end){
+    auto stampsIt = data_.find(MarketDataView::makeField(ticker, "timestamp"));
+    auto openIt = data_.find(MarketDataView::makeField(ticker, "open"));
+    auto highIt = data_.find(MarketDataView::makeField(ticker, "high"));
+    auto lowIt = data_.find(MarketDataView::makeField(ticker, "low"));
+
+    if (stampsIt == data_.end() || openIt == data_.end() || highIt == data_.end() || lowIt == data_.end()) {
+        throw std::runtime_error(std::format("No market data loaded for {}", ticker));
+    }
+
+    const auto* stamps = std::get_if<timeSeries>(&stampsIt->second);
+    const auto* open = std::get_if<std::vector<double>>(&openIt->second);
+    const auto* high = std::get_if<std::vector<double>>(&highIt->second);
+    const auto* low = std::get_if<std::vector<double>>(&lowIt->second);
+
+    if (!stamps || !open || !high || !low) {
+        throw std::runtime_error(std::format("Market data for {} has unexpected column types", ticker));
+    }
+
+    if (entries.size() != stamps->size() || exits.size() != stamps->size()) {
+        throw std::runtime_error(std::format("Signals for {} do not match its bar count", ticker));
+    }
+
+    end = std::min(end, entries.size());
+    if (begin >= end || end - begin < MIN_BARS_REQ) {
+        throw std::runtime_error("Insufficient data to evaluate strategy");
+    }
+
+    // ==== Book id, trade-log ticker id and execution (order book / ledger) id are the same number ==== //
+    const auto tickerId = closedTrades_.addTicker(ticker);
+    executionLayer_.addTicker(ticker);
+
+    book_.tickers.push_back(ticker);
+    book_.stamps.push_back(stamps);
+    book_.open.push_back(open);
+    book_.high.push_back(high);
+    book_.low.push_back(low);
+    book_.lastBar.push_back(end - 1);
+    book_.inTrade.push_back(0);
+    book_.cursor.push_back(begin);
+    book_.positions.emplace_back(ticker);
+    book_.trigger.push_back({});
+    book_.stopPos.push_back(std::numeric_limits<size_t>::max());
+    book_.activeSlot.push_back(0);
+    book_.orderingSlot.push_back(SIZE_MAX);
+    book_.orderCursor.push_back(begin);
+
+    ranges_.emplace_back(begin, end);
+    scheduleSignals(tickerId, entries, exits, begin, end);
+    return tickerId;
+}
+
+uint64_t portfolioBacktester::submitOrder(uint32_t tickerId, const order& request, size_t bar){
+    if (tickerId >= book_.tickers.size()) throw std::runtime_error(std::format("Unknown ticker id {}", tickerId));
+
+    const uint64_t orderId = executionLayer_.orders().submit(tickerId, request, bar);
+    if (book_.orderingSlot[tickerId] == SIZE_MAX){
+        book_.orderingSlot[tickerId] = book_.ordering.size();
+        book_.ordering.push_back(tickerId);
+    }
+    return orderId;
+}
+
+void portfolioBacktester::scheduleSignals(uint32_t tickerId, const std::vector<bool>& entries, const std::vector<bool>& exits, size_t begin, size_t end){
+    bool inTrade{false};
+    size_t entryEvent{0};
+
+    // ==== Signal on bar i is executed on bar i+1 ==== //
+    for (size_t i = begin; i < end - 1; i++){
+        if (!inTrade){
+            if (entries[i] && !exits[i]){
+                inTrade = true;
+                entryEvent = events_.size();
+                events_.push_back({0, tickerId, i+1, action::Entry, end});
+            }
+        } else if (exits[i]){
+            inTrade = false;
+            events_[entryEvent].limitBar = i+1;
+            events_.push_back({0, tickerId, i+1, action::Exit});
+        }
+    }
+}
+
+// ==== Common timeline = sorted union of every ticker's timestamps ==== //
+void portfolioBacktester::buildTimeline(){
+    size_t total{0};
+    for (const auto& [begin, end] : ranges_) total += end - begin;
+
+    timeline_.clear();
+    timeline_.reserve(total);
+    for (size_t id = 0; id < book_.stamps.size(); id++){
+        const auto& stamps = *book_.stamps[id];
+        const auto [begin, end] = ranges_[id];
+        timeline_.insert(timeline_.end(), stamps.begin() + begin, stamps.begin() + end);
+    }
+
+    std::sort(timeline_.begin(), timeline_.end());
+    timeline_.erase(std::unique(timeline_.begin(), timeline_.end()), timeline_.end());
+}
+
+void portfolioBacktester::activate(uint32_t tickerId){
+    book_.activeSlot[tickerId] = book_.active.size();
+    book_.active.push_back(tickerId);
+    updateBorrowed();
+}
+
+// ==== Swap-and-pop, O(1) ==== //
+void portfolioBacktester::deactivate(uint32_t tickerId){
+    const size_t slot = book_.activeSlot[tickerId];
+    const uint32_t last = book_.active.back();
+
+    book_.active[slot] = last;
+    book_.activeSlot[last] = slot;
+    book_.active.pop_back();
+    updateBorrowed();
+}
+
+// ==== Rebuilt from the open longs when the book changes, O(active) per entry / exit, never per bar ==== //
+void portfolioBacktester::updateBorrowed(){
+    longBorrowed_ = 0.0;
+    for (uint32_t id : book_.active){
+        const auto& position = book_.positions[id];
+        if (position.type != ordertype::Buy) continue;
+
+        // ==== Fully funded longs (usedMargin == notional up to rounding) borrow nothing ==== //
+        const double notional = position.qty.filledQty * position.price.avgPrice;
+        const double borrowed = notional - position.usedMargin;
+        if (borrowed > 1e-9 * notional) longBorrowed_ += borrowed;
+    }
+
+    // ==== Book order longs posted longInitMargin of their cost ==== //
+    const auto& ledger = executionLayer_.ledger();
+    for (uint32_t id : ledger.held()){
+        const auto& position = ledger.position(id);
+        if (position.netQty > 0.0) longBorrowed_ += position.netQty * position.avgCost * (1.0 - cfg_.longInitMargin);
+    }
+}
+
+// ==== Swap-and-pop out of `ordering`, O(1) ==== //
+void portfolioBacktester::stopOrdering(uint32_t tickerId){
+    const size_t slot = book_.orderingSlot[tickerId];
+    const uint32_t last = book_.ordering.back();
+
+    book_.ordering[slot] = last;
+    book_.orderingSlot[last] = slot;
+    book_.ordering.pop_back();
+    book_.orderingSlot[tickerId] = SIZE_MAX;
+}
+
+void portfolioBacktester::processEvent(const portfolioEvent& event){
+    const uint32_t id = event.tickerId;
+    size_t barIdx = event.barIdx;
+    const auto& stamps = *book_.stamps[id];
+
+    if (event.type == action::Entry){
+        if (book_.inTrade[id]) return;
+
+        trade position(book_.tickers[id]);
+        position.timestamp.entryIdx = barIdx;
+        position.timestamp.entryTimestamp = stamps[barIdx];
+        position.ID = nextTradeId_++;
+
+        // ==== Refused fills (liquidity / cash) leave the ticker flat ==== //
+        if (!executionLayer_.openPosition(position)){
+            g_logger.report(std::format("[PORTFOLIO] Entry refused for {} at bar {}", book_.tickers[id], barIdx));
+            return;
+        }
+
+        metrics_.onFill(position.qty.filledQty * position.price.avgPrice);
+
+        // ==== One scan per trade, up to the signal exit ==== //
+        const auto hit = findTrigger(book_.open[id]->data(), book_.low[id]->data(), book_.high[id]->data(),
+            barIdx, event.limitBar, position.type, position.price.stopLossPrice, position.price.takeProfitPrice);
+        book_.trigger[id] = hit;
+        book_.stopPos[id] = (hit.bar < event.limitBar) ? stampLowerBound(timeline_, stamps[hit.bar]) : std::numeric_limits<size_t>::max();
+
+        book_.positions[id] = std::move(position);
+        book_.inTrade[id] = 1;
+        book_.cursor[id] = barIdx;
+        activate(id);
+    } else {
+        if (!book_.inTrade[id]) return;
+        closeTicker(id, barIdx, (*book_.open[id])[barIdx]);
+    }
+}
+
+void portfolioBacktester::closeTicker(uint32_t id, size_t barIdx, double refPrice){
+    auto& position = book_.positions[id];
+    position.timestamp.exitIdx = barIdx;
+    position.timestamp.exitTimestamp = (*book_.stamps[id])[barIdx];
+    position.borrowAccrued = financingCost(id, barIdx);
+    executionLayer_.closePositionAt(position, barIdx, refPrice);
+
+    // ==== Financing is settled with the trade, its PnL is reported net of it ==== //
+    if (position.borrowAccrued != 0.0){
+        account_.realizeTradePnL(-position.borrowAccrued);
+        position.realizedPnL -= position.borrowAccrued;
+    }
+    metrics_.onFill(position.qty.filledQty * position.price.exitPrice);
+
+    closedTrades_.append(id, position.type, position.timestamp.entryIdx, barIdx, position.qty.filledQty,
+        position.price.avgPrice, position.price.exitPrice, position.realizedPnL);
+    book_.inTrade[id] = 0;
+    book_.stopPos[id] = std::numeric_limits<size_t>::max();
+    deactivate(id);
+}
+
+// ==== Stops / targets due on this step, after the open orders (intrabar) ==== //
+bool portfolioBacktester::fireTriggers(size_t pos){
+    bool fired{false};
+
+    // ==== Backwards: swap-and-pop only moves already visited ids ==== //
+    for (size_t k = book_.active.size(); k-- > 0;){
+        const uint32_t id = book_.active[k];
+        if (book_.stopPos[id] != pos) continue;
+
+        if (!fired) accrueCash(pos);
+        const auto& hit = book_.trigger[id];
+        closeTicker(id, hit.bar, hit.refPrice);
+        fired = true;
+    }
+
+    return fired;
+}
+
+// ====================================================== //
+//                      Book orders
+// - Only tickers with live orders are visited, and only
+//   on steps where they have a bar
+// - Fills go through the engine to the ledger and the
+//   account; cash accrual is settled before the first one
+// ====================================================== //
+
+bool portfolioBacktester::runOrders(size_t pos){
+    const int64_t now = timeline_[pos];
+    bool filled{false};
+
+    // ==== Backwards: swap-and-pop only moves already visited ids ==== //
+    for (size_t k = book_.ordering.size(); k-- > 0;){
+        const uint32_t id = book_.ordering[k];
+        const auto& stamps = *book_.stamps[id];
+        size_t& bar = book_.orderCursor[id];
+
+        while (bar <= book_.lastBar[id] && stamps[bar] < now) ++bar;
+        if (bar > book_.lastBar[id]){
+            stopOrdering(id);
+            continue;
+        }
+        if (stamps[bar] != now) continue;
+
+        const auto& fills = executionLayer_.processOrders(id, bar, [&]{ accrueCash(pos); });
+        for (const auto& fill : fills) metrics_.onFill(fill.qty * fill.price);
+        filled = filled || !fills.empty();
+
+        if (executionLayer_.orders().pending(id) == 0) stopOrdering(id);
+    }
+
+    if (filled) updateBorrowed();
+    return filled;
+}
+
+// ====================================================== //
+//                  Financing accruals
+// - Curves hold cumulative accrual factors, so a holding
+//   interval costs one subtraction whatever its length
+// - Shorts pay borrow on their entry notional, settled with
+//   the trade
+// - Cash balance = free cash - what open longs borrowed;
+//   only fills move it, so it is settled right before the
+//   first fill of a step (signal order, stop / target, book
+//   order) and on the last step, never per bar: over the
+//   constant stretch in between a positive balance earns
+//   the cash yield, a negative one pays margin interest,
+//   simple interest from the curve either way
+// ====================================================== //
+
+void portfolioBacktester::buildRateCurves(){
+    cashCurve_.build(timeline_, cfg_.cashYieldBps);
+    marginCurve_.build(timeline_, cfg_.marginRateBps);
+
+    borrowCurves_.assign(book_.tickers.size(), rateCurve{});
+    for (size_t id = 0; id < book_.tickers.size(); id++){
+        auto it = data_.find(MarketDataView::makeField(book_.tickers[id], "borrowRate"));
+        const auto* series = (it != data_.end()) ? std::get_if<std::vector<double>>(&it->second) : nullptr;
+        if (series) borrowCurves_[id].build(*book_.stamps[id], *series);
+        else borrowCurves_[id].build(*book_.stamps[id], cfg_.borrowRateBps);
+    }
+}
+
+double portfolioBacktester::financingCost(uint32_t id, size_t barIdx) const {
+    const auto& position = book_.positions[id];
+    const size_t entryIdx = position.timestamp.entryIdx;
+    const double notional = position.qty.filledQty * position.price.avgPrice;
+
+    // ==== Longs are financed through the cash balance, see accrueCash() ==== //
+    if (position.type != ordertype::Sell) return 0.0;
+
+    return notional * borrowCurves_[id].factor(entryIdx, barIdx);
+}
+
+void portfolioBacktester::accrueCash(size_t pos){
+    if (pos <= cashAccruedPos_ || (cashCurve_.empty() && marginCurve_.empty())) return;
+
+    const double balance = account_.availableFreeCash() - longBorrowed_;
+    if (balance > 0.0) account_.updateFreeCash(balance * cashCurve_.factor(cashAccruedPos_, pos));
+    else if (balance < 0.0) account_.updateFreeCash(balance * marginCurve_.factor(cashAccruedPos_, pos));
+    cashAccruedPos_ = pos;
+}
+
+// ====================================================== //
+//               Mark active positions
+// - Only tickers holding a position are visited, signal
+//   positions and book order positions alike
+// - Each cursor only moves forward -> amortized O(1)
+// ====================================================== //
+
+void portfolioBacktester::markActiveToMarket(size_t pos){
+    const int64_t now = timeline_[pos];
+    double accruedUnrealizedPnl{0};
+    double grossExposure{0};
+
+    for (uint32_t id : book_.active){
+        const auto& stamps = *book_.stamps[id];
+        size_t& cursor = book_.cursor[id];
+
+        while (cursor < book_.lastBar[id] && stamps[cursor + 1] <= now) ++cursor;
+
+        const auto& position = book_.positions[id];
+        const double marketPrice = (*book_.open[id])[cursor];
+        accruedUnrealizedPnl += account_.markToMarket(marketPrice, position.price.avgPrice, position.qty.filledQty, position.type);
+        grossExposure += std::abs(marketPrice * position.qty.filledQty);
+    }
+
+    // ==== Book order positions, marked at the same bar as the signal positions ==== //
+    const auto& ledger = executionLayer_.ledger();
+    if (!ledger.held().empty()){
+        auto priceOf = [&](uint32_t id){
+            const auto& stamps = *book_.stamps[id];
+            size_t& cursor = book_.cursor[id];
+            while (cursor < book_.lastBar[id] && stamps[cursor + 1] <= now) ++cursor;
+            return (*book_.open[id])[cursor];
+        };
+        accruedUnrealizedPnl += ledger.unrealizedPnL(priceOf);
+        grossExposure += ledger.grossExposure(priceOf);
+    }
+
+    grossExposure_ = grossExposure;
+
+    account_.updateUnrealizedPnl(accruedUnrealizedPnl);
+    account_.updateEquity();
+}
+
+// ==== Timeline + order schedule, done once per run ==== //
+void portfolioBacktester::prepare(){
+    if (book_.tickers.empty()) {
+        throw std::runtime_error("Portfolio has no tickers");
+    }
+
+    buildTimeline();
+
+    for (auto& event : events_){
+        event.pos = stampLowerBound(timeline_, (*book_.stamps[event.tickerId])[event.barIdx]);
+    }
+
+    std::stable_sort(events_.begin(), events_.end(), [](const portfolioEvent& a, const portfolioEvent& b){
+        if (a.pos != b.pos) return a.pos < b.pos;
+        return a.type == action::Exit && b.type == action::Entry;
+    });
+
+    closedTrades_.reserve(events_.size() / 2 + 1);
+    book_.active.reserve(book_.tickers.size());
+    metrics_.reset(timeline_.size(), account_.currentEquity(), cfg_.periodsPerYear);
+    grossExposure_ = 0.0;
+    buildRateCurves();
+    cashAccruedPos_ = 0;
+    prepared_ = true;
+}
+
+// ====================================================== //
+//                  Portfolio event loop
+// - Steps the common timeline once
+// - Per step: execute due orders (exits first to free cash),
+//   run live book orders of tickers with a bar here,
+//   fire stops / targets touched inside the bar,
+//   then mark only the open positions
+// - Cash accrual is settled before the first fill of a
+//   step and on the last step, see accrueCash()
+// - Metrics get one O(1) update per step, flat steps reuse
+//   the last equity without touching the book
+// - Starts from the restored step after resume()
+// ====================================================== //
+
+void portfolioBacktester::execute(){
+    if (!prepared_) prepare();
+
+    g_logger.report(std::format("[PORTFOLIO] Run {} ({} tickers, {} bars, {} orders)", pos_ ? "resumed" : "started",
+        book_.tickers.size(), timeline_.size(), events_.size()));
+
+    for (size_t pos = pos_; pos < timeline_.size(); pos++){
+        bool touched{false};
+
+        // ==== Cash yield / margin interest: settled before signal orders here, triggers and book fills settle their own ==== //
+        const bool lastStep = (pos + 1 == timeline_.size());
+        if (lastStep || (next_ < events_.size() && events_[next_].pos == pos)){
+            accrueCash(pos);
+            touched = touched || lastStep;
+        }
+
+        while (next_ < events_.size() && events_[next_].pos == pos){
+            processEvent(events_[next_]);
+            touched = true;
+            ++next_;
+        }
+
+        if (!book_.ordering.empty() && runOrders(pos)){
+            touched = true;
+        }
+
+        if (!book_.active.empty() && fireTriggers(pos)){
+            touched = true;
+        }
+
+        // ==== Re-mark after a close too, so equity never keeps a stale unrealized PnL ==== //
+        if (touched || !book_.active.empty() || !executionLayer_.ledger().held().empty()){
+            markActiveToMarket(pos);
+        }
+
+        metrics_.onBar(account_.currentEquity(), grossExposure_);
+        pos_ = pos + 1;
+
+        if (checkpointEvery_ && pos_ % checkpointEvery_ == 0){
+            checkpoint(checkpointPath_);
+        }
+    }
+
+    g_logger.report(std::format("[PORTFOLIO] Run finished, {} closed trades", closedTrades_.size()));
+}
+
+// ====================================================== //
+//                  Checkpoint / resume
+// - Snapshot = setup fingerprint + loop position + account,
+//   book, open positions, pending book orders, the ledger,
+//   trade log and metrics
+// - Columns and the schedule are rebuilt from the same
+//   addTicker() calls, they are not stored
+// ====================================================== //
+
+void portfolioBacktester::enableCheckpoints(const std::string& path, size_t everyBars){
+    checkpointPath_ = path;
+    checkpointEvery_ = everyBars;
+}
+
+void portfolioBacktester::writeFingerprint(snapshotWriter& out) const {
+    out.put<uint64_t>(book_.tickers.size());
+    for (size_t id = 0; id < book_.tickers.size(); id++){
+        out.putString(book_.tickers[id]);
+        out.put<uint64_t>(ranges_[id].first);
+        out.put<uint64_t>(ranges_[id].second);
+    }
+    out.put<uint64_t>(timeline_.size());
+    out.put<int64_t>(timeline_.empty() ? 0 : timeline_.front());
+    out.put<int64_t>(timeline_.empty() ? 0 : timeline_.back());
+    out.put<uint64_t>(events_.size());
+}
+
+void portfolioBacktester::checkFingerprint(snapshotReader& in) const {
+    snapshotWriter expected;
+    writeFingerprint(expected);
+
+    snapshotReader reference(expected.bytes().data(), expected.bytes().size());
+    while (!reference.done()){
+        if (in.get<char>() != reference.get<char>()){
+            throw std::runtime_error("Snapshot was taken on a different portfolio setup");
+        }
+    }
+}
+
+void portfolioBacktester::checkpoint(const std::string& path){
+    if (!prepared_) prepare();
+
+    snapshot_.clear();
+    writeFingerprint(snapshot_);
+
+    snapshot_.put<uint64_t>(pos_);
+    snapshot_.put<uint64_t>(next_);
+    snapshot_.put(nextTradeId_);
+    snapshot_.put(grossExposure_);
+    snapshot_.put<uint64_t>(cashAccruedPos_);
+    account_.save(snapshot_);
+
+    snapshot_.putVector(book_.inTrade);
+    snapshot_.putVector(book_.cursor);
+    snapshot_.putVector(book_.stopPos);
+    snapshot_.putVector(book_.trigger);
+    snapshot_.putVector(book_.active);
+    snapshot_.putVector(book_.activeSlot);
+    for (uint32_t id : book_.active) book_.positions[id].save(snapshot_);
+    snapshot_.putVector(book_.ordering);
+    snapshot_.putVector(book_.orderingSlot);
+    snapshot_.putVector(book_.orderCursor);
+    executionLayer_.save(snapshot_);
+
+    closedTrades_.save(snapshot_);
+    metrics_.save(snapshot_);
+
+    writeSnapshotFile(path, snapshot_.bytes());
+}
+
+void portfolioBacktester::resume(const std::string& path){
+    if (!prepared_) prepare();
+
+    mappedSnapshot snapshot(path);
+    auto in = snapshot.reader();
+    checkFingerprint(in);
+
+    pos_ = in.get<uint64_t>();
+    next_ = in.get<uint64_t>();
+    nextTradeId_ = in.get<uint64_t>();
+    grossExposure_ = in.get<double>();
+    cashAccruedPos_ = in.get<uint64_t>();
+    account_.load(in);
+
+    in.getVector(book_.inTrade);
+    in.getVector(book_.cursor);
+    in.getVector(book_.stopPos);
+    in.getVector(book_.trigger);
+    in.getVector(book_.active);
+    in.getVector(book_.activeSlot);
+    for (uint32_t id : book_.active) book_.positions[id].load(in);
+    in.getVector(book_.ordering);
+    in.getVector(book_.orderingSlot);
+    in.getVector(book_.orderCursor);
+    executionLayer_.load(in);
+    updateBorrowed();
+
+    closedTrades_.load(in);
+    metrics_.load(in);
+
+    if (!in.done()) {
+        throw std::runtime_error(std::format("Snapshot {} has trailing data", path));
+    }
+
+    g_logger.report(std::format("[PORTFOLIO] Resumed from {} at bar {}/{}", path, pos_, timeline_.size()));
+}
+
+const timeSeries& portfolioBacktester::timeline() const {
+    return timeline_;
+}
+
+const tradeLog& portfolioBacktester::closedTrades() const {
+    return closedTrades_;
+}
+
+const performanceMetrics& portfolioBacktester::metrics() const {
+    return metrics_;
+}
+
+backtestResult portfolioBacktester::result() const {
+    backtestResult result;
+    result.finalEquity = account_.currentEquity();
+    result.metrics = metrics_;
+    result.trades = closedTrades_;
+
+    for (double pnl : closedTrades_.pnl) result.realizedPnL += pnl;
+    // ==== Book orders are not round trips: no trade-log rows, their PnL comes from the ledger ==== //
+    result.realizedPnL += executionLayer_.ledger().realizedPnL();
+
+    return result;
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "config/config.hpp"
+#include "trade/trade.hpp"
+#include "trade/tradeLog.hpp"
+#include "account/account.hpp"
+#include "execution/executionEngine.hpp"
+#include "execution/triggerScan.hpp"
+#include "types/types.hpp"
+#include "backtester/backtestResult.hpp"
+#include "metrics/performanceMetrics.hpp"
+#include "snapshot/snapshot.hpp"
+#include "financing/rateCurve.hpp"
+
+using Octurn::AnyValue;
+using Octurn::timeSeries;
+
+// ====================================================== //
+//              Portfolio order event
+// - Produced once per ticker from its entry/exit signals
+// - `pos` is the slot on the common timeline where the
+//   order is executed (signal bar + 1, as in backtesterCore)
+// - Entries carry the bar of their signal exit: stops and
+//   targets are only searched before it
+// ====================================================== //
+struct portfolioEvent {
+    size_t pos;
+    uint32_t tickerId;
+    size_t barIdx;
+    action type;
+    size_t limitBar = 0;
+};
+
+// ====================================================== //
+//         Per-ticker state, structure-of-arrays
+// - Indexed by tickerId, columns resolved once at setup
+// - `active` keeps ids of tickers holding a position,
+//   `activeSlot` gives O(1) removal from it
+// - `ordering` keeps ids of tickers with live book orders
+//   (limit / stop / trailing / TWAP / VWAP), same removal
+// ====================================================== //
+struct portfolioBook {
+    std::vector<std::string> tickers;
+    std::vector<const timeSeries*> stamps;
+    std::vector<const std::vector<double>*> open;
+    std::vector<const std::vector<double>*> high;
+    std::vector<const std::vector<double>*> low;
+    std::vector<size_t> lastBar;
+
+    std::vector<uint8_t> inTrade;
+    std::vector<size_t> cursor;
+    std::vector<trade> positions;
+
+    // ==== Stop / target found at entry, fired when the loop reaches stopPos ==== //
+    std::vector<triggerHit> trigger;
+    std::vector<size_t> stopPos;
+
+    std::vector<uint32_t> active;
+    std::vector<size_t> activeSlot;
+
+    std::vector<uint32_t> ordering;
+    std::vector<size_t> orderingSlot;   // SIZE_MAX when the ticker has no live order
+    std::vector<size_t> orderCursor;    // first bar not before the current step
+};
+
+class portfolioBacktester {
+    private:
+        const std::unordered_map<std::string, AnyValue>& data_;
+        config cfg_;
+
+        portfolioBook book_;
+        timeSeries timeline_;
+        std::vector<portfolioEvent> events_;
+        tradeLog closedTrades_;
+        uint64_t nextTradeId_ = 0;
+
+        std::vector<std::pair<size_t, size_t>> ranges_;
+
+        performanceMetrics metrics_;
+        double grossExposure_ = 0.0;
+
+        // ==== Financing: cash / margin curves on the timeline, borrow per ticker bars ==== //
+        rateCurve cashCurve_;
+        rateCurve marginCurve_;
+        std::vector<rateCurve> borrowCurves_;
+        size_t cashAccruedPos_ = 0;
+        double longBorrowed_ = 0.0;     // notional of open longs not covered by their margin
+
+        // ==== Loop state, kept in members so a run can be resumed ==== //
+        bool prepared_ = false;
+        size_t pos_ = 0;
+        size_t next_ = 0;
+
+        std::string checkpointPath_;
+        size_t checkpointEvery_ = 0;
+        snapshotWriter snapshot_;
+
+        void prepare();
+        void writeFingerprint(snapshotWriter& out) const;
+        void checkFingerprint(snapshotReader& in) const;
+
+        void buildTimeline();
+        void scheduleSignals(uint32_t tickerId, const std::vector<bool>& entries, const std::vector<bool>& exits, size_t begin, size_t end);
+        void activate(uint32_t tickerId);
+        void deactivate(uint32_t tickerId);
+        void updateBorrowed();
+        void stopOrdering(uint32_t tickerId);
+        void processEvent(const portfolioEvent& event);
+        bool runOrders(size_t pos);
+        void closeTicker(uint32_t tickerId, size_t barIdx, double refPrice);
+        void buildRateCurves();
+        void accrueCash(size_t pos);
+        double financingCost(uint32_t tickerId, size_t barIdx) const;
+        bool fireTriggers(size_t pos);
+        void markActiveToMarket(size_t pos);
+
+    public:
+        account account_;
+        ExecutionEngine executionLayer_;
+
+        portfolioBacktester(const std::unordered_map<std::string, AnyValue>& data, config& cfg);
+
+        // ==== [begin, end) restricts the run to a bar window without copying columns ==== //
+        uint32_t addTicker(const std::string& ticker, const std::vector<bool>& entries, const std::vector<bool>& exits,
+                           size_t begin = 0, size_t end = std::numeric_limits<size_t>::max());
+        // ==== Book order on the ticker's own bars, first processed at `bar`; fills are settled on the account ==== //
+        uint64_t submitOrder(uint32_t tickerId, const order& request, size_t bar);
+        void execute();
+
+        // ==== Snapshot every `everyBars` timeline steps (0 disables) ==== //
+        void enableCheckpoints(const std::string& path, size_t everyBars);
+        void checkpoint(const std::string& path);
+        // ==== Same addTicker() calls as the saved run, then resume(), then execute() ==== //
+        void resume(const std::string& path);
+
+        const timeSeries& timeline() const;
+        const tradeLog& closedTrades() const;
+        const performanceMetrics& metrics() const;
+        backtestResult result() const;
+};
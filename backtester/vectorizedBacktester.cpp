@@ -0,0 +1,207 @@
+#include "vectorizedBacktester.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <stdexcept>
+
+#include "marketDataView/DataLayer.hpp"
+#include "execution/triggerScan.hpp"
+#include "execution/impactModels.hpp"
+
+#define MIN_BARS_REQ 2
+
+vectorizedBacktester::vectorizedBacktester(const std::unordered_map<std::string, AnyValue>& data, const config& cfg)
+    : data_(data), cfg_(cfg) {}
+
+// ==== Configs the fast path can reproduce exactly (long/flat, FOK, risk sizing, no cash yield) ==== //
+bool vectorizedBacktester::qualifies(const config& cfg){
+    return cfg.stopLossBps > 0.0 && cfg.riskPerTrade > 0.0 && cfg.slippage.maxParticipation > 0.0
+        && cfg.cashYieldBps == 0.0 && cfg.longInitMargin == 1.0;
+}
+
+const std::vector<double>& vectorizedBacktester::column(const std::string& ticker, const std::string& field) const {
+    const std::string key = MarketDataView::makeField(ticker, field);
+    auto it = data_.find(key);
+    if (it == data_.end()) throw std::runtime_error(std::format("Series {} not found", key));
+
+    const auto* series = std::get_if<std::vector<double>>(&it->second);
+    if (!series) throw std::runtime_error(std::format("Series {} is not numeric", key));
+
+    return *series;
+}
+
+// ====================================================== //
+//                  Position series scan
+// - Same state machine as backtesterCore::checkEntryExit:
+//     flat     -> long  when entry && !exit
+//     long     -> flat  when exit
+// - Collapses to in = (in | entry) & ~exit, no branches
+// - Last bar has no next open to trade on, it is not scanned
+// ====================================================== //
+
+void vectorizedBacktester::positionSeries(const std::vector<bool>& entries, const std::vector<bool>& exits,
+                                          size_t begin, size_t end, std::vector<uint8_t>& position){
+    const size_t n = end - begin - 1;
+    position.resize(n);
+
+    uint8_t in{0};
+    for (size_t i = 0; i < n; i++){
+        const auto entry = static_cast<uint8_t>(entries[begin + i]);
+        const auto exit = static_cast<uint8_t>(exits[begin + i]);
+        in = (in | entry) & static_cast<uint8_t>(exit ^ 1u);
+        position[i] = in;
+    }
+}
+
+// ==== Flips of the position series, shifted to the execution bar (i+1) ==== //
+void vectorizedBacktester::transitions(const std::vector<uint8_t>& position, size_t begin,
+                                       std::vector<size_t>& entryBars, std::vector<size_t>& exitBars){
+    entryBars.clear();
+    exitBars.clear();
+
+    uint8_t prev{0};
+    for (size_t i = 0; i < position.size(); i++){
+        if (position[i] ^ prev){
+            (position[i] ? entryBars : exitBars).push_back(begin + i + 1);
+        }
+        prev = position[i];
+    }
+}
+
+// ====================================================== //
+//                     Run fast path
+// - Sizing depends on free cash -> trades are settled in order
+// - Cash/margin bookkeeping follows the account update order
+//   of the event loop so both paths give identical numbers
+// - The equity column is the only per-bar work (one mark per bar)
+// ====================================================== //
+
+bool vectorizedBacktester::run(const std::string& ticker, const std::vector<bool>& entries, const std::vector<bool>& exits, backtestResult& result,
+                               size_t begin, size_t end){
+    if (!qualifies(cfg_)) return false;
+
+    const auto& open = column(ticker, "open");
+    if (entries.size() != open.size() || exits.size() != open.size()) {
+        throw std::runtime_error(std::format("Signals for {} do not match its bar count", ticker));
+    }
+
+    end = std::min(end, entries.size());
+    if (begin >= end || end - begin < MIN_BARS_REQ) {
+        throw std::runtime_error("Insufficient data to evaluate strategy");
+    }
+
+    positionSeries(entries, exits, begin, end, position_);
+    transitions(position_, begin, entryBars_, exitBars_);
+
+    return withImpactModel(cfg_.slippage.model, [&](auto model){
+        return settle<decltype(model)>(ticker, result, begin, end);
+    });
+}
+
+template <typename Impact>
+bool vectorizedBacktester::settle(const std::string& ticker, backtestResult& result, size_t begin, size_t end){
+    const auto& open = column(ticker, "open");
+    const auto& volume = column(ticker, "volume");
+    const auto& high = column(ticker, "high");
+    const auto& low = column(ticker, "low");
+
+    auto impactBps = [&](double qty, size_t idx){
+        return Impact::bps(cfg_.slippage, {qty, volume[idx], high[idx], low[idx]});
+    };
+
+    const double spreadFrac = cfg_.spread / 10000.0;
+    const double commissionFrac = cfg_.commissionBps / 10000.0;
+    const double stopFrac = cfg_.stopLossBps / 10000.0;
+    const double targetFrac = cfg_.takeProfitBps / 10000.0;
+    const double cashCostMultiplier = (1+commissionFrac);
+
+    double freeCash = cfg_.equity;
+    double reservedMargin = 0.0;
+
+    result = backtestResult{};
+    result.vectorized = true;
+    result.trades.reserve(exitBars_.size());
+    const uint32_t tickerId = result.trades.addTicker(ticker);
+
+    // ==== Equity column: flat stretches repeat the settled equity, held ones mark at the open ==== //
+    result.metrics.reset(end - begin, cfg_.equity, cfg_.periodsPerYear);
+    double settledEquity = cfg_.equity;
+    size_t bar = begin;
+
+    auto recordFlat = [&](size_t upTo){
+        for (; bar < upTo; bar++) result.metrics.onBar(settledEquity, 0.0);
+    };
+    auto recordHeld = [&](size_t upTo, double qty, double avgPrice){
+        for (; bar < upTo; bar++){
+            const double unrealized = (open[bar] - avgPrice) * qty;
+            result.metrics.onBar(unrealized + freeCash + reservedMargin, std::abs(open[bar] * qty));
+        }
+    };
+
+    for (size_t k = 0; k < entryBars_.size(); k++){
+        const size_t in = entryBars_[k];
+        const double entryOpen = open[in];
+        const double entryVolume = volume[in];
+
+        // ==== Cases where ExecutionEngine would refuse or throw ==== //
+        if (entryVolume <= 0.0) return false;
+
+        const double stopLossPrice = entryOpen * (1.0 - stopFrac);
+        const double risk = cfg_.riskPerTrade * freeCash * 0.01;
+        const double dist = std::abs(entryOpen - stopLossPrice);
+        if (dist <= 0.0) return false;
+
+        const double needQty = risk / dist;
+        if (needQty <= 0.0) return false;
+
+        const double qtyLiq = cfg_.slippage.maxParticipation * entryVolume;
+        const double price = entryOpen*(1.0 + spreadFrac + impactBps(needQty, in) / 10000.0);
+        const double qtyCash = freeCash / (price * cashCostMultiplier);
+
+        if (!(needQty <= qtyLiq) || !(needQty <= qtyCash)) return false;
+
+        recordFlat(in);
+
+        const double positionCost = needQty * price * cashCostMultiplier;
+        const double usedMargin = positionCost/cashCostMultiplier;
+        reservedMargin += usedMargin;
+        freeCash += -positionCost;
+        result.metrics.onFill(needQty * price);
+
+        // ==== Stop / target inside [in, signal exit), first touch wins ==== //
+        const size_t limit = (k < exitBars_.size()) ? exitBars_[k] : end;
+        const double stopPrice = price * (1.0 - stopFrac);
+        const double targetPrice = (targetFrac > 0.0) ? price * (1.0 + targetFrac) : 0.0;
+        const auto hit = findTrigger(open.data(), low.data(), high.data(), in, limit, ordertype::Buy, stopPrice, targetPrice);
+
+        if (hit.bar == end){
+            recordHeld(end, needQty, price);
+            break;
+        }
+
+        const bool triggered = hit.bar < limit;
+        const size_t out = triggered ? hit.bar : limit;
+        const double exitRef = triggered ? hit.refPrice : open[out];
+        recordHeld(out, needQty, price);
+
+        const double exitPrice = exitRef*(1.0 - spreadFrac - impactBps(needQty, out) / 10000.0);
+        const double commission = needQty * exitPrice * commissionFrac;
+        const double pnl = (exitPrice - price) * needQty - commission;
+
+        reservedMargin += -usedMargin;
+        freeCash += usedMargin;
+        freeCash += pnl;
+        result.metrics.onFill(needQty * exitPrice);
+
+        settledEquity = freeCash + reservedMargin;
+        result.append(tickerId, ordertype::Buy, in, out, needQty, price, exitPrice, pnl);
+    }
+
+    recordFlat(end);
+
+    // ==== Final mark happens on the last bar open, as in the event loop ==== //
+    result.finalEquity = result.metrics.summary().finalEquity;
+
+    return true;
+}
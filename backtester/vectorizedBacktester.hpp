@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "config/config.hpp"
+#include "types/types.hpp"
+#include "backtester/backtestResult.hpp"
+
+using Octurn::AnyValue;
+
+// ====================================================== //
+//              Vectorized long/flat backtest
+// - Entry/exit flags -> position series with a branch-free scan
+// - Only position transitions are visited afterwards,
+//   so the cost is O(bars) for the scan + O(trades) for fills
+// - Prices, fees and impact replicate ExecutionEngine
+//   (FOK at next open, risk sizing, configured impact policy)
+// - Stops / targets: one first-touch scan per trade over
+//   low/high, same rules as the event loop
+// - run() returns false as soon as an order would be refused,
+//   the caller then falls back to the event loop
+// ====================================================== //
+class vectorizedBacktester {
+    private:
+        const std::unordered_map<std::string, AnyValue>& data_;
+        const config& cfg_;
+
+        // ==== Scratch buffers, reused between runs of a sweep ==== //
+        std::vector<uint8_t> position_;
+        std::vector<size_t> entryBars_;
+        std::vector<size_t> exitBars_;
+
+        const std::vector<double>& column(const std::string& ticker, const std::string& field) const;
+
+        // ==== Trade settlement, instantiated once per impact policy ==== //
+        template <typename Impact>
+        bool settle(const std::string& ticker, backtestResult& result, size_t begin, size_t end);
+
+    public:
+        vectorizedBacktester(const std::unordered_map<std::string, AnyValue>& data, const config& cfg);
+
+        static bool qualifies(const config& cfg);
+        static void positionSeries(const std::vector<bool>& entries, const std::vector<bool>& exits,
+                                   size_t begin, size_t end, std::vector<uint8_t>& position);
+        static void transitions(const std::vector<uint8_t>& position, size_t begin,
+                                std::vector<size_t>& entryBars, std::vector<size_t>& exitBars);
+
+        // ==== [begin, end) restricts the run to a bar window without copying columns ==== //
+        bool run(const std::string& ticker, const std::vector<bool>& entries, const std::vector<bool>& exits, backtestResult& result,
+                 size_t begin = 0, size_t end = std::numeric_limits<size_t>::max());
+};
@@ -0,0 +1,180 @@
+#include "walkForward.hpp"
+
+#include <algorithm>
+#include <format>
+#include <future>
+#include <stdexcept>
+
+#include "backtester/backtestRunner.hpp"
+#include "interpreter/Interpreter.hpp"
+#include "marketDataView/DataLayer.hpp"
+#include "node/Node.hpp"
+#include "log/logHandler.hpp"
+#include "utils/threadPool.hpp"
+
+#define MIN_BARS_REQ 2
+
+// ====================================================== //
+//                    Window split
+// - Rolling : in-sample slides forward by the out-of-sample length
+// - Anchored: in-sample always starts at bar 0
+// - The last out-of-sample slice may be shorter, never < MIN_BARS_REQ
+// ====================================================== //
+
+std::vector<walkForwardWindow> splitWalkForward(size_t bars, const walkForwardOptions& options){
+    if (options.inSampleBars < MIN_BARS_REQ || options.outOfSampleBars < MIN_BARS_REQ){
+        throw std::runtime_error("Walk-forward windows must span at least 2 bars");
+    }
+
+    std::vector<walkForwardWindow> windows;
+    for (size_t start = 0; start + options.inSampleBars + MIN_BARS_REQ <= bars; start += options.outOfSampleBars){
+        walkForwardWindow window;
+        window.inSampleBegin = options.anchored ? 0 : start;
+        window.inSampleEnd = start + options.inSampleBars;
+        window.outOfSampleBegin = window.inSampleEnd;
+        window.outOfSampleEnd = std::min(window.outOfSampleBegin + options.outOfSampleBars, bars);
+        windows.push_back(window);
+    }
+
+    if (windows.empty()){
+        throw std::runtime_error(std::format("Not enough bars ({}) for a single walk-forward window", bars));
+    }
+
+    return windows;
+}
+
+std::vector<strategyCandidate> buildCandidates(Interpreter& interpreter, const parameterGrid& grid){
+    std::vector<std::unordered_map<std::string, double>> combinations{{}};
+
+    for (const auto& [name, values] : grid){
+        if (values.empty()){
+            throw std::runtime_error(std::format("Parameter '{}' has no values to sweep", name));
+        }
+
+        std::vector<std::unordered_map<std::string, double>> expanded;
+        expanded.reserve(combinations.size() * values.size());
+        for (const auto& combination : combinations){
+            for (double value : values){
+                auto next = combination;
+                next[name] = value;
+                expanded.push_back(std::move(next));
+            }
+        }
+        combinations = std::move(expanded);
+    }
+
+    // ==== Sequential: the interpreter keeps its variables in place ==== //
+    std::vector<strategyCandidate> candidates;
+    candidates.reserve(combinations.size());
+    for (auto& combination : combinations){
+        auto [entries, exits] = interpreter.evaluate_signals(combination);
+        candidates.push_back({std::move(combination), std::move(entries), std::move(exits)});
+    }
+
+    return candidates;
+}
+
+walkForward::walkForward(const std::unordered_map<std::string, AnyValue>& data, const config& cfg, const std::string& ticker)
+    : data_(data), cfg_(cfg), ticker_(ticker) {}
+
+walkForwardResult walkForward::runWindow(const walkForwardWindow& window, const std::vector<strategyCandidate>& candidates) const {
+    walkForwardResult result;
+    result.window = window;
+
+    bool first{true};
+    for (size_t c = 0; c < candidates.size(); c++){
+        // ==== Config copy per run, the runner resolves slippage into it ==== //
+        config cfg = cfg_;
+        auto inSample = runBacktest(data_, cfg, ticker_, candidates[c].entries, candidates[c].exits,
+                                    window.inSampleBegin, window.inSampleEnd);
+
+        if (first || inSample.finalEquity > result.inSample.finalEquity){
+            result.bestCandidate = c;
+            result.inSample = std::move(inSample);
+            first = false;
+        }
+    }
+
+    config cfg = cfg_;
+    const auto& best = candidates[result.bestCandidate];
+    result.parameters = best.parameters;
+    result.outOfSample = runBacktest(data_, cfg, ticker_, best.entries, best.exits,
+                                     window.outOfSampleBegin, window.outOfSampleEnd);
+
+    return result;
+}
+
+std::vector<walkForwardResult> walkForward::run(const std::vector<strategyCandidate>& candidates, const walkForwardOptions& options) const {
+    if (candidates.empty()){
+        throw std::runtime_error("Walk-forward needs at least one candidate");
+    }
+
+    const auto windows = splitWalkForward(candidates.front().entries.size(), options);
+    g_logger.report(std::format("[WALKFORWARD] {} windows x {} candidates on {}", windows.size(), candidates.size(), ticker_));
+
+    threadPool pool(options.threads);
+    std::vector<std::future<walkForwardResult>> pending;
+    pending.reserve(windows.size());
+
+    for (const auto& window : windows){
+        pending.push_back(pool.submit([this, window, &candidates](){
+            return runWindow(window, candidates);
+        }));
+    }
+
+    std::vector<walkForwardResult> results;
+    results.reserve(windows.size());
+    for (auto& future : pending){
+        results.push_back(future.get());
+    }
+
+    return results;
+}
+
+// ====================================================== //
+//                  Walk-forward a script
+// - Loads the script's data once, every grid candidate is
+//   evaluated on it before the windows start
+// ====================================================== //
+
+std::vector<walkForwardResult> walkForwardScript(std::shared_ptr<const syntaxTree> tree, MarketDataView&& marketDataView,
+                                                 const parameterGrid& grid, const walkForwardOptions& options){
+    const ASTRoot* root = tree ? tree->root() : nullptr;
+    const auto requests = MarketDataView::requests(root ? node_cast<ASTList>(root->data) : nullptr);
+    if (requests.empty()){
+        throw std::runtime_error("Script has no data block");
+    }
+
+    Interpreter interpreter(std::move(tree), std::move(marketDataView));
+    if (options.jit) interpreter.set_jit(options.jit);
+    interpreter.run();
+
+    const auto candidates = buildCandidates(interpreter, grid);
+    walkForward analysis(interpreter.get_data(), interpreter.get_config(), requests.front().ticker);
+
+    return analysis.run(candidates, options);
+}
+
+static nlohmann::json runReport(const backtestResult& run, bool withEquityCurve){
+    auto metrics = run.metrics.toJson();
+    nlohmann::json entry{{"summary", std::move(metrics["summary"])}, {"trades", run.tradeCount()},
+                         {"realizedPnL", run.realizedPnL}, {"vectorized", run.vectorized}};
+    if (withEquityCurve) entry["equityCurve"] = std::move(metrics["equityCurve"]);
+    return entry;
+}
+
+nlohmann::json walkForwardReport(const std::vector<walkForwardResult>& results, bool withEquityCurves){
+    nlohmann::json report = nlohmann::json::array();
+
+    for (const auto& result : results){
+        report.push_back({
+            {"inSample", {result.window.inSampleBegin, result.window.inSampleEnd}},
+            {"outOfSample", {result.window.outOfSampleBegin, result.window.outOfSampleEnd}},
+            {"parameters", result.parameters},
+            {"inSampleResult", runReport(result.inSample, withEquityCurves)},
+            {"outOfSampleResult", runReport(result.outOfSample, withEquityCurves)}
+        });
+    }
+
+    return report;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "config/config.hpp"
+#include "types/types.hpp"
+#include "backtester/backtestResult.hpp"
+
+class Interpreter;
+class MarketDataView;
+class strategyJit;
+class syntaxTree;
+
+using Octurn::AnyValue;
+
+// ====================================================== //
+//                Walk-forward analysis
+// - Data is split in in-sample / out-of-sample windows
+// - Each window picks the candidate with the best in-sample
+//   final equity, then runs it on the next out-of-sample slice
+// - Windows run concurrently; market data and candidate
+//   signals are shared read-only, windows only hold indices
+// ====================================================== //
+
+struct walkForwardWindow {
+    size_t inSampleBegin = 0;
+    size_t inSampleEnd = 0;
+    size_t outOfSampleBegin = 0;
+    size_t outOfSampleEnd = 0;
+};
+
+struct walkForwardOptions {
+    size_t inSampleBars = 0;
+    size_t outOfSampleBars = 0;
+    bool anchored = false;   // in-sample grows from bar 0 instead of rolling
+    size_t threads = 0;      // 0 -> hardware concurrency
+    std::shared_ptr<strategyJit> jit;   // null -> candidates evaluated by the Visitor only
+};
+
+// ==== One parameter combination, signals evaluated once over the full series ==== //
+struct strategyCandidate {
+    std::unordered_map<std::string, double> parameters;
+    std::vector<bool> entries;
+    std::vector<bool> exits;
+};
+
+struct walkForwardResult {
+    walkForwardWindow window;
+    size_t bestCandidate = 0;
+    std::unordered_map<std::string, double> parameters;   // of the best candidate
+    backtestResult inSample;
+    backtestResult outOfSample;
+};
+
+using parameterGrid = std::map<std::string, std::vector<double>>;
+
+std::vector<walkForwardWindow> splitWalkForward(size_t bars, const walkForwardOptions& options);
+
+// ==== Cartesian product of the grid, evaluated on the interpreter's loaded data ==== //
+std::vector<strategyCandidate> buildCandidates(Interpreter& interpreter, const parameterGrid& grid);
+
+class walkForward {
+    private:
+        const std::unordered_map<std::string, AnyValue>& data_;
+        config cfg_;
+        std::string ticker_;
+
+        walkForwardResult runWindow(const walkForwardWindow& window, const std::vector<strategyCandidate>& candidates) const;
+
+    public:
+        walkForward(const std::unordered_map<std::string, AnyValue>& data, const config& cfg, const std::string& ticker);
+
+        std::vector<walkForwardResult> run(const std::vector<strategyCandidate>& candidates, const walkForwardOptions& options) const;
+};
+
+// ==== Script driver of `Octurn --walkforward`: traded ticker = first entry of the data block ==== //
+std::vector<walkForwardResult> walkForwardScript(std::shared_ptr<const syntaxTree> tree, MarketDataView&& marketDataView,
+                                                 const parameterGrid& grid, const walkForwardOptions& options);
+
+nlohmann::json walkForwardReport(const std::vector<walkForwardResult>& results, bool withEquityCurves = false);
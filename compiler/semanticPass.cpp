@@ -0,0 +1,293 @@
+#include "semanticPass.hpp"
+
+#include <cmath>
+#include <format>
+#include <stdexcept>
+
+#include "lexer/operators.hpp"
+#include "mappers/maps.hpp"
+
+namespace {
+
+const char* typeName(valueType type){
+    switch (type) {
+        case valueType::Number: return "number";
+        case valueType::Bool: return "bool";
+        case valueType::Text: return "text";
+        case valueType::NumberSeries: return "number series";
+        case valueType::BoolSeries: return "bool series";
+        case valueType::Unknown: break;
+    }
+    return "unknown";
+}
+
+bool isSeries(valueType type){
+    return type == valueType::NumberSeries || type == valueType::BoolSeries;
+}
+
+// ==== Literal number / bool, identifiers are not constants ==== //
+bool isLiteral(const ASTNode* node){
+    const auto* value = node_cast<ASTValueNode>(node);
+    return value && (std::holds_alternative<double>(value->value) || std::holds_alternative<bool>(value->value));
+}
+
+AnyValue literalOf(const ASTNode* node){
+    const auto& value = static_cast<const ASTValueNode*>(node)->value;
+    if (const auto* number = std::get_if<double>(&value)) return *number;
+    return std::get<bool>(value);
+}
+
+}
+
+semanticPass::semanticPass(syntaxTree& tree) : tree_(tree) {}
+
+size_t semanticPass::folded() const {
+    return folded_;
+}
+
+size_t semanticPass::kernels() const {
+    return kernels_;
+}
+
+void semanticPass::error(const ASTNode& node, const std::string& message){
+    errors_.push_back(std::format("{} at line {}, col {}", message, node.line, node.col));
+}
+
+// ==== Same visibility as Interpreter::apply_kv: numbers and strings land in variables, bools in flags ==== //
+void semanticPass::declare(const NodeMap& map, bool nested){
+    for (const auto& [key, node] : map){
+        if (const auto* value = node_cast<ASTValueNode>(node)){
+            if (std::holds_alternative<double>(value->value)) symbols_[key] = valueType::Number;
+            else if (std::holds_alternative<std::string>(value->value)) symbols_[key] = valueType::Text;
+            else if (nested && std::holds_alternative<NodeMap>(value->value)) declare(std::get<NodeMap>(value->value), nested);
+        } else if (nested){
+            if (const auto* block = node_cast<ASTBlock>(node)) declare(block->entries, nested);
+        }
+    }
+}
+
+// ==== Arguments are passed as written, TA functions resolve identifiers themselves ==== //
+void semanticPass::checkCall(ASTFunctionCall& call){
+    if (!functionMap.contains(call.name)){
+        error(call, std::format("Unknown function '{}'", call.name));
+    }
+    for (ASTNode* arg : call.expr){
+        if (auto* nested = node_cast<ASTFunctionCall>(arg)) checkCall(*nested);
+    }
+    if (call.lag) checkBars(call.lag, "Lag", 0.0);
+    call.type = valueType::NumberSeries;
+}
+
+valueType semanticPass::infer(ASTNode*& node, bool root){
+    switch (node->kind) {
+        case NodeKind::Value: {
+            const auto& value = static_cast<ASTValueNode*>(node)->value;
+            if (std::holds_alternative<double>(value)) node->type = valueType::Number;
+            else if (std::holds_alternative<bool>(value)) node->type = valueType::Bool;
+            else if (const auto* name = std::get_if<std::string>(&value)){
+                auto it = symbols_.find(*name);
+                if (it == symbols_.end()) error(*node, std::format("Unknown identifier '{}'", *name));
+                else node->type = it->second;
+            }
+            return node->type;
+        }
+        case NodeKind::FunctionCall:
+            checkCall(*static_cast<ASTFunctionCall*>(node));
+            return node->type;
+        case NodeKind::Arithmetics:
+        case NodeKind::Comparison:
+        case NodeKind::Expression:
+            return inferBinary(node, root);
+        case NodeKind::Crosses:
+            return inferCrosses(*static_cast<ASTCrosses*>(node));
+        case NodeKind::Temporal:
+            return inferTemporal(*static_cast<ASTTemporal*>(node));
+        case NodeKind::Lag:
+            return inferLag(*static_cast<ASTLag*>(node));
+        case NodeKind::Condition:
+        case NodeKind::LogicalCondition:
+            // ==== No static rule yet, the Visitor decides at runtime ==== //
+            return valueType::Unknown;
+        default:
+            node->type = valueType::Bool;
+            return node->type;
+    }
+}
+
+valueType semanticPass::inferBinary(ASTNode*& node, bool root){
+    auto* binary = static_cast<ASTBinary*>(node);
+    const valueType left = infer(binary->left, false);
+    const valueType right = infer(binary->right, false);
+
+    // ==== Already reported below, or decided at runtime ==== //
+    if (left == valueType::Unknown || right == valueType::Unknown) return valueType::Unknown;
+
+    const valueType result = binary_result_type(binary->op, left, right);
+    if (result == valueType::Unknown){
+        error(*binary, std::format("Operator '{}' cannot be applied to {} and {}", binary->op, typeName(left), typeName(right)));
+        return valueType::Unknown;
+    }
+    binary->type = result;
+
+    // ==== An Entry/Exit root keeps the broadcast result (a one-element series) of the generic path ==== //
+    if (root && !isSeries(result)) return result;
+
+    binary->kernel = select_kernel(binary->op, left, right);
+    if (binary->kernel) kernels_++;
+
+    if (isLiteral(binary->left) && isLiteral(binary->right) && binary->kernel){
+        AnyValue lhs = literalOf(binary->left);
+        AnyValue rhs = literalOf(binary->right);
+        AnyValue value = binary->kernel(lhs, rhs);
+
+        ASTValueNode* constant = std::holds_alternative<double>(value)
+            ? tree_.arena().make<ASTValueNode>(std::get<double>(value))
+            : tree_.arena().make<ASTValueNode>(std::get<bool>(value));
+        constant->type = result;
+        constant->line = binary->line;
+        constant->col = binary->col;
+        node = constant;
+
+        kernels_--;
+        folded_++;
+    }
+    return result;
+}
+
+// ==== Number series against a number series or a level, no kernel: ta/crosses runs it ==== //
+valueType semanticPass::inferCrosses(ASTCrosses& crosses){
+    const valueType left = infer(crosses.left, false);
+    const valueType right = infer(crosses.right, false);
+    if (left == valueType::Unknown || right == valueType::Unknown) return valueType::Unknown;
+
+    const bool numeric = (left == valueType::Number || left == valueType::NumberSeries) &&
+                         (right == valueType::Number || right == valueType::NumberSeries);
+    if (!numeric || (left != valueType::NumberSeries && right != valueType::NumberSeries)){
+        error(crosses, std::format("Operator '{}' cannot be applied to {} and {}", crosses.op, typeName(left), typeName(right)));
+        return valueType::Unknown;
+    }
+    crosses.type = valueType::BoolSeries;
+    return crosses.type;
+}
+
+// ==== Bar count: a parameter, or a whole literal >= minimum ==== //
+bool semanticPass::checkBars(ASTNode*& bars, const std::string& what, double minimum){
+    const valueType type = infer(bars, false);
+    if (type == valueType::Unknown) return false;
+
+    const auto* literal = node_cast<ASTValueNode>(bars);
+    const auto* number = literal ? std::get_if<double>(&literal->value) : nullptr;
+    if (type != valueType::Number || (number && (*number < minimum || *number != std::floor(*number)))){
+        error(*bars, std::format("{} needs a whole number of bars >= {}", what, minimum));
+        return false;
+    }
+    return true;
+}
+
+// ==== series[N]: same shape as the series, scalars have no past ==== //
+valueType semanticPass::inferLag(ASTLag& lag){
+    const valueType series = infer(lag.series, false);
+    const bool bars = checkBars(lag.bars, "Lag", 0.0);
+    if (series == valueType::Unknown || !bars) return valueType::Unknown;
+
+    if (!isSeries(series)){
+        error(lag, std::format("Lag needs a series, got {}", typeName(series)));
+        return valueType::Unknown;
+    }
+    lag.type = series;
+    return lag.type;
+}
+
+// ==== Condition must be a bool series, bar counts a whole number (literal) or a parameter ==== //
+valueType semanticPass::inferTemporal(ASTTemporal& temporal){
+    const char* name = temporal_name(temporal.op);
+    bool known = true;
+
+    const valueType condition = infer(temporal.condition, false);
+    if (condition == valueType::Unknown) known = false;
+    else if (condition != valueType::BoolSeries){
+        error(temporal, std::format("Operator '{}' needs a bool series, got {}", name, typeName(condition)));
+        known = false;
+    }
+
+    for (ASTNode** slot : {&temporal.window, &temporal.required}){
+        if (*slot && !checkBars(*slot, std::format("Operator '{}'", name), 1.0)) known = false;
+    }
+
+    const auto* window = node_cast<ASTValueNode>(temporal.window);
+    const auto* required = node_cast<ASTValueNode>(temporal.required);
+    if (window && required && std::holds_alternative<double>(window->value) && std::holds_alternative<double>(required->value) &&
+        std::get<double>(required->value) > std::get<double>(window->value)){
+        error(temporal, std::format("Operator '{}': K of N bars needs K <= N", name));
+        known = false;
+    }
+
+    if (temporal.series){
+        const valueType series = infer(temporal.series, false);
+        if (series == valueType::Unknown) known = false;
+        else if (series != valueType::NumberSeries){
+            error(temporal, std::format("Operator '{}' needs a number series, got {}", name, typeName(series)));
+            known = false;
+        }
+    }
+
+    if (!known) return valueType::Unknown;
+    temporal.type = (temporal.op == temporalOp::For || temporal.op == temporalOp::Within) ? valueType::BoolSeries : valueType::NumberSeries;
+    return temporal.type;
+}
+
+void semanticPass::condition(ASTBlock& block, const char* key){
+    auto it = block.entries.find(key);
+    if (it != block.entries.end() && it->second) infer(it->second, true);
+}
+
+// ==== Blocks are visited in the order eval_program / eval_strategy evaluate them ==== //
+void semanticPass::run(){
+    ASTRoot* root = tree_.root();
+    if (!root) return;
+
+    if (root->config.has_value()){
+        if (const auto* block = node_cast<ASTBlock>(root->config.value())) declare(block->entries, true);
+    }
+
+    if (auto* strategy = node_cast<Strategy>(root->strategy)){
+        for (ASTNode* node : strategy->blocks){
+            auto* block = node_cast<ASTBlock>(node);
+            if (!block || !block->block_type) continue;
+
+            switch (*block->block_type) {
+                case Tokentype::Config:
+                    declare(block->entries, true);
+                    break;
+                case Tokentype::Parameters:
+                    declare(block->entries, false);
+                    break;
+                case Tokentype::Indicators:
+                    for (auto& [key, entry] : block->entries){
+                        auto* assignment = node_cast<ASTAssignment>(entry);
+                        auto* call = assignment ? node_cast<ASTFunctionCall>(assignment->expr) : nullptr;
+                        if (!call) continue;
+
+                        checkCall(*call);
+                        assignment->type = valueType::NumberSeries;
+                        symbols_[key] = valueType::NumberSeries;
+                    }
+                    break;
+                case Tokentype::Entry:
+                    condition(*block, "Entry");
+                    break;
+                case Tokentype::Exit:
+                    condition(*block, "Exit");
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    if (!errors_.empty()){
+        std::string message = "Semantic errors:";
+        for (const auto& e : errors_) message += "\n  " + e;
+        throw std::runtime_error(message);
+    }
+}
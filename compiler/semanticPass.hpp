@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "node/Node.hpp"
+
+// ====================================================== //
+//                    Semantic pass
+// - Runs once on a freshly parsed tree, before it is
+//   handed out read-only (so before any data fetch)
+// - Walks blocks in evaluation order and infers the shape
+//   of every expression node (scalar / series, number / bool)
+// - Literal-only subexpressions are folded into one value
+//   node; parameters stay symbolic since overrides are
+//   bound per run, but are typed as scalars
+// - Binary nodes with known operand shapes get a typed
+//   kernel (see lexer/operators.hpp)
+// - Unknown identifiers / functions and operand mismatches
+//   are reported together, with line and column
+// ====================================================== //
+class semanticPass {
+    public:
+        explicit semanticPass(syntaxTree& tree);
+
+        // ==== Throws std::runtime_error listing every diagnostic ==== //
+        void run();
+
+        size_t folded() const;
+        size_t kernels() const;
+
+    private:
+        syntaxTree& tree_;
+        std::unordered_map<std::string, valueType> symbols_;
+        std::vector<std::string> errors_;
+        size_t folded_ = 0;
+        size_t kernels_ = 0;
+
+        void declare(const NodeMap& map, bool nested);
+        void checkCall(ASTFunctionCall& call);
+        valueType infer(ASTNode*& node, bool root);
+        valueType inferBinary(ASTNode*& node, bool root);
+        valueType inferCrosses(ASTCrosses& crosses);
+        valueType inferTemporal(ASTTemporal& temporal);
+        valueType inferLag(ASTLag& lag);
+        bool checkBars(ASTNode*& bars, const std::string& what, double minimum);
+        void condition(ASTBlock& block, const char* key);
+        void error(const ASTNode& node, const std::string& message);
+};
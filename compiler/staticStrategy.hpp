@@ -0,0 +1,325 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "lexer/operators.hpp"
+#include "types/types.hpp"
+
+// ====================================================== //
+//                 Static strategies (C++20)
+// - Header-only mirror of the DSL for fixed strategies:
+//     auto entry = close > MA<5>(close) && RSI<12>(close) > 50;
+// - Every node is a value type, the whole condition is one
+//   type: the compiler sees through it and emits a single
+//   loop, no interpreter, no heap allocation per bar
+// - Nodes are evaluated bar by bar in increasing order;
+//   indicators keep their window in a std::array sized by
+//   the template period
+// - Element operators are the DSL functors (operators.hpp),
+//   MA / RSI repeat ta/taLib.cpp step for step: results are
+//   bit-identical to the interpreter
+// - Series must have one common length (the DSL would
+//   broadcast mismatched lengths, this API refuses them)
+// - Precedence is C++'s: the DSL reads + - * / left to right
+//   at one level, parenthesize to get the same grouping
+// ====================================================== //
+
+namespace Octurn::embed {
+
+struct exprTag {};
+
+template <typename T>
+concept expression = std::derived_from<std::remove_cvref_t<T>, exprTag>;
+
+// ==== Lengths: constants fit any series ==== //
+inline constexpr size_t UNBOUNDED = std::numeric_limits<size_t>::max();
+
+inline size_t mergeSize(size_t left, size_t right){
+    if (left == UNBOUNDED) return right;
+    if (right == UNBOUNDED || left == right) return left;
+    throw std::runtime_error("Static strategy: series lengths differ");
+}
+
+// ====================================================== //
+//                       Terminals
+// ====================================================== //
+
+struct series : exprTag {
+    std::span<const double> values;
+
+    explicit series(std::span<const double> values_) : values(values_) {}
+
+    size_t size() const { return values.size(); }
+    void validate(size_t) const {}
+    double at(size_t i) const { return values[i]; }
+};
+
+struct constant : exprTag {
+    double value;
+
+    explicit constant(double value_) : value(value_) {}
+
+    size_t size() const { return UNBOUNDED; }
+    void validate(size_t) const {}
+    double at(size_t) const { return value; }
+};
+
+// ==== Column of a loaded data map (e.g. MarketDataView::data(), "AAPL_close") ==== //
+inline series column(const std::unordered_map<std::string, AnyValue>& data, const std::string& key){
+    auto it = data.find(key);
+    const auto* values = (it != data.end()) ? std::get_if<std::vector<double>>(&it->second) : nullptr;
+    if (!values) throw std::runtime_error("Static strategy: series " + key + " is not loaded");
+    return series(*values);
+}
+
+// ====================================================== //
+//                   Binary operator node
+// ====================================================== //
+
+template <typename Op, expression L, expression R>
+struct binary : exprTag {
+    L left;
+    R right;
+
+    binary(L left_, R right_) : left(std::move(left_)), right(std::move(right_)) {}
+
+    size_t size() const { return mergeSize(left.size(), right.size()); }
+    void validate(size_t bars) const { left.validate(bars); right.validate(bars); }
+
+    // ==== Both sides always advance: indicator state must see every bar ==== //
+    auto at(size_t i){
+        const auto lhs = left.at(i);
+        const auto rhs = right.at(i);
+        return Op{}(lhs, rhs);
+    }
+};
+
+// ==== crosses_above / crosses_below: weak compare on the previous bar, strict on this one ==== //
+template <bool Above, expression L, expression R>
+struct crossing : exprTag {
+    L left;
+    R right;
+    double previousLeft = 0.0;
+    double previousRight = 0.0;
+
+    crossing(L left_, R right_) : left(std::move(left_)), right(std::move(right_)) {}
+
+    size_t size() const { return mergeSize(left.size(), right.size()); }
+    void validate(size_t bars) const { left.validate(bars); right.validate(bars); }
+
+    bool at(size_t i){
+        const double lhs = left.at(i);
+        const double rhs = right.at(i);
+        const bool crossed = (i > 0) && (Above ? (previousLeft <= previousRight && lhs > rhs)
+                                               : (previousLeft >= previousRight && lhs < rhs));
+        previousLeft = lhs;
+        previousRight = rhs;
+        return crossed;
+    }
+};
+
+// ====================================================== //
+//                       Indicators
+// ====================================================== //
+
+// ==== taLib MA: warm-up bars are 0.0, then a sliding sum ==== //
+template <size_t P, expression E>
+struct movingAverage : exprTag {
+    static_assert(P > 0, "MA period must be positive");
+
+    E input;
+    std::array<double, P> window{};
+    double sum = 0.0;
+
+    explicit movingAverage(E input_) : input(std::move(input_)) {}
+
+    size_t size() const { return input.size(); }
+
+    void validate(size_t bars) const {
+        if (bars < P) throw std::runtime_error("MA: incorrect data or period used to calculate MA.");
+        input.validate(bars);
+    }
+
+    double at(size_t i){
+        const double x = input.at(i);
+        double& slot = window[i % P];
+        if (i < P){
+            sum += x;
+            slot = x;
+            return (i + 1 < P) ? 0.0 : sum / static_cast<double>(P);
+        }
+        sum += x - slot;
+        slot = x;
+        return sum / static_cast<double>(P);
+    }
+};
+
+// ==== taLib RSI: NaN up to bar P, seeded averages, then Wilder's smoothing ==== //
+template <size_t P, expression E>
+struct relativeStrength : exprTag {
+    static_assert(P > 0, "RSI period must be positive");
+
+    E input;
+    double previous = 0.0;
+    double gainSum = 0.0;
+    double lossSum = 0.0;
+    double avgGain = 0.0;
+    double avgLoss = 0.0;
+
+    explicit relativeStrength(E input_) : input(std::move(input_)) {}
+
+    size_t size() const { return input.size(); }
+
+    void validate(size_t bars) const {
+        if (P >= bars) throw std::runtime_error("RSI: period must be >= 1 and < data size.");
+        input.validate(bars);
+    }
+
+    static double value(double gain, double loss){
+        if (loss == 0.0) return gain == 0.0 ? 50.0 : 100.0;
+        const double rs = gain / loss;
+        return 100.0 - (100.0 / (1.0 + rs));
+    }
+
+    double at(size_t i){
+        constexpr double inv = 1.0 / static_cast<double>(P);
+        const double x = input.at(i);
+        const double change = x - previous;
+        previous = x;
+
+        if (i == 0) return std::numeric_limits<double>::quiet_NaN();
+
+        if (i <= P){
+            if (change > 0.0) gainSum += change;
+            else lossSum += std::abs(change);
+            if (i < P) return std::numeric_limits<double>::quiet_NaN();
+
+            avgGain = gainSum * inv;
+            avgLoss = lossSum * inv;
+            return value(avgGain, avgLoss);
+        }
+
+        const double gain = (change > 0.0) ? change : 0.0;
+        const double loss = (change < 0.0) ? -change : 0.0;
+        avgGain = (avgGain * static_cast<double>(P - 1) + gain) * inv;
+        avgLoss = (avgLoss * static_cast<double>(P - 1) + loss) * inv;
+        return value(avgGain, avgLoss);
+    }
+};
+
+// ====================================================== //
+//                  DSL-shaped front end
+// ====================================================== //
+
+template <typename T>
+concept operand = expression<T> || std::is_arithmetic_v<std::remove_cvref_t<T>>;
+
+template <operand T>
+auto lift(T&& value){
+    if constexpr (expression<T>) return std::remove_cvref_t<T>(std::forward<T>(value));
+    else return constant(static_cast<double>(value));
+}
+
+template <typename Op, operand L, operand R>
+auto combine(L&& left, R&& right){
+    using LE = decltype(lift(std::forward<L>(left)));
+    using RE = decltype(lift(std::forward<R>(right)));
+    return binary<Op, LE, RE>(lift(std::forward<L>(left)), lift(std::forward<R>(right)));
+}
+
+template <size_t P, expression E>
+auto MA(E&& input){
+    return movingAverage<P, std::remove_cvref_t<E>>(std::forward<E>(input));
+}
+
+template <size_t P, expression E>
+auto RSI(E&& input){
+    return relativeStrength<P, std::remove_cvref_t<E>>(std::forward<E>(input));
+}
+
+template <operand L, operand R> requires (expression<L> || expression<R>)
+auto crossesAbove(L&& left, R&& right){
+    using LE = decltype(lift(std::forward<L>(left)));
+    using RE = decltype(lift(std::forward<R>(right)));
+    return crossing<true, LE, RE>(lift(std::forward<L>(left)), lift(std::forward<R>(right)));
+}
+
+template <operand L, operand R> requires (expression<L> || expression<R>)
+auto crossesBelow(L&& left, R&& right){
+    using LE = decltype(lift(std::forward<L>(left)));
+    using RE = decltype(lift(std::forward<R>(right)));
+    return crossing<false, LE, RE>(lift(std::forward<L>(left)), lift(std::forward<R>(right)));
+}
+
+// ==== At least one side must be an expression, plain numbers keep their own operators ==== //
+#define OCTURN_EMBED_OPERATOR(SYMBOL, FUNCTOR)                                      \
+    template <operand L, operand R> requires (expression<L> || expression<R>)     \
+    auto operator SYMBOL(L&& left, R&& right){                                     \
+        return combine<FUNCTOR>(std::forward<L>(left), std::forward<R>(right));    \
+    }
+
+OCTURN_EMBED_OPERATOR(+, OpPlus)
+OCTURN_EMBED_OPERATOR(-, OpMinus)
+OCTURN_EMBED_OPERATOR(*, OpMultiply)
+OCTURN_EMBED_OPERATOR(/, OpDivide)
+OCTURN_EMBED_OPERATOR(>, OpGreater)
+OCTURN_EMBED_OPERATOR(<, OpLess)
+OCTURN_EMBED_OPERATOR(==, OpEqual)
+OCTURN_EMBED_OPERATOR(&&, OpAnd)
+OCTURN_EMBED_OPERATOR(||, OpOr)
+
+#undef OCTURN_EMBED_OPERATOR
+
+// ====================================================== //
+//                       Evaluation
+// ====================================================== //
+
+template <expression E>
+size_t bars(const E& expr){
+    const size_t n = expr.size();
+    if (n == UNBOUNDED) throw std::runtime_error("Static strategy: expression reads no series");
+    expr.validate(n);
+    return n;
+}
+
+// ==== The expression is taken by value: every run starts from fresh indicator state ==== //
+template <expression E>
+void evaluate(E expr, std::span<uint8_t> out){
+    static_assert(std::is_same_v<decltype(expr.at(0)), bool>, "A signal must be a boolean expression");
+    const size_t n = bars(expr);
+    if (out.size() != n) throw std::runtime_error("Static strategy: output size does not match the series");
+
+    for (size_t i = 0; i < n; ++i) out[i] = static_cast<uint8_t>(expr.at(i));
+}
+
+template <expression E>
+void values(E expr, std::span<double> out){
+    static_assert(std::is_same_v<decltype(expr.at(0)), double>, "values() takes a numeric expression");
+    const size_t n = bars(expr);
+    if (out.size() != n) throw std::runtime_error("Static strategy: output size does not match the series");
+
+    for (size_t i = 0; i < n; ++i) out[i] = expr.at(i);
+}
+
+// ==== Same shape as Interpreter::evaluate_signals(), ready for runBacktest() ==== //
+template <expression Entry, expression Exit>
+std::pair<std::vector<bool>, std::vector<bool>> signals(const Entry& entry, const Exit& exit){
+    std::vector<uint8_t> entries(bars(entry));
+    std::vector<uint8_t> exits(bars(exit));
+    evaluate(entry, entries);
+    evaluate(exit, exits);
+    return {std::vector<bool>(entries.begin(), entries.end()), std::vector<bool>(exits.begin(), exits.end())};
+}
+
+}
@@ -0,0 +1,514 @@
+#include "strategyImage.hpp"
+
+#include <array>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "lexer/operators.hpp"
+#include "log/logHandler.hpp"
+
+namespace {
+
+constexpr char IMAGE_MAGIC[8] = {'O', 'C', 'T', 'P', 'R', 'O', 'G', '\0'};
+constexpr uint32_t FLAG_CONFIG = 1u;
+
+constexpr const char* NOT_EVALUABLE = "Visitor: evaluation not implemented for this node type.";
+
+// ==== Operators by variant index, the image stores the index ==== //
+const auto OPERATORS = []<size_t... I>(std::index_sequence<I...>){
+    return std::array<OperatorVariant, sizeof...(I)>{OperatorVariant(std::in_place_index<I>)...};
+}(std::make_index_sequence<std::variant_size_v<OperatorVariant>>{});
+
+// ==== FNV-1a 64 ==== //
+uint64_t checksum(const char* data, size_t size){
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < size; i++){
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+size_t alignUp(size_t offset){
+    return (offset + 7) & ~size_t{7};
+}
+
+// ====================================================== //
+//                    Image builder
+// - Walks the tree once, in the order the Interpreter
+//   evaluates it, and lowers expressions to postfix code
+// ====================================================== //
+class imageBuilder {
+    private:
+        std::string strings_;
+        std::unordered_map<std::string, imageString> interned_;
+        std::vector<imageValue> config_;
+        std::vector<imageRequest> data_;
+        std::vector<imageBlock> blocks_;
+        std::vector<imageValue> values_;
+        std::vector<imageAssignment> assignments_;
+        std::vector<imageInstruction> code_;
+        uint32_t flags_ = 0;
+        imageString name_{0, 0};
+
+        void emit(imageOp op, uint32_t operand = 0, imageString symbol = {0, 0}, double number = 0.0){
+            imageInstruction instruction{};
+            instruction.op = op;
+            instruction.operand = operand;
+            instruction.symbol = symbol;
+            instruction.number = number;
+            code_.push_back(instruction);
+        }
+
+        template <typename T>
+        static void append(std::vector<char>& out, const std::vector<T>& records, imageSection& section){
+            out.resize(alignUp(out.size()));
+            section = {out.size(), records.size()};
+            const auto* raw = reinterpret_cast<const char*>(records.data());
+            out.insert(out.end(), raw, raw + records.size() * sizeof(T));
+        }
+
+    public:
+        imageString intern(std::string_view text){
+            auto [it, inserted] = interned_.try_emplace(std::string(text));
+            if (inserted){
+                it->second = {static_cast<uint32_t>(strings_.size()), static_cast<uint32_t>(text.size())};
+                strings_.append(text);
+            }
+            return it->second;
+        }
+
+        // ==== Same rules as Interpreter::apply_kv ==== //
+        void flatten(const NodeMap& map, std::vector<imageValue>& out, bool nested){
+            for (const auto& [key, node] : map){
+                if (const auto* value = node_cast<ASTValueNode>(node)){
+                    imageValue record{};
+                    record.key = intern(key);
+                    if (const auto* number = std::get_if<double>(&value->value)){
+                        record.type = imageValueType::Number;
+                        record.number = *number;
+                    } else if (const auto* flag = std::get_if<bool>(&value->value)){
+                        record.type = imageValueType::Bool;
+                        record.number = *flag ? 1.0 : 0.0;
+                    } else if (const auto* text = std::get_if<std::string>(&value->value)){
+                        record.type = imageValueType::Text;
+                        record.text = intern(*text);
+                    } else {
+                        if (nested) flatten(std::get<NodeMap>(value->value), out, nested);
+                        continue;
+                    }
+                    out.push_back(record);
+                } else if (nested){
+                    if (const auto* block = node_cast<ASTBlock>(node)) flatten(block->entries, out, nested);
+                }
+            }
+        }
+
+        // ==== Function arguments: literals are passed as is, nested calls are evaluated ==== //
+        void lowerCall(const ASTFunctionCall& call){
+            uint32_t argc{0};
+            for (const ASTNode* arg : call.expr){
+                if (const auto* value = node_cast<ASTValueNode>(arg)){
+                    if (const auto* number = std::get_if<double>(&value->value)) emit(imageOp::PushNumber, 0, {0, 0}, *number);
+                    else if (const auto* flag = std::get_if<bool>(&value->value)) emit(imageOp::PushBool, 0, {0, 0}, *flag ? 1.0 : 0.0);
+                    else if (const auto* text = std::get_if<std::string>(&value->value)) emit(imageOp::PushText, 0, intern(*text));
+                    else continue;
+                    argc++;
+                } else if (const auto* nested = node_cast<ASTFunctionCall>(arg)){
+                    lowerCall(*nested);
+                    argc++;
+                }
+            }
+            emit(imageOp::Call, argc, intern(call.name));
+            if (call.lag) emitLag(*call.lag);
+        }
+
+        void emitLag(const ASTNode& bars){
+            lower(bars);
+            emit(imageOp::Lag, 0, intern("lag"));
+        }
+
+        void lower(const ASTNode& node){
+            switch (node.kind) {
+                case NodeKind::Value: {
+                    const auto& value = static_cast<const ASTValueNode&>(node).value;
+                    if (const auto* number = std::get_if<double>(&value)) emit(imageOp::PushNumber, 0, {0, 0}, *number);
+                    else if (const auto* flag = std::get_if<bool>(&value)) emit(imageOp::PushBool, 0, {0, 0}, *flag ? 1.0 : 0.0);
+                    else if (const auto* text = std::get_if<std::string>(&value)) emit(imageOp::LoadSymbol, 0, intern(*text));
+                    else emit(imageOp::Fail, 0, intern("Unable to cast NodeMap to AnyValue type."));
+                    return;
+                }
+                case NodeKind::FunctionCall:
+                    lowerCall(static_cast<const ASTFunctionCall&>(node));
+                    return;
+                case NodeKind::Arithmetics:
+                case NodeKind::Comparison:
+                case NodeKind::Expression: {
+                    const auto& binary = static_cast<const ASTBinary&>(node);
+                    auto op = OperatorMap.find(binary.op);
+                    if (op == OperatorMap.end()) throw std::runtime_error(std::format("Unknown operator '{}'", binary.op));
+                    lower(*binary.left);
+                    lower(*binary.right);
+                    emit(imageOp::Binary, static_cast<uint32_t>(op->second.index()), intern(binary.op));
+                    return;
+                }
+                case NodeKind::Crosses: {
+                    const auto& crosses = static_cast<const ASTCrosses&>(node);
+                    lower(*crosses.left);
+                    lower(*crosses.right);
+                    emit(imageOp::Cross, 0, intern(crosses.op));
+                    return;
+                }
+                case NodeKind::Lag: {
+                    const auto& lag = static_cast<const ASTLag&>(node);
+                    lower(*lag.series);
+                    emitLag(*lag.bars);
+                    return;
+                }
+                // ==== Operands in the Visitor's order, 'for N bars' pushes N twice ==== //
+                case NodeKind::Temporal: {
+                    const auto& temporal = static_cast<const ASTTemporal&>(node);
+                    lower(*temporal.condition);
+                    if (temporal.series) lower(*temporal.series);
+                    if (temporal.window) lower(*temporal.window);
+                    if (temporal.op == temporalOp::For) lower(temporal.required ? *temporal.required : *temporal.window);
+                    emit(imageOp::Temporal, static_cast<uint32_t>(temporal.op), intern(temporal_name(temporal.op)));
+                    return;
+                }
+                case NodeKind::Condition:
+                case NodeKind::LogicalCondition:
+                    emit(imageOp::Fail, 0, intern(NOT_EVALUABLE));
+                    return;
+                default:
+                    emit(imageOp::PushBool, 0, {0, 0}, 0.0);
+                    return;
+            }
+        }
+
+        void signal(const ASTBlock& block, imageBlockKind kind, const char* key){
+            const auto first = static_cast<uint32_t>(code_.size());
+            auto it = block.entries.find(key);
+            if (it != block.entries.end() && it->second) lower(*it->second);
+            blocks_.push_back({kind, first, static_cast<uint32_t>(code_.size()) - first, 0});
+        }
+
+        void strategy(const Strategy& strategy){
+            name_ = intern(strategy.name);
+
+            for (const ASTNode* node : strategy.blocks){
+                const auto* block = node_cast<ASTBlock>(node);
+                if (!block || !block->block_type) continue;
+
+                switch (*block->block_type) {
+                    case Tokentype::Config:
+                    case Tokentype::Parameters: {
+                        const bool isConfig = *block->block_type == Tokentype::Config;
+                        const auto first = static_cast<uint32_t>(values_.size());
+                        flatten(block->entries, values_, isConfig);
+                        blocks_.push_back({isConfig ? imageBlockKind::Config : imageBlockKind::Parameters,
+                                           first, static_cast<uint32_t>(values_.size()) - first, 0});
+                        break;
+                    }
+                    case Tokentype::Indicators: {
+                        const auto first = static_cast<uint32_t>(assignments_.size());
+                        for (const auto& [key, node] : block->entries){
+                            const auto* assignment = node_cast<ASTAssignment>(node);
+                            const auto* call = assignment ? node_cast<ASTFunctionCall>(assignment->expr) : nullptr;
+                            if (!call) continue;
+
+                            const auto codeFirst = static_cast<uint32_t>(code_.size());
+                            lowerCall(*call);
+                            assignments_.push_back({intern(key), codeFirst, static_cast<uint32_t>(code_.size()) - codeFirst});
+                        }
+                        blocks_.push_back({imageBlockKind::Indicators, first, static_cast<uint32_t>(assignments_.size()) - first, 0});
+                        break;
+                    }
+                    case Tokentype::Entry:
+                        signal(*block, imageBlockKind::Entry, "Entry");
+                        break;
+                    case Tokentype::Exit:
+                        signal(*block, imageBlockKind::Exit, "Exit");
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        void root(const ASTRoot& root){
+            if (root.config.has_value()){
+                if (const auto* block = node_cast<ASTBlock>(root.config.value())){
+                    flags_ |= FLAG_CONFIG;
+                    flatten(block->entries, config_, true);
+                }
+            }
+
+            for (const auto& request : MarketDataView::requests(node_cast<ASTList>(root.data))){
+                imageRequest record{};
+                record.ticker = intern(request.ticker);
+                record.timespan = intern(request.timespan);
+                record.from = intern(request.from);
+                record.to = intern(request.to);
+                record.multiplier = request.multiplier;
+                data_.push_back(record);
+            }
+
+            if (const auto* node = node_cast<Strategy>(root.strategy)) strategy(*node);
+        }
+
+        std::vector<char> finish(){
+            std::vector<char> out(sizeof(imageHeader));
+            imageHeader header{};
+            std::memcpy(header.magic, IMAGE_MAGIC, sizeof(header.magic));
+            header.version = STRATEGY_IMAGE_VERSION;
+            header.flags = flags_;
+            header.name = name_;
+
+            append(out, config_, header.sections[SECTION_CONFIG]);
+            append(out, data_, header.sections[SECTION_DATA]);
+            append(out, blocks_, header.sections[SECTION_BLOCKS]);
+            append(out, values_, header.sections[SECTION_VALUES]);
+            append(out, assignments_, header.sections[SECTION_ASSIGNMENTS]);
+            append(out, code_, header.sections[SECTION_CODE]);
+
+            header.sections[SECTION_STRINGS] = {out.size(), strings_.size()};
+            out.insert(out.end(), strings_.begin(), strings_.end());
+            out.resize(alignUp(out.size()));
+
+            header.size = out.size();
+            header.checksum = checksum(out.data() + sizeof(imageHeader), out.size() - sizeof(imageHeader));
+            std::memcpy(out.data(), &header, sizeof(header));
+            return out;
+        }
+};
+
+}
+
+std::vector<char> strategyImage::build(const syntaxTree& tree){
+    if (!tree.root()) throw std::runtime_error("Unable to build a strategy image: syntax tree has no root.");
+
+    imageBuilder builder;
+    builder.root(*tree.root());
+    return builder.finish();
+}
+
+// ====================================================== //
+//                      Image view
+// ====================================================== //
+
+strategyImage::strategyImage(const char* data, size_t size)
+    : data_(data), size_(size), header_(reinterpret_cast<const imageHeader*>(data)) {
+    validate();
+}
+
+// ==== Every reference is checked here once, accessors and evaluate() trust the image afterwards ==== //
+void strategyImage::validate() const {
+    if (size_ < sizeof(imageHeader) || reinterpret_cast<std::uintptr_t>(data_) % alignof(imageHeader) != 0){
+        throw std::runtime_error("Strategy image is truncated or misaligned");
+    }
+    if (std::memcmp(header_->magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC)) != 0){
+        throw std::runtime_error("Not a strategy image");
+    }
+    if (header_->version != STRATEGY_IMAGE_VERSION){
+        throw std::runtime_error(std::format("Strategy image version {} is not supported (expected {})",
+            header_->version, STRATEGY_IMAGE_VERSION));
+    }
+    if (header_->size != size_){
+        throw std::runtime_error("Strategy image size does not match its header");
+    }
+    if (checksum(data_ + sizeof(imageHeader), size_ - sizeof(imageHeader)) != header_->checksum){
+        throw std::runtime_error("Strategy image checksum mismatch");
+    }
+
+    constexpr size_t RECORD_SIZE[SECTION_COUNT] = {
+        sizeof(imageValue), sizeof(imageRequest), sizeof(imageBlock), sizeof(imageValue),
+        sizeof(imageAssignment), sizeof(imageInstruction), 1
+    };
+    for (uint32_t id = 0; id < SECTION_COUNT; id++){
+        const auto& s = header_->sections[id];
+        const bool aligned = id == SECTION_STRINGS || s.offset % 8 == 0;
+        if (!aligned || s.offset < sizeof(imageHeader) || s.offset > size_ || s.count > (size_ - s.offset) / RECORD_SIZE[id]){
+            throw std::runtime_error(std::format("Strategy image section {} is out of bounds", id));
+        }
+    }
+
+    const uint64_t stringBytes = header_->sections[SECTION_STRINGS].count;
+    auto checkString = [&](imageString ref){
+        if (uint64_t{ref.offset} + ref.length > stringBytes) throw std::runtime_error("Strategy image string is out of bounds");
+    };
+    auto checkRange = [](uint64_t first, uint64_t count, uint64_t total, const char* what){
+        if (first + count > total) throw std::runtime_error(std::format("Strategy image {} range is out of bounds", what));
+    };
+    auto checkValue = [&](const imageValue& value){
+        checkString(value.key);
+        if (value.type > imageValueType::Text) throw std::runtime_error("Strategy image value has an unknown type");
+        if (value.type == imageValueType::Text) checkString(value.text);
+    };
+
+    checkString(header_->name);
+    for (const auto& value : config()) checkValue(value);
+    for (const auto& value : values()) checkValue(value);
+    for (const auto& request : data()){
+        checkString(request.ticker);
+        checkString(request.timespan);
+        checkString(request.from);
+        checkString(request.to);
+    }
+    for (const auto& assignment : assignments()){
+        checkString(assignment.name);
+        checkRange(assignment.first, assignment.count, code().size(), "code");
+    }
+    for (const auto& block : blocks()){
+        switch (block.kind) {
+            case imageBlockKind::Config:
+            case imageBlockKind::Parameters: checkRange(block.first, block.count, values().size(), "values"); break;
+            case imageBlockKind::Indicators: checkRange(block.first, block.count, assignments().size(), "assignments"); break;
+            case imageBlockKind::Entry:
+            case imageBlockKind::Exit: checkRange(block.first, block.count, code().size(), "code"); break;
+            default: throw std::runtime_error("Strategy image block has an unknown kind");
+        }
+    }
+    for (const auto& instruction : code()){
+        if (instruction.op > imageOp::Lag) throw std::runtime_error("Strategy image has an unknown instruction");
+        if (instruction.op == imageOp::Binary && instruction.operand >= OPERATORS.size()){
+            throw std::runtime_error("Strategy image has an unknown operator");
+        }
+        if (instruction.op == imageOp::Temporal && instruction.operand > static_cast<uint32_t>(temporalOp::HighestSince)){
+            throw std::runtime_error("Strategy image has an unknown operator");
+        }
+        checkString(instruction.symbol);
+        if (instruction.op == imageOp::Cross && text(instruction.symbol) != "crosses_above" && text(instruction.symbol) != "crosses_below"){
+            throw std::runtime_error("Strategy image has an unknown operator");
+        }
+    }
+}
+
+std::string_view strategyImage::name() const {
+    return text(header_->name);
+}
+
+std::string_view strategyImage::text(imageString ref) const {
+    return std::string_view(data_ + header_->sections[SECTION_STRINGS].offset + ref.offset, ref.length);
+}
+
+size_t strategyImage::size() const {
+    return size_;
+}
+
+std::span<const imageValue> strategyImage::config() const { return section<imageValue>(SECTION_CONFIG); }
+std::span<const imageRequest> strategyImage::data() const { return section<imageRequest>(SECTION_DATA); }
+std::span<const imageBlock> strategyImage::blocks() const { return section<imageBlock>(SECTION_BLOCKS); }
+std::span<const imageValue> strategyImage::values() const { return section<imageValue>(SECTION_VALUES); }
+std::span<const imageAssignment> strategyImage::assignments() const { return section<imageAssignment>(SECTION_ASSIGNMENTS); }
+std::span<const imageInstruction> strategyImage::code() const { return section<imageInstruction>(SECTION_CODE); }
+
+bool strategyImage::hasConfig() const {
+    return header_->flags & FLAG_CONFIG;
+}
+
+std::vector<dataRequest> strategyImage::requests() const {
+    std::vector<dataRequest> out;
+    out.reserve(data().size());
+    for (const auto& request : data()){
+        out.push_back({std::string(text(request.ticker)), std::string(text(request.timespan)),
+                       std::string(text(request.from)), std::string(text(request.to)), request.multiplier});
+    }
+    return out;
+}
+
+// ====================================================== //
+//                     Stack machine
+// - Same results and errors as the tree Visitor
+// ====================================================== //
+
+AnyValue strategyImage::evaluate(uint32_t first, uint32_t count, ExecutionContext& ctx, std::vector<AnyValue>& stack) const {
+    stack.clear();
+
+    auto need = [&](size_t n){
+        if (stack.size() < n) throw std::runtime_error("Strategy image code is malformed (stack underflow)");
+    };
+
+    for (const auto& instruction : code().subspan(first, count)){
+        switch (instruction.op) {
+            case imageOp::PushNumber:
+                stack.emplace_back(instruction.number);
+                break;
+            case imageOp::PushBool:
+                stack.emplace_back(instruction.number != 0.0);
+                break;
+            case imageOp::PushText:
+                stack.emplace_back(std::string(text(instruction.symbol)));
+                break;
+            case imageOp::LoadSymbol: {
+                std::string symbol(text(instruction.symbol));
+                auto it = ctx.variables.find(symbol);
+                const auto* series = (it != ctx.variables.end()) ? std::get_if<std::vector<double>>(&it->second) : nullptr;
+                const auto* number = (it != ctx.variables.end()) ? std::get_if<double>(&it->second) : nullptr;
+                if (series) stack.emplace_back(*series);
+                else if (number) stack.emplace_back(*number);
+                else stack.emplace_back(std::move(symbol));
+                break;
+            }
+            case imageOp::Call: {
+                need(instruction.operand);
+                const auto argsBegin = stack.end() - instruction.operand;
+                multiValue args(std::make_move_iterator(argsBegin), std::make_move_iterator(stack.end()));
+                stack.erase(argsBegin, stack.end());
+
+                const std::string name(text(instruction.symbol));
+                auto it = ctx.functionMapper.find(name);
+                if (it == ctx.functionMapper.end()){
+                    throw std::runtime_error(std::format("Unknown function '{}'", name));
+                }
+
+                try {
+                    stack.emplace_back(it->second(args, ctx.variables, ctx.dataMap));
+                } catch (const std::exception& e) {
+                    g_logger.report(std::format("[TA] {} failed: {}", name, e.what()));
+                    throw;
+                }
+                break;
+            }
+            case imageOp::Binary: {
+                need(2);
+                AnyValue right = std::move(stack.back());
+                stack.pop_back();
+                AnyValue left = std::move(stack.back());
+                stack.back() = apply_operator(left, right, OPERATORS[instruction.operand]);
+                break;
+            }
+            case imageOp::Cross: {
+                need(2);
+                AnyValue right = std::move(stack.back());
+                stack.pop_back();
+                stack.back() = cross_values(stack.back(), right, std::string(text(instruction.symbol)));
+                break;
+            }
+            case imageOp::Temporal: {
+                const auto op = static_cast<temporalOp>(instruction.operand);
+                const size_t arity = temporal_arity(op);
+                need(arity);
+                AnyValue value = temporal_values(op, std::span<const AnyValue>(stack).last(arity));
+                stack.resize(stack.size() - arity);
+                stack.push_back(std::move(value));
+                break;
+            }
+            case imageOp::Lag: {
+                need(2);
+                AnyValue bars = std::move(stack.back());
+                stack.pop_back();
+                stack.back() = lag_values(std::move(stack.back()), bars);
+                break;
+            }
+            case imageOp::Fail:
+                throw std::runtime_error(std::string(text(instruction.symbol)));
+        }
+    }
+
+    if (stack.size() != 1) throw std::runtime_error("Strategy image code is malformed (unbalanced stack)");
+    return std::move(stack.back());
+}
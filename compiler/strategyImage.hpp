@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "node/Node.hpp"
+#include "marketDataView/DataLayer.hpp"
+
+// ====================================================== //
+//                   Strategy image
+// - Flat, versioned binary form of a compiled strategy,
+//   meant for queue transport to backtest workers
+// - Layout: header, then 8-byte aligned record sections
+//   (config, data, blocks, values, assignments, code) and
+//   one string blob, host byte order
+// - Identifiers are resolved once into the blob, records
+//   refer to them by (offset, length)
+// - Expressions are lowered to postfix instructions with
+//   operators resolved, evaluated by a small stack machine
+// - A reader is a view: the header, every reference and the
+//   checksum are validated once, the bytes are then used in
+//   place (no copy, no tree rebuilt)
+// ====================================================== //
+
+#define STRATEGY_IMAGE_VERSION 4
+
+struct imageString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+enum class imageValueType : uint8_t { Number, Bool, Text };
+
+// ==== key: value pair of config / parameters, nested config blocks are flattened ==== //
+struct imageValue {
+    imageString key;
+    imageValueType type;
+    uint8_t pad[7];
+    double number;
+    imageString text;
+};
+
+struct imageRequest {
+    imageString ticker;
+    imageString timespan;
+    imageString from;
+    imageString to;
+    int32_t multiplier;
+    uint32_t pad;
+};
+
+// ==== Strategy blocks in source order, [first, first + count) into values / assignments / code ==== //
+enum class imageBlockKind : uint32_t { Config, Parameters, Indicators, Entry, Exit };
+
+struct imageBlock {
+    imageBlockKind kind;
+    uint32_t first;
+    uint32_t count;
+    uint32_t pad;
+};
+
+struct imageAssignment {
+    imageString name;
+    uint32_t first;
+    uint32_t count;
+};
+
+enum class imageOp : uint8_t {
+    PushNumber,     // number
+    PushBool,       // number != 0
+    PushText,       // symbol as a plain string (function arguments)
+    LoadSymbol,     // series / number stored under symbol, else the symbol itself
+    Call,           // symbol = function, operand = argument count
+    Binary,         // operand = operator index, symbol kept for messages
+    Fail,           // node kind without evaluation
+    Cross,          // symbol = "crosses_above" / "crosses_below"
+    Temporal,       // operand = temporalOp, pops temporal_arity() values
+    Lag             // pops series, bars
+};
+
+struct imageInstruction {
+    imageOp op;
+    uint8_t pad[3];
+    uint32_t operand;
+    imageString symbol;
+    double number;
+};
+
+enum imageSectionId : uint32_t {
+    SECTION_CONFIG, SECTION_DATA, SECTION_BLOCKS, SECTION_VALUES,
+    SECTION_ASSIGNMENTS, SECTION_CODE, SECTION_STRINGS, SECTION_COUNT
+};
+
+struct imageSection {
+    uint64_t offset;
+    uint64_t count;
+};
+
+struct imageHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t size;
+    uint64_t checksum;
+    imageString name;
+    imageSection sections[SECTION_COUNT];
+};
+
+class strategyImage {
+    private:
+        const char* data_;
+        size_t size_;
+        const imageHeader* header_;
+
+        template <typename T>
+        std::span<const T> section(imageSectionId id) const {
+            const auto& s = header_->sections[id];
+            return {reinterpret_cast<const T*>(data_ + s.offset), static_cast<size_t>(s.count)};
+        }
+
+        void validate() const;
+
+    public:
+        // ==== Serializes a parsed tree ==== //
+        static std::vector<char> build(const syntaxTree& tree);
+
+        // ==== data must be 8-byte aligned and outlive the view ==== //
+        strategyImage(const char* data, size_t size);
+
+        std::string_view name() const;
+        std::string_view text(imageString ref) const;
+        size_t size() const;
+
+        std::span<const imageValue> config() const;
+        std::span<const imageRequest> data() const;
+        std::span<const imageBlock> blocks() const;
+        std::span<const imageValue> values() const;
+        std::span<const imageAssignment> assignments() const;
+        std::span<const imageInstruction> code() const;
+
+        std::vector<dataRequest> requests() const;
+
+        // ==== The script had a top-level 'config' block ==== //
+        bool hasConfig() const;
+
+        // ==== Runs code [first, first + count), stack is scratch reused between calls ==== //
+        AnyValue evaluate(uint32_t first, uint32_t count, ExecutionContext& ctx, std::vector<AnyValue>& stack) const;
+};
@@ -0,0 +1,367 @@
+#include "strategyJit.hpp"
+
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+#include "log/logHandler.hpp"
+
+namespace {
+
+const char* envOr(const char* name, const char* fallback){
+    const char* value = std::getenv(name);
+    return (value && *value) ? value : fallback;
+}
+
+// ==== FNV-1a 64 ==== //
+uint64_t fnv1a(std::string_view text, uint64_t hash = 1469598103934665603ull){
+    for (const char c : text){
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// ==== Shortest round-trip form, always a double literal ==== //
+std::string literal(double value){
+    if (std::isnan(value)) return "__builtin_nan(\"\")";
+    if (std::isinf(value)) return value > 0 ? "__builtin_inf()" : "(-__builtin_inf())";
+
+    std::string text = std::format("{}", value);
+    if (text.find_first_of(".e") == std::string::npos) text += ".0";
+    return value < 0 ? "(" + text + ")" : text;
+}
+
+// ==== Bar i - lag of input k, NaN before the series starts (comparisons on it are false) ==== //
+std::string seriesRead(size_t k, size_t lag){
+    if (lag == 0) return std::format("s[{}][i]", k);
+    return std::format("(i >= {} ? s[{}][i - {}] : __builtin_nan(\"\"))", lag, k, lag);
+}
+
+const char* cxxOperator(const std::string& op){
+    if (op == "and") return "&&";
+    if (op == "or") return "||";
+    if (op == "+" || op == "-" || op == "*" || op == "/" || op == ">" || op == "<" || op == "==") return op.c_str();
+    return nullptr;
+}
+
+std::string render(const std::string& expression){
+    return std::format(
+        "// octurn jit, abi {}\n"
+        "#include <cstddef>\n"
+        "#include <cstdint>\n"
+        "extern \"C\" const unsigned octurn_jit_abi = {};\n"
+        "extern \"C\" void octurn_signal(const double* const* s, const double* p, std::size_t n, std::uint8_t* out) {{\n"
+        "    (void)s; (void)p;\n"
+        "    for (std::size_t i = 0; i < n; ++i) {{\n"
+        "        out[i] = static_cast<std::uint8_t>(static_cast<bool>({}));\n"
+        "    }}\n"
+        "}}\n",
+        JIT_ABI_VERSION, JIT_ABI_VERSION, expression);
+}
+
+std::filesystem::path defaultCacheDir(){
+    if (const char* dir = std::getenv("OCTURN_JIT_CACHE"); dir && *dir) return dir;
+    if (const char* dir = std::getenv("XDG_CACHE_HOME"); dir && *dir) return std::filesystem::path(dir) / "octurn-jit";
+    if (const char* home = std::getenv("HOME"); home && *home) return std::filesystem::path(home) / ".cache" / "octurn-jit";
+    return std::filesystem::temp_directory_path() / std::format("octurn-jit-{}", ::geteuid());
+}
+
+// ==== Ours and not writable by group / others: nobody else can plant or swap what dlopen reads ==== //
+bool ownedPrivate(const std::filesystem::path& path){
+    struct stat info{};
+    if (::stat(path.c_str(), &info) != 0) return false;
+    return info.st_uid == ::geteuid() && (info.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+std::string readFile(const std::filesystem::path& path){
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    return buffer.str();
+}
+
+}
+
+strategyJit::strategyJit(jitOptions options) : options_(std::move(options)) {
+    if (options_.cacheDir.empty()) options_.cacheDir = defaultCacheDir();
+    if (options_.compiler.empty()) options_.compiler = envOr("OCTURN_JIT_CXX", "c++");
+
+    // ==== Parents with the usual mode, the cache itself 0700 (an existing one is checked, not chmod'ed) ==== //
+    std::error_code ec;
+    if (options_.cacheDir.has_parent_path()) std::filesystem::create_directories(options_.cacheDir.parent_path(), ec);
+    if (::mkdir(options_.cacheDir.c_str(), 0700) != 0 && errno != EEXIST){
+        g_logger.report(std::format("[JIT] Cache directory {} unavailable: {}", options_.cacheDir.string(), std::strerror(errno)));
+        return;
+    }
+
+    cacheTrusted_ = std::filesystem::is_directory(options_.cacheDir, ec) && ownedPrivate(options_.cacheDir);
+    if (!cacheTrusted_){
+        g_logger.report(std::format("[JIT][ERROR] Cache directory {} is not owned by this user or is group/world-writable, JIT disabled",
+            options_.cacheDir.string()));
+    }
+}
+
+strategyJit::~strategyJit(){
+    for (void* handle : handles_) dlclose(handle);
+}
+
+const jitOptions& strategyJit::options() const {
+    return options_;
+}
+
+size_t strategyJit::compiled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return compiled_;
+}
+
+size_t strategyJit::loadedFromDisk() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return loadedFromDisk_;
+}
+
+// ====================================================== //
+//                    Code generation
+// - Only nodes typed by the semantic pass are taken
+// - Same element-wise operators as lexer/operators.hpp
+// ====================================================== //
+
+bool strategyJit::emit(const ASTNode& node, program& prog, std::string& out, size_t lag) const {
+    switch (node.kind) {
+        case NodeKind::Value: {
+            const auto& value = static_cast<const ASTValueNode&>(node).value;
+            if (const auto* number = std::get_if<double>(&value)){
+                out += literal(*number);
+                return true;
+            }
+            if (const auto* flag = std::get_if<bool>(&value)){
+                out += *flag ? "true" : "false";
+                return true;
+            }
+            const auto* name = std::get_if<std::string>(&value);
+            if (!name) return false;
+
+            if (node.type == valueType::Number){
+                size_t k = 0;
+                while (k < prog.scalars.size() && prog.scalars[k] != *name) k++;
+                if (k == prog.scalars.size()) prog.scalars.push_back(*name);
+                out += std::format("p[{}]", k);
+                return true;
+            }
+            if (node.type == valueType::NumberSeries){
+                size_t k = 0;
+                while (k < prog.series.size() && !(prog.series[k]->kind == NodeKind::Value &&
+                       std::get<std::string>(static_cast<const ASTValueNode*>(prog.series[k])->value) == *name)) k++;
+                if (k == prog.series.size()) prog.series.push_back(&node);
+                out += seriesRead(k, lag);
+                return true;
+            }
+            return false;
+        }
+        case NodeKind::Temporal:
+            // ==== bars_since / count / highest_since are series inputs, for / within stay interpreted ==== //
+            if (node.type != valueType::NumberSeries) return false;
+            [[fallthrough]];
+        case NodeKind::FunctionCall: {
+            // ==== Evaluated by the Visitor beforehand (once per node), read as a series ==== //
+            size_t k = 0;
+            while (k < prog.series.size() && prog.series[k] != &node) k++;
+            if (k == prog.series.size()) prog.series.push_back(&node);
+            out += seriesRead(k, lag);
+            return true;
+        }
+        case NodeKind::Arithmetics:
+        case NodeKind::Comparison:
+        case NodeKind::Expression: {
+            const auto& binary = static_cast<const ASTBinary&>(node);
+            const char* op = cxxOperator(binary.op);
+            if (node.type == valueType::Unknown || !op) return false;
+
+            out += "(";
+            if (!emit(*binary.left, prog, out, lag)) return false;
+            out += std::format(" {} ", op);
+            if (!emit(*binary.right, prog, out, lag)) return false;
+            out += ")";
+            return true;
+        }
+        case NodeKind::Crosses: {
+            // ==== Same rule as ta/crosses: weak compare one bar back, strict on this bar, ordered (NaN -> false) ==== //
+            const auto& crosses = static_cast<const ASTCrosses&>(node);
+            if (node.type != valueType::BoolSeries) return false;
+            const bool above = crosses.op == "crosses_above";
+
+            std::string left, right, leftBefore, rightBefore;
+            if (!emit(*crosses.left, prog, left, lag) || !emit(*crosses.right, prog, right, lag)) return false;
+            if (!emit(*crosses.left, prog, leftBefore, lag + 1) || !emit(*crosses.right, prog, rightBefore, lag + 1)) return false;
+
+            out += std::format("(({} {} {}) && ({} {} {}))",
+                leftBefore, above ? "<=" : ">=", rightBefore, left, above ? ">" : "<", right);
+            return true;
+        }
+        case NodeKind::Lag: {
+            // ==== Constant lags only: the shift is folded into every read below ==== //
+            const auto& shifted = static_cast<const ASTLag&>(node);
+            const auto* bars = node_cast<ASTValueNode>(shifted.bars);
+            const auto* count = bars ? std::get_if<double>(&bars->value) : nullptr;
+            if (!count || node.type == valueType::Unknown) return false;
+            // ==== Lags past JIT_MAX_LAG stay interpreted, where they are clamped to the series length ==== //
+            if (!(*count >= 0.0 && *count <= JIT_MAX_LAG)) return false;
+            return emit(*shifted.series, prog, out, lag + static_cast<size_t>(*count));
+        }
+        default:
+            return false;
+    }
+}
+
+// ====================================================== //
+//                 Build / load / cache
+// ====================================================== //
+
+bool strategyJit::build(const std::filesystem::path& source, const std::filesystem::path& object) const {
+    const auto staging = object.string() + std::format(".{}.tmp", ::getpid());
+    const auto log = object.string() + ".log";
+    const auto command = std::format("\"{}\" {} -o \"{}\" \"{}\" > \"{}\" 2>&1",
+        options_.compiler, JIT_CXX_FLAGS, staging, source.string(), log);
+
+    if (std::system(command.c_str()) != 0){
+        g_logger.report(std::format("[JIT][ERROR] Toolchain failed, see {}", log));
+        std::filesystem::remove(staging);
+        return false;
+    }
+
+    // ==== Private whatever the umask, then rename() (atomic): concurrent processes never load a half-written object ==== //
+    std::error_code ec;
+    std::filesystem::permissions(staging, std::filesystem::perms::owner_all, ec);
+    if (!ec) std::filesystem::rename(staging, object, ec);
+    return !ec;
+}
+
+jitSignalFn strategyJit::open(const std::filesystem::path& object, const std::string& source){
+    auto sourcePath = object;
+    sourcePath.replace_extension(".cpp");
+    if (!ownedPrivate(object) || !ownedPrivate(sourcePath)){
+        g_logger.report(std::format("[JIT][ERROR] Refusing to load {}: not owned by this user or group/world-writable", object.string()));
+        return nullptr;
+    }
+    if (readFile(sourcePath) != source) return nullptr;
+
+    void* handle = dlopen(object.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) return nullptr;
+
+    const auto* abi = static_cast<const unsigned*>(dlsym(handle, "octurn_jit_abi"));
+    auto fn = reinterpret_cast<jitSignalFn>(dlsym(handle, "octurn_signal"));
+    if (!abi || *abi != JIT_ABI_VERSION || !fn){
+        dlclose(handle);
+        return nullptr;
+    }
+
+    handles_.push_back(handle);
+    return fn;
+}
+
+// ==== Builds under the lock: concurrent sweeps on one expression compile it once ==== //
+jitSignalFn strategyJit::kernelFor(const program& prog){
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = kernels_.find(prog.hash);
+    if (it != kernels_.end()) return it->second;
+
+    const auto stem = options_.cacheDir / std::format("{:016x}", prog.hash);
+    auto object = stem;
+    object.replace_extension(".so");
+    auto source = stem;
+    source.replace_extension(".cpp");
+
+    jitSignalFn fn = nullptr;
+    bool collision = !cacheTrusted_;
+    if (cacheTrusted_ && std::filesystem::exists(object)){
+        // ==== Same hash, other source: never overwrite, dlopen would hand back the loaded object ==== //
+        collision = std::filesystem::exists(source) && readFile(source) != prog.source;
+        if (!collision) fn = open(object, prog.source);
+        if (fn) loadedFromDisk_++;
+    }
+
+    if (!fn && !collision){
+        std::ofstream(source, std::ios::binary | std::ios::trunc) << prog.source;
+        std::error_code ec;
+        std::filesystem::permissions(source, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write, ec);
+        if (build(source, object)){
+            fn = open(object, prog.source);
+            compiled_++;
+            g_logger.report(std::format("[JIT] Compiled {} -> {}", prog.expression, object.string()));
+        }
+    }
+
+    if (!fn) g_logger.report(std::format("[JIT] Falling back to the interpreter for {}", prog.expression));
+    kernels_.emplace(prog.hash, fn);
+    return fn;
+}
+
+// ====================================================== //
+//                       Evaluate
+// ====================================================== //
+
+std::optional<AnyValue> strategyJit::evaluate(const ASTNode& condition, ExecutionContext& ctx){
+    if (condition.type != valueType::BoolSeries) return std::nullopt;
+
+    program prog;
+    if (!emit(condition, prog, prog.expression)) return std::nullopt;
+    prog.source = render(prog.expression);
+    prog.hash = fnv1a(JIT_CXX_FLAGS, fnv1a(options_.compiler, fnv1a(prog.source)));
+
+    jitSignalFn fn = kernelFor(prog);
+    if (!fn) return std::nullopt;
+
+    // ==== Inputs: variables as they are now, nested calls through the Visitor ==== //
+    Visitor visitor(ctx);
+    std::vector<std::vector<double>> owned;
+    owned.reserve(prog.series.size());
+    std::vector<const double*> series;
+    series.reserve(prog.series.size());
+
+    std::optional<size_t> bars;
+    for (const ASTNode* input : prog.series){
+        const std::vector<double>* values = nullptr;
+        if (input->kind != NodeKind::Value){
+            auto result = visitor.visit(*input);
+            auto* computed = std::get_if<std::vector<double>>(&result);
+            if (!computed) return std::nullopt;
+            owned.push_back(std::move(*computed));
+            values = &owned.back();
+        } else {
+            auto it = ctx.variables.find(std::get<std::string>(static_cast<const ASTValueNode*>(input)->value));
+            if (it == ctx.variables.end()) return std::nullopt;
+            values = std::get_if<std::vector<double>>(&it->second);
+            if (!values) return std::nullopt;
+        }
+
+        // ==== The generic path broadcasts unequal lengths, keep that case there ==== //
+        if (bars && *bars != values->size()) return std::nullopt;
+        bars = values->size();
+        series.push_back(values->data());
+    }
+
+    std::vector<double> scalars;
+    scalars.reserve(prog.scalars.size());
+    for (const auto& name : prog.scalars){
+        auto it = ctx.variables.find(name);
+        const double* number = (it != ctx.variables.end()) ? std::get_if<double>(&it->second) : nullptr;
+        if (!number) return std::nullopt;
+        scalars.push_back(*number);
+    }
+
+    if (!bars) return std::nullopt;
+
+    std::vector<uint8_t> out(*bars);
+    fn(series.data(), scalars.data(), out.size(), out.data());
+    return AnyValue{std::vector<bool>(out.begin(), out.end())};
+}
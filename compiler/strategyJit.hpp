@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "node/Node.hpp"
+
+// ====================================================== //
+//                  Strategy JIT (optional)
+// - Turns a typed Entry/Exit condition (see semanticPass)
+//   into one fused per-bar C++ loop, builds it with the
+//   local toolchain and loads it with dlopen
+// - Indicator series and nested calls are inputs, parameters
+//   are passed as scalars: one object serves a whole sweep
+// - Objects are cached on disk by FNV-1a of the generated
+//   source + compiler + flags, the source is kept next to
+//   the object and compared on load
+// - The cache is per user (0700): a directory or file owned
+//   by someone else, or writable by group / others, is never
+//   loaded, the generated source is predictable
+// - Anything it cannot take (untyped nodes, unequal series
+//   lengths, toolchain failure) returns nullopt and the
+//   Visitor runs instead, it stays the reference
+// ====================================================== //
+
+#define JIT_ABI_VERSION 1
+#define JIT_CXX_FLAGS "-O2 -std=c++17 -shared -fPIC -ffp-contract=off"
+#define JIT_MAX_LAG 1e9
+
+// ==== out[i] = condition on bar i, series[k] / scalars[k] follow the program's input order ==== //
+using jitSignalFn = void (*)(const double* const* series, const double* scalars, size_t n, uint8_t* out);
+
+struct jitOptions {
+    // ==== Empty -> $OCTURN_JIT_CACHE, else $XDG_CACHE_HOME/octurn-jit, else ~/.cache/octurn-jit ==== //
+    std::filesystem::path cacheDir;
+    // ==== Empty -> $OCTURN_JIT_CXX, else c++ ==== //
+    std::string compiler;
+    // ==== Also run the Visitor and throw when results differ ==== //
+    bool verify = false;
+};
+
+class strategyJit {
+    public:
+        explicit strategyJit(jitOptions options = {});
+        ~strategyJit();
+
+        strategyJit(const strategyJit&) = delete;
+        strategyJit& operator=(const strategyJit&) = delete;
+
+        std::optional<AnyValue> evaluate(const ASTNode& condition, ExecutionContext& ctx);
+
+        const jitOptions& options() const;
+        size_t compiled() const;
+        size_t loadedFromDisk() const;
+
+    private:
+        struct program {
+            std::string expression;
+            std::vector<const ASTNode*> series;
+            std::vector<std::string> scalars;
+            std::string source;
+            uint64_t hash = 0;
+        };
+
+        jitOptions options_;
+        mutable std::mutex mutex_;
+        // ==== nullptr = failed once, not retried ==== //
+        std::unordered_map<uint64_t, jitSignalFn> kernels_;
+        std::vector<void*> handles_;
+        size_t compiled_ = 0;
+        size_t loadedFromDisk_ = 0;
+        // ==== false -> the cache directory failed the ownership check, every kernel falls back ==== //
+        bool cacheTrusted_ = false;
+
+        // ==== lag: bars every series read below this node looks back (lags, crosses' previous bar) ==== //
+        bool emit(const ASTNode& node, program& prog, std::string& out, size_t lag = 0) const;
+        jitSignalFn kernelFor(const program& prog);
+        jitSignalFn open(const std::filesystem::path& object, const std::string& source);
+        bool build(const std::filesystem::path& source, const std::filesystem::path& object) const;
+};
@@ -13,15 +13,24 @@
 class config {
     public:
 
-        double commissionBps;
-        double equity; 
-        double riskPerTrade;
-        double stopLossBps;
-        double spread;
-        double shortInitMargin;
+        double commissionBps = 0.0;
+        double equity = 0.0; 
+        double riskPerTrade = 0.0;
+        double stopLossBps = 0.0;
+        double takeProfitBps = 0.0;
+        double spread = 0.0;
+        double shortInitMargin = 1.0;
+        double longInitMargin = 1.0;    // < 1 -> longs borrow the rest of their notional
+        double periodsPerYear = 252.0;
 
-        Slippage slippageRegime;
-        SlippageParams slippage;
+        // ==== Annual financing rates in bps (<TICKER>_borrowRate column overrides borrow) ==== //
+        double borrowRateBps = 0.0;
+        double marginRateBps = 0.0;
+        double cashYieldBps = 0.0;
+
+        Slippage slippageRegime = Slippage::base;
+        ImpactModel impactModel = ImpactModel::squareRoot;
+        SlippageParams slippage{};
 
         config(std::unordered_map<std::string,AnyValue>* variables);
 
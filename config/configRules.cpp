@@ -29,6 +29,17 @@ std::unordered_map<std::string, Rule> cfgRules = {
             return true;
         }
     }},
+    { "impactModel", {
+        ValueType::String, false, "sqrt",
+        [](const AnyValue& v,config& cfg, std::string& err){
+            std::string model = std::get<std::string>(v);
+            if (!stringToImpactModel(model, cfg)){
+                err = "impactModel should be one of linear, sqrt, almgrenChriss, volScaled";
+                return false;
+            }
+            return true;
+        }
+    }},
     { "riskPerTrade", {
         ValueType::Double, true, std::nullopt,
         [](const AnyValue& v,config& cfg, std::string& err){
@@ -37,6 +48,7 @@ std::unordered_map<std::string, Rule> cfgRules = {
                 err = "riskPerTrade should be a positive value in the range of (0-100) %";
                 return false;
             }
+            cfg.riskPerTrade = riskPerTrade;
             return true;
         }    
     }},
@@ -48,7 +60,68 @@ std::unordered_map<std::string, Rule> cfgRules = {
                 err = "stopLossBps should be a positive value in the range of (0-100)";
                 return false;
             }
+            cfg.stopLossBps = stopLossBps;
             return true;
         }    
+    }},
+    { "takeProfitBps", {
+        ValueType::Double, false, AnyValue{0.0},
+        [](const AnyValue& v,config& cfg, std::string& err){
+            double takeProfitBps = std::get<double>(v);
+            if (takeProfitBps < 0){
+                err = "takeProfitBps should be >= 0 (0 disables the target)";
+                return false;
+            }
+            cfg.takeProfitBps = takeProfitBps;
+            return true;
+        }
+    }},
+    { "periodsPerYear", {
+        ValueType::Double, false, AnyValue{252.0},
+        [](const AnyValue& v,config& cfg, std::string& err){
+            double periodsPerYear = std::get<double>(v);
+            if (periodsPerYear <= 0){
+                err = "periodsPerYear must be > 0";
+                return false;
+            }
+            cfg.periodsPerYear = periodsPerYear;
+            return true;
+        }
+    }},
+    { "borrowRateBps", {
+        ValueType::Double, false, AnyValue{0.0},
+        [](const AnyValue& v,config& cfg, std::string& err){
+            double borrowRateBps = std::get<double>(v);
+            if (borrowRateBps < 0){
+                err = "borrowRateBps should be >= 0";
+                return false;
+            }
+            cfg.borrowRateBps = borrowRateBps;
+            return true;
+        }
+    }},
+    { "marginRateBps", {
+        ValueType::Double, false, AnyValue{0.0},
+        [](const AnyValue& v,config& cfg, std::string& err){
+            double marginRateBps = std::get<double>(v);
+            if (marginRateBps < 0){
+                err = "marginRateBps should be >= 0";
+                return false;
+            }
+            cfg.marginRateBps = marginRateBps;
+            return true;
+        }
+    }},
+    { "cashYieldBps", {
+        ValueType::Double, false, AnyValue{0.0},
+        [](const AnyValue& v,config& cfg, std::string& err){
+            double cashYieldBps = std::get<double>(v);
+            if (cashYieldBps < 0){
+                err = "cashYieldBps should be >= 0";
+                return false;
+            }
+            cfg.cashYieldBps = cashYieldBps;
+            return true;
+        }
     }}
 };
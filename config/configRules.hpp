@@ -11,4 +11,4 @@ struct Rule {
     std::function<bool(const AnyValue&,config& cfg,std::string&)> validate;
 };
 
-std::unordered_map<std::string, Rule> cfgRules;
+extern std::unordered_map<std::string, Rule> cfgRules;
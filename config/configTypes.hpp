@@ -10,10 +10,14 @@ using Octurn::AnyValue;
 
 enum class ValueType {Double,String};
 enum class Slippage {optimistic,base,pessimistic};
+enum class ImpactModel {linear,squareRoot,almgrenChriss,volScaled};
 
 struct SlippageParams {
     double maxParticipation;
-    double impactCoef;
+    double impactCoef;        // linear / sqrt / Almgren-Chriss temporary coefficient
+    double permanentCoef;     // Almgren-Chriss permanent coefficient
+    double volCoef;           // vol-scaled: bps of impact per bps of bar volatility
+    ImpactModel model = ImpactModel::squareRoot;
 };
 
-std::unordered_map<Slippage,std::unordered_map<std::string,double>> SlippageCfg;
\ No newline at end of file
+extern std::unordered_map<Slippage,std::unordered_map<std::string,double>> SlippageCfg;
\ No newline at end of file
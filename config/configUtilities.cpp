@@ -9,3 +9,18 @@ void stringToSlippage(const std::string& slippage, config& cfg) {
         cfg.slippageRegime = Slippage::pessimistic;
     }
 }
+
+bool stringToImpactModel(const std::string& model, config& cfg) {
+    if (model == "linear") {
+        cfg.impactModel = ImpactModel::linear;
+    } else if (model == "sqrt") {
+        cfg.impactModel = ImpactModel::squareRoot;
+    } else if (model == "almgrenChriss") {
+        cfg.impactModel = ImpactModel::almgrenChriss;
+    } else if (model == "volScaled") {
+        cfg.impactModel = ImpactModel::volScaled;
+    } else {
+        return false;
+    }
+    return true;
+}
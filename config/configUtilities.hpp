@@ -4,3 +4,4 @@
 class config;
 
 void stringToSlippage(const std::string& slippage, config& cfg);
+bool stringToImpactModel(const std::string& model, config& cfg);
@@ -1,3 +1,4 @@
+#include <format>
 #include <iostream>
 
 #include "config/configValidator.hpp"
@@ -22,8 +23,6 @@ void configValidator::requiredCfgParametersCheckThenBuild(std::unordered_map<std
         auto varIt = cfg.variables_->find(cfgTmpIt->first);
         if (cfgTmpIt->second.required == true && varIt == cfg.variables_->end()){
             std::runtime_error(std::format("Required config parameter \"{}\" is missing",cfgTmpIt->first));
-        } else if (cfgTmpIt->second.required == false && varIt == cfg.variables_->end()){
-            continue;
         } else build_config(cfgTmpIt,varIt,cfg);
     }
 }
@@ -31,7 +30,7 @@ void configValidator::requiredCfgParametersCheckThenBuild(std::unordered_map<std
 void configValidator::build_config(std::unordered_map<std::string, Rule>::iterator& cfgTmpIt,
                                 std::unordered_map<std::string, Octurn::AnyValue>::iterator& varIt, config& cfg){
     std::string error;
-    bool isPresentVar{(varIt == cfg.variables_->end())};
+    bool isPresentVar{(varIt != cfg.variables_->end())};
     bool validated {isPresentVar ? cfgTmpIt->second.validate(varIt->second,cfg,error): cfgTmpIt->second.validate(cfgTmpIt->second.defaultValue.value(),cfg,error)};
     if (!validated){
         std::runtime_error(std::format("Unable to build config, error occured: {}",error));
@@ -6,18 +6,24 @@ std::unordered_map<Slippage,std::unordered_map<std::string,double>> slippageTabl
     {Slippage::base,{
         {"max_participation",0.05},
         {"impact_coef",20.0},
+        {"permanent_coef",10.0},
+        {"vol_coef",0.5},
         {"slippage",2.0}
     }       
     },
     {Slippage::optimistic,{
         {"max_participation",0.10},
         {"impact_coef",10.0},
+        {"permanent_coef",5.0},
+        {"vol_coef",0.3},
         {"slippage",1.0}
     }
     },
     {Slippage::pessimistic,{
         {"max_participation",0.02},
         {"impact_coef",30.0},
+        {"permanent_coef",15.0},
+        {"vol_coef",1.0},
         {"slippage",4.0}
     }}
 };
\ No newline at end of file
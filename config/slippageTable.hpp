@@ -2,4 +2,4 @@
 #include <unordered_map>
 #include "config/configTypes.hpp"
 
-std::unordered_map<Slippage,std::unordered_map<std::string,double>> slippageTable;
\ No newline at end of file
+extern std::unordered_map<Slippage,std::unordered_map<std::string,double>> slippageTable;
\ No newline at end of file
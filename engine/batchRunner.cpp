@@ -0,0 +1,206 @@
+#include "batchRunner.hpp"
+
+#include <format>
+#include <fstream>
+#include <future>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include "lexer/Lexer.hpp"
+#include "parser/Parser.hpp"
+#include "interpreter/Interpreter.hpp"
+#include "marketDataView/DataLayer.hpp"
+#include "backtester/backtestRunner.hpp"
+#include "log/logHandler.hpp"
+#include "utils/timeIndex.hpp"
+
+batchRunner::batchRunner(std::string apiKey, size_t threads) : apiKey_(std::move(apiKey)), threads_(threads) {}
+
+void batchRunner::add(std::string name, std::string script){
+    jobs_.push_back({std::move(name), std::move(script)});
+}
+
+void batchRunner::addFile(const std::string& path){
+    std::ifstream file(path);
+    if (!file){
+        throw std::runtime_error(std::format("Could not open strategy file '{}'", path));
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    add(path, buffer.str());
+}
+
+void batchRunner::setJit(std::shared_ptr<strategyJit> jit){
+    jit_ = std::move(jit);
+}
+
+static const ASTList* dataBlock(const std::shared_ptr<const syntaxTree>& tree){
+    const ASTRoot* root = tree ? tree->root() : nullptr;
+    return root ? node_cast<ASTList>(root->data) : nullptr;
+}
+
+// ====================================================== //
+//                   Load data union
+// - One request per ticker: earliest from, latest to
+// - Scripts asking a ticker at another timespan/multiplier
+//   are failed instead of silently getting other bars
+// - Tickers are fetched in parallel, merged on this thread
+// ====================================================== //
+
+std::shared_ptr<const std::unordered_map<std::string, AnyValue>> batchRunner::loadUnion(
+    const std::vector<std::shared_ptr<const syntaxTree>>& roots, std::vector<batchOutcome>& outcomes, threadPool& pool) const {
+
+    std::map<std::string, dataRequest> merged;
+    for (size_t j = 0; j < roots.size(); j++){
+        if (!roots[j]) continue;
+
+        for (const auto& request : MarketDataView::requests(dataBlock(roots[j]))){
+            auto [it, inserted] = merged.try_emplace(request.ticker, request);
+            if (inserted) continue;
+
+            auto& known = it->second;
+            if (known.timespan != request.timespan || known.multiplier != request.multiplier){
+                outcomes[j].error = std::format("{} is already requested as {} x{} by another script",
+                    request.ticker, known.timespan, known.multiplier);
+                continue;
+            }
+            known.from = std::min(known.from, request.from);
+            known.to = std::max(known.to, request.to);
+        }
+    }
+
+    g_logger.report(std::format("[BATCH] Fetching {} tickers for {} scripts", merged.size(), roots.size()));
+
+    std::vector<std::future<std::unordered_map<std::string, AnyValue>>> pending;
+    pending.reserve(merged.size());
+
+    for (const auto& [ticker, request] : merged){
+        pending.push_back(pool.submit([this, request](){
+            MarketDataView loader(apiKey_);
+            loader.load(request);
+            return std::move(loader.data());
+        }));
+    }
+
+    auto data = std::make_shared<std::unordered_map<std::string, AnyValue>>();
+    for (auto& future : pending){
+        data->merge(future.get());
+    }
+
+    return data;
+}
+
+// ====================================================== //
+//                     Run one script
+// - Traded ticker = first entry of the script's data block
+// ====================================================== //
+
+void batchRunner::runJob(const std::shared_ptr<const syntaxTree>& root, const std::shared_ptr<const std::unordered_map<std::string, AnyValue>>& shared,
+                         batchOutcome& outcome) const {
+    const auto requests = MarketDataView::requests(dataBlock(root));
+    if (requests.empty()){
+        throw std::runtime_error("Script has no data block");
+    }
+    const auto& traded = requests.front();
+    outcome.ticker = traded.ticker;
+
+    Interpreter interpreter(root, MarketDataView(shared));
+    if (jit_) interpreter.set_jit(jit_);
+    interpreter.run();
+
+    auto& variables = interpreter.get_variables();
+    auto entries = std::get_if<std::vector<bool>>(&variables["Entry"]);
+    auto exits = std::get_if<std::vector<bool>>(&variables["Exit"]);
+    if (!entries || !exits){
+        throw std::runtime_error("Entry/Exit conditions did not evaluate to boolean series.");
+    }
+
+    // ==== Bars of this script's own range inside the widened union ==== //
+    const auto& stamps = std::get<Octurn::timeSeries>(shared->at(MarketDataView::makeField(traded.ticker, "timestamp")));
+    const auto [begin, end] = stampRange(stamps, dateToStamp(traded.from), dateToStamp(traded.to) + NS_PER_DAY);
+
+    config cfg = interpreter.get_config();
+    outcome.result = runBacktest(*shared, cfg, traded.ticker, *entries, *exits, begin, end);
+    outcome.ok = true;
+}
+
+std::vector<batchOutcome> batchRunner::run(){
+    std::vector<batchOutcome> outcomes(jobs_.size());
+    std::vector<std::shared_ptr<const syntaxTree>> roots(jobs_.size());
+
+    threadPool pool(threads_);
+
+    // ==== Parse, one arena-backed AST per script ==== //
+    {
+        std::vector<std::future<void>> pending;
+        pending.reserve(jobs_.size());
+        for (size_t j = 0; j < jobs_.size(); j++){
+            outcomes[j].name = jobs_[j].name;
+            pending.push_back(pool.submit([this, j, &roots](){
+                Lexer lexer(jobs_[j].script);
+                Parser parser(lexer.get_tokens());
+                roots[j] = parser.parse();
+            }));
+        }
+        for (size_t j = 0; j < pending.size(); j++){
+            try {
+                pending[j].get();
+            } catch (const std::exception& e){
+                roots[j] = nullptr;
+                outcomes[j].error = std::format("Parsing failed: {}", e.what());
+            }
+        }
+    }
+
+    const auto shared = loadUnion(roots, outcomes, pool);
+
+    // ==== Evaluate + backtest, the shared map is never written from here on ==== //
+    std::vector<std::future<void>> pending(jobs_.size());
+    for (size_t j = 0; j < jobs_.size(); j++){
+        if (!roots[j] || !outcomes[j].error.empty()) continue;
+        pending[j] = pool.submit([this, j, &roots, &shared, &outcomes](){
+            runJob(roots[j], shared, outcomes[j]);
+        });
+    }
+
+    size_t failed{0};
+    for (size_t j = 0; j < pending.size(); j++){
+        if (pending[j].valid()){
+            try {
+                pending[j].get();
+            } catch (const std::exception& e){
+                outcomes[j].error = e.what();
+            }
+        }
+        failed += !outcomes[j].ok;
+    }
+
+    g_logger.report(std::format("[BATCH] {} scripts done, {} failed", outcomes.size(), failed));
+    return outcomes;
+}
+
+nlohmann::json batchReport(const std::vector<batchOutcome>& outcomes, bool withEquityCurves){
+    nlohmann::json report = nlohmann::json::array();
+
+    for (const auto& outcome : outcomes){
+        nlohmann::json entry{{"name", outcome.name}, {"ticker", outcome.ticker}, {"ok", outcome.ok}};
+        if (!outcome.ok){
+            entry["error"] = outcome.error;
+            report.push_back(std::move(entry));
+            continue;
+        }
+
+        auto metrics = outcome.result.metrics.toJson();
+        entry["summary"] = std::move(metrics["summary"]);
+        entry["trades"] = outcome.result.tradeCount();
+        entry["realizedPnL"] = outcome.result.realizedPnL;
+        entry["vectorized"] = outcome.result.vectorized;
+        if (withEquityCurves) entry["equityCurve"] = std::move(metrics["equityCurve"]);
+
+        report.push_back(std::move(entry));
+    }
+
+    return report;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "node/Node.hpp"
+#include "types/types.hpp"
+#include "backtester/backtestResult.hpp"
+#include "utils/threadPool.hpp"
+
+using Octurn::AnyValue;
+
+class strategyJit;
+
+// ==== One strategy script of the batch ==== //
+struct batchJob {
+    std::string name;
+    std::string script;
+};
+
+struct batchOutcome {
+    std::string name;
+    std::string ticker;
+    bool ok = false;
+    std::string error;
+    backtestResult result;
+};
+
+// ====================================================== //
+//                     Batch runner
+// - Parses every script, fetches the union of their 'data'
+//   blocks once (one request per ticker, widest date range)
+// - The loaded map is frozen and shared read-only, each script
+//   gets its own Interpreter over it on the thread pool
+// - A script only trades the bars of its own from/to range
+// ====================================================== //
+class batchRunner {
+    private:
+        std::string apiKey_;
+        size_t threads_;
+        std::vector<batchJob> jobs_;
+        std::shared_ptr<strategyJit> jit_;
+
+        std::shared_ptr<const std::unordered_map<std::string, AnyValue>> loadUnion(
+            const std::vector<std::shared_ptr<const syntaxTree>>& roots, std::vector<batchOutcome>& outcomes, threadPool& pool) const;
+        void runJob(const std::shared_ptr<const syntaxTree>& root, const std::shared_ptr<const std::unordered_map<std::string, AnyValue>>& shared,
+                    batchOutcome& outcome) const;
+
+    public:
+        // ==== threads = 0 -> one worker per hardware thread ==== //
+        explicit batchRunner(std::string apiKey, size_t threads = 0);
+
+        void add(std::string name, std::string script);
+        void addFile(const std::string& path);
+        // ==== Shared by every job: one kernel per distinct Entry/Exit, null -> Visitor only ==== //
+        void setJit(std::shared_ptr<strategyJit> jit);
+
+        std::vector<batchOutcome> run();
+};
+
+nlohmann::json batchReport(const std::vector<batchOutcome>& outcomes, bool withEquityCurves = false);
@@ -1,6 +1,6 @@
 #include "octurn.hpp"
 #include "utils/Utils.hpp"
-#include "marketDataView/MarketDataView.hpp"
+#include "marketDataView/DataLayer.hpp"
 
 engine::engine(std::string& api,std::string& script)
     : lexer_(script),
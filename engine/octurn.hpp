@@ -10,7 +10,7 @@ struct engine {
     Lexer lexer_;
     std::vector<Token> tokens_;
     Parser parser_;
-    std::shared_ptr<ASTNode> root_;
+    std::shared_ptr<const syntaxTree> root_;
     Interpreter interpreter_;
 
     engine(std::string& api,std::string& script);
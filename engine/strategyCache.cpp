@@ -0,0 +1,211 @@
+#include "strategyCache.hpp"
+
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <stdexcept>
+
+#include "lexer/Lexer.hpp"
+#include "parser/Parser.hpp"
+#include "log/logHandler.hpp"
+
+// ====================================================== //
+//                  Compile a strategy
+// - Lexer/Parser run once, the tree outlives both
+// - 'parameters' numbers become the bindable defaults
+// ====================================================== //
+
+std::shared_ptr<const compiledStrategy> compiledStrategy::compile(const std::string& script, uint64_t hash){
+    Lexer lexer(script);
+    Parser parser(lexer.get_tokens());
+
+    auto compiled = std::make_shared<compiledStrategy>();
+    compiled->tree = parser.parse();
+    compiled->hash = hash;
+
+    const ASTRoot* root = compiled->tree->root();
+    if (const auto* strategy = node_cast<Strategy>(root->strategy)){
+        compiled->name = strategy->name;
+
+        for (const ASTNode* block : strategy->blocks){
+            const auto* params = node_cast<ASTBlock>(block);
+            if (!params || params->block_type != Tokentype::Parameters) continue;
+
+            for (const auto& [key, node] : params->entries){
+                const auto* value = node_cast<ASTValueNode>(node);
+                if (!value) continue;
+                if (const auto* number = std::get_if<double>(&value->value)) compiled->parameters[key] = *number;
+            }
+        }
+    }
+
+    compiled->data = MarketDataView::requests(node_cast<ASTList>(root->data));
+    compiled->image = strategyImage::build(*compiled->tree);
+    return compiled;
+}
+
+std::unordered_map<std::string, double> compiledStrategy::bind(const std::unordered_map<std::string, double>& overrides) const {
+    auto bound = parameters;
+    for (const auto& [key, value] : overrides){
+        auto it = bound.find(key);
+        if (it == bound.end()){
+            throw std::runtime_error(std::format("Unknown parameter '{}' for strategy {}", key, name));
+        }
+        it->second = value;
+    }
+    return bound;
+}
+
+// ====================================================== //
+//                    Cache keys
+// ====================================================== //
+
+// ==== The DSL has no string literals, any whitespace run is one separator ==== //
+std::string strategyCache::normalize(std::string_view script){
+    std::string out;
+    out.reserve(script.size());
+
+    bool pendingSpace = false;
+    for (const char c : script){
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r'){
+            pendingSpace = !out.empty();
+            continue;
+        }
+        if (pendingSpace) out.push_back(' ');
+        pendingSpace = false;
+        out.push_back(c);
+    }
+    return out;
+}
+
+// ==== FNV-1a 64 ==== //
+uint64_t strategyCache::hashOf(std::string_view normalized){
+    uint64_t hash = 1469598103934665603ull;
+    for (const char c : normalized){
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// ====================================================== //
+//                        Cache
+// ====================================================== //
+
+strategyCache::strategyCache(size_t capacity) : perShard_(std::max<size_t>(1, (capacity + SHARDS - 1) / SHARDS)) {}
+
+strategyCache::shard& strategyCache::shardOf(uint64_t hash){
+    return shards_[(hash >> 32) % SHARDS];
+}
+
+std::list<strategyCache::entry>::iterator strategyCache::find(shard& s, uint64_t hash, const std::string& normalized){
+    auto [first, last] = s.index.equal_range(hash);
+    for (auto it = first; it != last; ++it){
+        if (it->second->normalized == normalized) return it->second;
+    }
+    return s.lru.end();
+}
+
+void strategyCache::erase(shard& s, std::list<entry>::iterator it){
+    auto [first, last] = s.index.equal_range(it->hash);
+    for (auto idx = first; idx != last; ++idx){
+        if (idx->second == it){
+            s.index.erase(idx);
+            break;
+        }
+    }
+    s.lru.erase(it);
+}
+
+strategyCache::compiledPtr strategyCache::get(const std::string& script, bool* hit){
+    std::string normalized = normalize(script);
+    const uint64_t hash = hashOf(normalized);
+    auto& s = shardOf(hash);
+
+    std::promise<compiledPtr> promise;
+    std::shared_future<compiledPtr> compiled;
+    bool owner = false;
+    uint64_t ticket{0};
+
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto it = find(s, hash, normalized);
+        if (it != s.lru.end()){
+            s.lru.splice(s.lru.begin(), s.lru, it);
+            s.hits++;
+            compiled = it->compiled;
+        } else {
+            s.misses++;
+            compiled = promise.get_future().share();
+            ticket = ++s.tickets;
+            s.lru.push_front({hash, ticket, std::move(normalized), compiled});
+            s.index.emplace(hash, s.lru.begin());
+            while (s.lru.size() > perShard_) erase(s, std::prev(s.lru.end()));
+            owner = true;
+        }
+    }
+
+    // ==== Compile outside the lock, waiters block on the shared future only ==== //
+    if (owner){
+        compiledPtr result;
+        try {
+            result = compiledStrategy::compile(script, hash);
+        } catch (...) {
+            promise.set_exception(std::current_exception());
+
+            // ==== Drop our entry unless it was already evicted ==== //
+            std::lock_guard<std::mutex> lock(s.mutex);
+            auto [first, last] = s.index.equal_range(hash);
+            for (auto idx = first; idx != last; ++idx){
+                if (idx->second->ticket == ticket){
+                    erase(s, idx->second);
+                    break;
+                }
+            }
+        }
+
+        // ==== Outside the try: a throw after set_value must not reach set_exception ==== //
+        if (result){
+            promise.set_value(std::move(result));
+            g_logger.report(std::format("[CACHE] Compiled strategy {:016x}", hash));
+        }
+    }
+
+    if (hit) *hit = !owner;
+    return compiled.get();
+}
+
+size_t strategyCache::size() const {
+    size_t total{0};
+    for (const auto& s : shards_){
+        std::lock_guard<std::mutex> lock(s.mutex);
+        total += s.lru.size();
+    }
+    return total;
+}
+
+uint64_t strategyCache::hits() const {
+    uint64_t total{0};
+    for (const auto& s : shards_){
+        std::lock_guard<std::mutex> lock(s.mutex);
+        total += s.hits;
+    }
+    return total;
+}
+
+uint64_t strategyCache::misses() const {
+    uint64_t total{0};
+    for (const auto& s : shards_){
+        std::lock_guard<std::mutex> lock(s.mutex);
+        total += s.misses;
+    }
+    return total;
+}
+
+void strategyCache::clear(){
+    for (auto& s : shards_){
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.index.clear();
+        s.lru.clear();
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "node/Node.hpp"
+#include "marketDataView/DataLayer.hpp"
+#include "compiler/strategyImage.hpp"
+
+// ====================================================== //
+//                  Compiled strategy
+// - Lexed + parsed once, immutable afterwards
+// - Parameter defaults and data requirements are resolved
+//   at compile time, overrides are bound per request
+// - image: serialized form for queue transport, built once
+// ====================================================== //
+struct compiledStrategy {
+    std::shared_ptr<const syntaxTree> tree;
+    std::string name;
+    std::unordered_map<std::string, double> parameters;
+    std::vector<dataRequest> data;
+    std::vector<char> image;
+    uint64_t hash = 0;
+
+    static std::shared_ptr<const compiledStrategy> compile(const std::string& script, uint64_t hash = 0);
+
+    // ==== Only declared parameters may be overridden, the result feeds Interpreter::set_parameter_overrides ==== //
+    std::unordered_map<std::string, double> bind(const std::unordered_map<std::string, double>& overrides) const;
+};
+
+// ====================================================== //
+//                   Strategy cache
+// - Key: FNV-1a 64 of the script with whitespace runs
+//   collapsed, the normalized text is kept to rule out
+//   hash collisions
+// - Sharded LRU, one mutex per shard, bounded in entries
+// - Concurrent misses on the same script compile it once,
+//   the others wait on the same shared future
+// - Failed compilations are not cached
+// ====================================================== //
+class strategyCache {
+    public:
+        using compiledPtr = std::shared_ptr<const compiledStrategy>;
+
+        // ==== capacity = total entries over all shards ==== //
+        explicit strategyCache(size_t capacity = 256);
+
+        strategyCache(const strategyCache&) = delete;
+        strategyCache& operator=(const strategyCache&) = delete;
+
+        // ==== hit -> set to true when no compilation happened for this call ==== //
+        compiledPtr get(const std::string& script, bool* hit = nullptr);
+
+        static std::string normalize(std::string_view script);
+        static uint64_t hashOf(std::string_view normalized);
+
+        size_t size() const;
+        uint64_t hits() const;
+        uint64_t misses() const;
+        void clear();
+
+    private:
+        static constexpr size_t SHARDS = 16;
+
+        struct entry {
+            uint64_t hash;
+            uint64_t ticket;
+            std::string normalized;
+            std::shared_future<compiledPtr> compiled;
+        };
+
+        struct shard {
+            mutable std::mutex mutex;
+            std::list<entry> lru;
+            std::unordered_multimap<uint64_t, std::list<entry>::iterator> index;
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t tickets = 0;
+        };
+
+        size_t perShard_;
+        shard shards_[SHARDS];
+
+        shard& shardOf(uint64_t hash);
+        std::list<entry>::iterator find(shard& s, uint64_t hash, const std::string& normalized);
+        void erase(shard& s, std::list<entry>::iterator it);
+};
@@ -1,4 +1,4 @@
-#include "ExecutionEngine.hpp"
+#include "executionEngine.hpp"
 
 #include <cmath>
 #include <format>
@@ -6,9 +6,12 @@
 #include <algorithm>
 
 #include "config/slippageTable.hpp"
+#include "execution/impactModels.hpp"
+#include "marketDataView/DataLayer.hpp"
+#include "snapshot/snapshot.hpp"
 
-ExecutionEngine::ExecutionEngine(std::unordered_map<std::string, AnyValue>& data, config& cfg,account& account)
-    : data_(data), cfg_(cfg), account_(account) {
+ExecutionEngine::ExecutionEngine(const std::unordered_map<std::string, AnyValue>& data, config& cfg,account& account)
+    : data_(data), cfg_(cfg), account_(account), orders_(data, cfg) {
         cfg_.slippage = getSlippageParams(cfg_,slippageTable);
     }
 
@@ -25,6 +28,16 @@ double ExecutionEngine::getValue(const std::string& key, size_t idx){
     return series[idx];
 }
 
+Bar ExecutionEngine::getBar(const std::string& ticker, size_t idx){
+    return {
+        .open   = getValue(MarketDataView::makeField(ticker, "open"), idx),
+        .high   = getValue(MarketDataView::makeField(ticker, "high"), idx),
+        .low    = getValue(MarketDataView::makeField(ticker, "low"), idx),
+        .close  = getValue(MarketDataView::makeField(ticker, "close"), idx),
+        .volume = getValue(MarketDataView::makeField(ticker, "volume"), idx)
+    };
+}
+
 double ExecutionEngine::bpsToFrac(double bps) const {
     return bps / 10000.0;
 }
@@ -38,10 +51,14 @@ SlippageParams ExecutionEngine::getSlippageParams(const config& cfg,
         throw std::runtime_error("Unknown slippageRegime");
     }
 
-    return {
+    SlippageParams params{
         it->second.at("max_participation"),
-        it->second.at("impact_coef")
+        it->second.at("impact_coef"),
+        it->second.at("permanent_coef"),
+        it->second.at("vol_coef")
     };
+    params.model = cfg.impactModel;
+    return params;
 }
 
 void ExecutionEngine::fillPosition(trade& trade){
@@ -80,6 +97,14 @@ double ExecutionEngine::getAdjPrice(trade& trade,double const & open,double cons
     return price;
 }
 
+// ==== Exit trades the opposite side: long positions sell into the bid ==== //
+double ExecutionEngine::getExitPrice(const trade& trade, double const& open, double const& impactBps) const {
+    if (trade.type == ordertype::Buy){
+        return open*(1.0 - bpsToFrac(cfg_.spread) - bpsToFrac(impactBps));
+    }
+    return open*(1.0 + bpsToFrac(cfg_.spread) + bpsToFrac(impactBps));
+}
+
 void ExecutionEngine::stopLoss(trade& trade, double entryPrice) {
     const double bps = bpsToFrac(cfg_.stopLossBps);
 
@@ -90,21 +115,30 @@ void ExecutionEngine::stopLoss(trade& trade, double entryPrice) {
     }
 }
 
-double ExecutionEngine::calcImpactBps(double qty, double volume) const {
-    if (volume <= 0.0 || qty <= 0.0) {
-        return 0.0;
-    }
+void ExecutionEngine::takeProfit(trade& trade, double entryPrice) {
+    const double bps = bpsToFrac(cfg_.takeProfitBps);
 
-    const double participation = std::min(qty / volume, cfg_.slippage.maxParticipation);
+    if (bps <= 0.0) {
+        trade.price.takeProfitPrice = 0.0;
+    } else if (trade.type == ordertype::Buy) {
+        trade.price.takeProfitPrice = entryPrice * (1.0 + bps);
+    } else {
+        trade.price.takeProfitPrice = entryPrice * (1.0 - bps);
+    }
+}
 
-    return cfg_.slippage.impactCoef * std::sqrt(participation);
+double ExecutionEngine::calcImpactBps(double qty, const Bar& bar) const {
+    const impactInputs inputs{qty, bar.volume, bar.high, bar.low};
+    return withImpactModel(cfg_.slippage.model, [&](auto model){
+        return decltype(model)::bps(cfg_.slippage, inputs);
+    });
 }
 
 void ExecutionEngine::applyCashEffect(trade& trade, double qty, double price){
     double cashCostMultiplier = (1+bpsToFrac(cfg_.commissionBps));
     double positionCost{0};
     if (trade.type == ordertype::Buy) {
-        positionCost = qty * price * cashCostMultiplier;
+        positionCost = qty * price * cfg_.longInitMargin * cashCostMultiplier;
     } else {
         positionCost = qty * price * cfg_.shortInitMargin * cashCostMultiplier;
     }
@@ -121,7 +155,7 @@ double ExecutionEngine::calcQtyCash(const trade& trade, double price) const {
     }
 
     if (trade.type == ordertype::Buy) {
-        return account_.availableFreeCash() / (price * cashCostMultiplier);
+        return account_.availableFreeCash() / (price * cfg_.longInitMargin * cashCostMultiplier);
     } 
     
     return account_.availableFreeCash() / (price * cfg_.shortInitMargin * cashCostMultiplier);
@@ -140,7 +174,7 @@ bool ExecutionEngine::FOK(trade& trade) {
     }
 
     const double qtyLiq = cfg_.slippage.maxParticipation * bar.volume;
-    const double impactBps = calcImpactBps(needQty, bar.volume);
+    const double impactBps = calcImpactBps(needQty, bar);
     const double price = getAdjPrice(trade, bar.open, impactBps);
     const double qtyCash = calcQtyCash(trade,price);
 
@@ -152,12 +186,14 @@ bool ExecutionEngine::FOK(trade& trade) {
     }
 
     trade.qty.filledQty = needQty;
+    trade.qty.filledNotional = needQty * price;
     trade.price.avgPrice = price;
 
     trade.status = tradeStatus::CLOSED;
     applyCashEffect(trade,needQty,price);
 
     stopLoss(trade, price);
+    takeProfit(trade, price);
     trade.executionPrice.push_back({price, needQty});
 
     return true;
@@ -179,7 +215,7 @@ void ExecutionEngine::executeGTCBar(trade& trade,size_t idx){
     double qty = std::min(qtyLiq, trade.qty.remainingQty());
     if (qty <= 0.0) return;
 
-    double price = getAdjPrice(trade, bar.open, calcImpactBps(qty, bar.volume));
+    double price = getAdjPrice(trade, bar.open, calcImpactBps(qty, bar));
     double qtyCash = calcQtyCash(trade, price);
 
     bool canFillByCash = (qtyCash >= qty);
@@ -193,10 +229,12 @@ void ExecutionEngine::executeGTCBar(trade& trade,size_t idx){
     if (qty <= 0.0) return;
 
     trade.qty.filledQty += qty;
+    trade.qty.filledNotional += price * qty;
     trade.executionPrice.push_back({price,qty});
 
     averageExecutionPrice(trade);
     stopLoss(trade, trade.price.avgPrice);
+    takeProfit(trade, trade.price.avgPrice);
     applyCashEffect(trade,qty,price);
 
     if (trade.qty.remainingQty() <= 0){
@@ -204,20 +242,92 @@ void ExecutionEngine::executeGTCBar(trade& trade,size_t idx){
     }
 }
 
+// ==== Running notional / qty, no rescan of executionPrice ==== //
 void ExecutionEngine::averageExecutionPrice(trade& trade) const {
-    const auto& fills = trade.executionPrice;
+    if (trade.qty.filledQty <= 0) {
+        throw std::runtime_error("division by zero, filled qty is null");
+    }
 
-    double totalQty{0};
-    double totalNotional{0};
+    trade.price.avgPrice = trade.qty.filledNotional/trade.qty.filledQty;
+}
 
-    for (const auto& fill : fills){
-        totalNotional += fill.price * fill.qty;
-        totalQty += fill.qty;
-    }
+uint32_t ExecutionEngine::addTicker(const std::string& ticker){
+    const uint32_t id = orders_.addTicker(ticker);
+    ledger_.addTicker(ticker);
+    return id;
+}
 
-    if (totalQty <= 0) {
-        throw std::runtime_error("division by zero, filled qty is null");
+// ====================================================== //
+//                  Order book fill -> account
+// - Opening qty posts margin (longInitMargin for longs,
+//   shortInitMargin for shorts) out of free cash
+// - Closing qty releases it at the average cost, the PnL
+//   realized by the ledger (net of commission) is booked
+// ====================================================== //
+
+void ExecutionEngine::settleFill(const orderFill& fill){
+    const bool buy = fill.side == ordertype::Buy;
+    const ledgerPosition before = ledger_.position(fill.tickerId);
+    const double pnl = ledger_.onFill(fill);
+
+    const bool reducing = before.netQty != 0.0 && (before.netQty > 0.0) != buy;
+    const double closed = reducing ? std::min(fill.qty, std::abs(before.netQty)) : 0.0;
+    const double released = closed * before.avgCost * (before.netQty > 0.0 ? cfg_.longInitMargin : cfg_.shortInitMargin);
+    const double posted = (fill.qty - closed) * fill.price * (buy ? cfg_.longInitMargin : cfg_.shortInitMargin);
+
+    account_.updateReservedMargin(posted - released);
+    account_.updateFreeCash(released - posted);
+    account_.realizeTradePnL(pnl);
+}
+
+// ====================================================== //
+//                  Open / Close position
+// - openPosition: sizes the order then tries a FOK fill
+//   at the entry bar open, false if liquidity/cash refuse it
+// - closePosition: exits the whole filled qty at bar open,
+//   releases margin and realizes PnL net of commission
+// - closePositionAt: same exit around a stop / target level
+// ====================================================== //
+
+bool ExecutionEngine::openPosition(trade& trade){
+    initOrder(trade);
+    return FOK(trade);
+}
+
+double ExecutionEngine::closePosition(trade& trade, size_t idx){
+    return closePositionAt(trade, idx, getBar(trade.ticker, idx).open);
+}
+
+double ExecutionEngine::closePositionAt(trade& trade, size_t idx, double refPrice){
+    const Bar bar = getBar(trade.ticker, idx);
+    const double qty = trade.qty.filledQty;
+
+    if (qty <= 0.0) {
+        return 0.0;
     }
 
-    trade.price.avgPrice = totalNotional/totalQty;
+    const double price = getExitPrice(trade, refPrice, calcImpactBps(qty, bar));
+    const double commission = qty * price * bpsToFrac(cfg_.commissionBps);
+    const double pnl = account_.markToMarket(price, trade.price.avgPrice, qty, trade.type) - commission;
+
+    account_.updateReservedMargin(-trade.usedMargin);
+    account_.updateFreeCash(trade.usedMargin);
+    account_.realizeTradePnL(pnl);
+
+    trade.usedMargin = 0.0;
+    trade.price.exitPrice = price;
+    trade.realizedPnL = pnl;
+    trade.changeTradeStatusToClosed();
+
+    return pnl;
+}
+
+void ExecutionEngine::save(snapshotWriter& out) const {
+    orders_.save(out);
+    ledger_.save(out);
+}
+
+void ExecutionEngine::load(snapshotReader& in){
+    orders_.load(in);
+    ledger_.load(in);
 }
@@ -7,33 +7,72 @@
 #include "trade/trade.hpp"
 #include "types/types.hpp"
 #include "account/account.hpp"
+#include "execution/orderBook.hpp"
+#include "trade/positionLedger.hpp"
 
 using Octurn::AnyValue;
 
 class ExecutionEngine {
 private:
-    std::unordered_map<std::string, AnyValue>& data_;
+    const std::unordered_map<std::string, AnyValue>& data_;
     config& cfg_;
     account& account_;
+    orderBook orders_;
+    positionLedger ledger_;
 
     double bpsToFrac(double bps) const;
-    SlippageParams getSlippageParams(const config& cfg,
-        const std::unordered_map<Slippage,std::unordered_map<std::string,double>>& slippageTable);
     double getAdjPrice(trade& trade,double const & open,double const& impactBps);
 
     bool FOK(trade& trade);
     void stopLoss(trade& trade,double open);
+    void takeProfit(trade& trade, double entryPrice);
     void averageExecutionPrice(trade& trade) const;
     Bar getBar(const std::string& ticker, size_t idx);
-    double calcImpactBps(double qty, double volume) const;
+    double calcImpactBps(double qty, const Bar& bar) const;
     double calcQtyCash(const trade& trade, double price) const;
     void applyCashEffect(trade& trade, double qty, double price);
+    double getExitPrice(const trade& trade, double const& open, double const& impactBps) const;
 
 public:
-    ExecutionEngine(std::unordered_map<std::string, AnyValue>& data, config& cfg, account& account);
+    ExecutionEngine(const std::unordered_map<std::string, AnyValue>& data, config& cfg, account& account);
+
+    static SlippageParams getSlippageParams(const config& cfg,
+        const std::unordered_map<Slippage,std::unordered_map<std::string,double>>& slippageTable);
 
     void initOrder(trade& trade);
     void executeGTCBar(trade& trade, size_t idx);
     void fillPosition(trade& trade);
     double getValue(const std::string& key, size_t idx);
+
+    // ==== Position lifecycle used by backtest loops ==== //
+    bool openPosition(trade& trade);
+    double closePosition(trade& trade, size_t idx);
+    // ==== Intrabar exit (stop / target) around refPrice instead of the open ==== //
+    double closePositionAt(trade& trade, size_t idx, double refPrice);
+
+    // ==== Pending limit / stop / trailing / TWAP / VWAP orders, processed per bar ==== //
+    orderBook& orders() { return orders_; }
+    const positionLedger& ledger() const { return ledger_; }
+
+    // ==== Same id in the order book and the ledger ==== //
+    uint32_t addTicker(const std::string& ticker);
+
+    // ==== Ledger, then margin / cash / realized PnL like openPosition and closePositionAt ==== //
+    void settleFill(const orderFill& fill);
+
+    // ==== beforeSettle() runs once when the bar has fills, before any cash moves ==== //
+    template <typename BeforeSettle>
+    const std::vector<orderFill>& processOrders(uint32_t tickerId, size_t idx, BeforeSettle&& beforeSettle){
+        const auto& fills = orders_.processBar(tickerId, idx);
+        if (!fills.empty()) beforeSettle();
+        for (const auto& fill : fills) settleFill(fill);
+        return fills;
+    }
+    const std::vector<orderFill>& processOrders(uint32_t tickerId, size_t idx){
+        return processOrders(tickerId, idx, []{});
+    }
+
+    // ==== Execution state: pending book orders and the ledger ==== //
+    void save(snapshotWriter& out) const;
+    void load(snapshotReader& in);
 };
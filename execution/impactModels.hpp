@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "config/configTypes.hpp"
+
+// ====================================================== //
+//                Market impact policies
+// - Stateless structs with one static bps() -> selected once
+//   per run, then fully inlined into the fill path
+// - participation = qty / bar volume, capped by maxParticipation
+// - Bar volatility for volScaled = Parkinson estimate from
+//   the bar range: ln(high / low) / (2 sqrt(ln 2))
+// ====================================================== //
+
+struct impactInputs {
+    double qty;
+    double volume;
+    double high;
+    double low;
+};
+
+inline double participationRate(const SlippageParams& params, const impactInputs& in) {
+    if (in.volume <= 0.0 || in.qty <= 0.0) {
+        return 0.0;
+    }
+    return std::min(in.qty / in.volume, params.maxParticipation);
+}
+
+struct linearImpact {
+    static double bps(const SlippageParams& params, const impactInputs& in) {
+        return params.impactCoef * participationRate(params, in);
+    }
+};
+
+struct squareRootImpact {
+    static double bps(const SlippageParams& params, const impactInputs& in) {
+        return params.impactCoef * std::sqrt(participationRate(params, in));
+    }
+};
+
+// ==== Temporary (eta * rate) + half of the permanent shift (gamma * rate) paid by the order itself ==== //
+struct almgrenChrissImpact {
+    static double bps(const SlippageParams& params, const impactInputs& in) {
+        const double rate = participationRate(params, in);
+        return params.impactCoef * rate + 0.5 * params.permanentCoef * rate;
+    }
+};
+
+// ==== Y * sigma * sqrt(participation), sigma in bps ==== //
+struct volScaledImpact {
+    static double bps(const SlippageParams& params, const impactInputs& in) {
+        if (in.high <= 0.0 || in.low <= 0.0) {
+            return 0.0;
+        }
+        constexpr double parkinson = 1.6651092223153954;   // 2 * sqrt(ln 2)
+        const double sigmaBps = std::log(in.high / in.low) / parkinson * 10000.0;
+        return params.volCoef * sigmaBps * std::sqrt(participationRate(params, in));
+    }
+};
+
+// ==== Calls f(policy{}) for the configured model, the only branch of the path ==== //
+template <typename F>
+decltype(auto) withImpactModel(ImpactModel model, F&& f) {
+    switch (model) {
+        case ImpactModel::linear:        return f(linearImpact{});
+        case ImpactModel::squareRoot:    return f(squareRootImpact{});
+        case ImpactModel::almgrenChriss: return f(almgrenChrissImpact{});
+        case ImpactModel::volScaled:     return f(volScaledImpact{});
+    }
+    throw std::runtime_error("Unknown impact model");
+}
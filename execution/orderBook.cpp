@@ -0,0 +1,399 @@
+#include "orderBook.hpp"
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+#include "marketDataView/DataLayer.hpp"
+#include "execution/impactModels.hpp"
+#include "snapshot/snapshot.hpp"
+
+#define BPS_TO_FRAC(bps) ((bps) / 10000.0)
+
+orderBook::orderBook(const std::unordered_map<std::string, AnyValue>& data, const config& cfg)
+    : data_(data), cfg_(cfg) {}
+
+const std::vector<double>& orderBook::column(const std::string& ticker, const std::string& field) const {
+    const std::string key = MarketDataView::makeField(ticker, field);
+    auto it = data_.find(key);
+    if (it == data_.end()) throw std::runtime_error(std::format("Series {} not found", key));
+
+    const auto* series = std::get_if<std::vector<double>>(&it->second);
+    if (!series) throw std::runtime_error(std::format("Series {} is not numeric", key));
+
+    return *series;
+}
+
+// ==== Columns are resolved once, the per-bar path never touches the data map ==== //
+uint32_t orderBook::addTicker(const std::string& ticker){
+    tickerOrders book;
+    book.open = &column(ticker, "open");
+    book.high = &column(ticker, "high");
+    book.low = &column(ticker, "low");
+    book.close = &column(ticker, "close");
+    book.volume = &column(ticker, "volume");
+
+    tickers_.push_back(std::move(book));
+    return static_cast<uint32_t>(tickers_.size() - 1);
+}
+
+// ====================================================== //
+//                      Submission
+// - Order id = generation << 32 | slot, slots are recycled
+//   and stale heap / working list entries are skipped by generation
+// ====================================================== //
+
+uint64_t orderBook::submit(uint32_t tickerId, const order& request, size_t bar){
+    if (tickerId >= tickers_.size()) throw std::runtime_error(std::format("Unknown ticker id {}", tickerId));
+    if (request.qty <= 0.0) throw std::runtime_error("Order quantity must be positive");
+
+    auto& book = tickers_[tickerId];
+    if (bar >= book.open->size()) throw std::runtime_error(std::format("Order bar {} out of range", bar));
+
+    uint32_t slot;
+    if (!freeSlots_.empty()){
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+
+    auto& state = slots_[slot];
+    state.spec = request;
+    state.tickerId = tickerId;
+    state.remaining = request.qty;
+    state.slicesLeft = std::max<size_t>(request.slices, 1);
+    state.submitBar = bar;
+    state.triggeredAt = SIZE_MAX;
+    state.live = true;
+    book.live++;
+
+    switch (request.kind){
+        case orderKind::Market:
+        case orderKind::TWAP:
+            book.working.push_back(refOf(slot));
+            break;
+        case orderKind::VWAP: {
+            // ==== Expected bar volume = mean of the `slices` bars before submit, no lookahead ==== //
+            const size_t from = bar > state.slicesLeft ? bar - state.slicesLeft : 0;
+            double sum = 0.0;
+            for (size_t i = from; i < bar; i++) sum += (*book.volume)[i];
+            state.expectedVolume = bar > from ? sum / static_cast<double>(bar - from) : 0.0;
+            book.working.push_back(refOf(slot));
+            break;
+        }
+        case orderKind::Limit:
+            pushLevel(slot, request.limitPrice, false);
+            break;
+        case orderKind::Stop:
+        case orderKind::StopLimit:
+            pushLevel(slot, request.stopPrice, true);
+            break;
+        case orderKind::TrailingStop:
+            if (request.trailBps <= 0.0) throw std::runtime_error("Trailing stop needs trailBps > 0");
+            state.peak = request.stopPrice > 0.0 ? request.stopPrice
+                       : (bar > 0 ? (*book.close)[bar - 1] : (*book.open)[bar]);
+            book.trailing.push_back(refOf(slot));
+            break;
+    }
+
+    return (static_cast<uint64_t>(state.generation) << 32) | slot;
+}
+
+bool orderBook::cancel(uint64_t orderId){
+    const auto slot = static_cast<uint32_t>(orderId & 0xffffffffu);
+    const auto generation = static_cast<uint32_t>(orderId >> 32);
+    if (slot >= slots_.size() || !slots_[slot].live || slots_[slot].generation != generation) return false;
+
+    // ==== Heap and list entries die lazily: their generation no longer matches the slot ==== //
+    release(slot);
+    return true;
+}
+
+size_t orderBook::pending(uint32_t tickerId) const {
+    return tickerId < tickers_.size() ? tickers_[tickerId].live : 0;
+}
+
+void orderBook::release(uint32_t slot){
+    auto& state = slots_[slot];
+    state.live = false;
+    state.generation++;
+    tickers_[state.tickerId].live--;
+    freeSlots_.push_back(slot);
+}
+
+bool orderBook::isCurrent(uint32_t slot, uint32_t generation) const {
+    const auto& state = slots_[slot];
+    return state.live && state.generation == generation;
+}
+
+// ==== Buy limits / sell stops trigger from above the level, the others from below ==== //
+void orderBook::pushLevel(uint32_t slot, double level, bool stop){
+    auto& state = slots_[slot];
+    auto& book = tickers_[state.tickerId];
+    const levelEntry entry{level, slot, state.generation};
+    const bool buy = state.spec.side == ordertype::Buy;
+
+    if (stop) (buy ? (void)book.buyStops.push(entry) : (void)book.sellStops.push(entry));
+    else      (buy ? (void)book.buyLimits.push(entry) : (void)book.sellLimits.push(entry));
+}
+
+// ==== Triggered stop / trailing remainder keeps working as a market order ==== //
+void orderBook::toWorking(uint32_t slot, orderKind kind){
+    slots_[slot].spec.kind = kind;
+    tickers_[slots_[slot].tickerId].working.push_back(refOf(slot));
+}
+
+// ====================================================== //
+//                         Fill
+// - Capped by what is left of this bar's participation room
+// - Aggressive fills pay spread + configured impact,
+//   resting limit fills trade at their reference price
+// ====================================================== //
+
+double orderBook::fill(uint32_t slot, size_t bar, double qty, double refPrice, bool aggressive){
+    auto& state = slots_[slot];
+    const auto& book = tickers_[state.tickerId];
+
+    qty = std::min({qty, state.remaining, barRoom_});
+    if (qty <= 0.0) return 0.0;
+
+    double price = refPrice;
+    if (aggressive){
+        const double impactBps = withImpactModel(cfg_.slippage.model, [&](auto model){
+            return decltype(model)::bps(cfg_.slippage, {qty, (*book.volume)[bar], (*book.high)[bar], (*book.low)[bar]});
+        });
+        const double cost = BPS_TO_FRAC(cfg_.spread) + BPS_TO_FRAC(impactBps);
+        price = state.spec.side == ordertype::Buy ? refPrice * (1.0 + cost) : refPrice * (1.0 - cost);
+    }
+
+    const uint64_t id = (static_cast<uint64_t>(state.generation) << 32) | slot;
+    fills_.push_back({id, state.tickerId, state.spec.side, bar, qty, price, qty * price * BPS_TO_FRAC(cfg_.commissionBps)});
+
+    barRoom_ -= qty;
+    state.remaining -= qty;
+    if (state.remaining <= 0.0) release(slot);
+    return qty;
+}
+
+// ====================================================== //
+//                     Process one bar
+// - Working orders first (they were due at the open),
+//   then stops, limits (incl. stop-limits armed this bar),
+//   then trailing stops
+// - Heap work is O(triggered * log pending)
+// ====================================================== //
+
+const std::vector<orderFill>& orderBook::processBar(uint32_t tickerId, size_t bar){
+    if (tickerId >= tickers_.size()) throw std::runtime_error(std::format("Unknown ticker id {}", tickerId));
+
+    auto& book = tickers_[tickerId];
+    if (bar >= book.open->size()) throw std::runtime_error(std::format("Order bar {} out of range", bar));
+
+    fills_.clear();
+    if (book.live == 0) return fills_;
+
+    barRoom_ = cfg_.slippage.maxParticipation * (*book.volume)[bar];
+
+    runWorking(book, bar);
+    runStops(book, bar);
+    runLimits(book, bar);
+    runTrailing(book, bar);
+
+    return fills_;
+}
+
+void orderBook::runWorking(tickerOrders& book, size_t bar){
+    const double open = (*book.open)[bar];
+    const double typical = ((*book.high)[bar] + (*book.low)[bar] + (*book.close)[bar]) / 3.0;
+    const double volume = (*book.volume)[bar];
+
+    size_t keep = 0;
+    for (size_t i = 0; i < book.working.size(); i++){
+        const slotRef ref = book.working[i];
+        if (!isCurrent(ref.slot, ref.generation)) continue;
+        if (!isDue(ref.slot, bar)){
+            book.working[keep++] = ref;
+            continue;
+        }
+
+        const uint32_t slot = ref.slot;
+        auto& state = slots_[slot];
+
+        switch (state.spec.kind){
+            case orderKind::Market:
+                fill(slot, bar, state.remaining, open, true);
+                break;
+            case orderKind::TWAP:
+            case orderKind::VWAP: {
+                double target = state.remaining / static_cast<double>(state.slicesLeft);
+                if (state.spec.kind == orderKind::VWAP && state.slicesLeft > 1){
+                    const double expected = volume + state.expectedVolume * static_cast<double>(state.slicesLeft - 1);
+                    target = expected > 0.0 ? state.remaining * volume / expected : target;
+                }
+                fill(slot, bar, target, typical, true);
+                // ==== Schedule over: what is left is swept as a market order ==== //
+                if (state.live && --state.slicesLeft == 0) state.spec.kind = orderKind::Market;
+                break;
+            }
+            default:
+                break;
+        }
+
+        if (state.live) book.working[keep++] = ref;
+    }
+
+    book.working.resize(keep);
+}
+
+void orderBook::runStops(tickerOrders& book, size_t bar){
+    const double open = (*book.open)[bar];
+
+    auto trigger = [&](const levelEntry& entry, double refPrice){
+        auto& state = slots_[entry.slot];
+        if (state.spec.kind == orderKind::StopLimit){
+            state.triggeredAt = bar;
+            pushLevel(entry.slot, state.spec.limitPrice, false);
+            return;
+        }
+        fill(entry.slot, bar, state.remaining, refPrice, true);
+        if (state.live) toWorking(entry.slot, orderKind::Market);
+    };
+
+    // ==== Orders not yet due go back on their heap after the sweep ==== //
+    deferred_.clear();
+    while (!book.buyStops.empty() && book.buyStops.top().level <= (*book.high)[bar]){
+        const auto entry = book.buyStops.top();
+        book.buyStops.pop();
+        if (!isCurrent(entry)) continue;
+        if (isDue(entry.slot, bar)) trigger(entry, std::max(open, entry.level));
+        else deferred_.push_back(entry);
+    }
+    for (const auto& entry : deferred_) book.buyStops.push(entry);
+
+    deferred_.clear();
+    while (!book.sellStops.empty() && book.sellStops.top().level >= (*book.low)[bar]){
+        const auto entry = book.sellStops.top();
+        book.sellStops.pop();
+        if (!isCurrent(entry)) continue;
+        if (isDue(entry.slot, bar)) trigger(entry, std::min(open, entry.level));
+        else deferred_.push_back(entry);
+    }
+    for (const auto& entry : deferred_) book.sellStops.push(entry);
+}
+
+void orderBook::runLimits(tickerOrders& book, size_t bar){
+    const double open = (*book.open)[bar];
+
+    // ==== Reference = open when it already beats the limit, else the limit; stop-limits armed this bar start from the stop ==== //
+    auto rest = [&](const levelEntry& entry, bool buy){
+        const auto& state = slots_[entry.slot];
+        if (!isDue(entry.slot, bar)) return;
+        const double from = (state.triggeredAt == bar) ? state.spec.stopPrice : open;
+        if (state.triggeredAt == bar && (buy ? from > entry.level : from < entry.level)) return;
+
+        const double refPrice = buy ? std::min(from, entry.level) : std::max(from, entry.level);
+        fill(entry.slot, bar, state.remaining, refPrice, false);
+    };
+
+    deferred_.clear();
+    while (!book.buyLimits.empty() && book.buyLimits.top().level >= (*book.low)[bar]){
+        const auto entry = book.buyLimits.top();
+        book.buyLimits.pop();
+        if (!isCurrent(entry)) continue;
+        rest(entry, true);
+        if (isCurrent(entry)) deferred_.push_back(entry);
+    }
+    for (const auto& entry : deferred_) book.buyLimits.push(entry);
+
+    deferred_.clear();
+    while (!book.sellLimits.empty() && book.sellLimits.top().level <= (*book.high)[bar]){
+        const auto entry = book.sellLimits.top();
+        book.sellLimits.pop();
+        if (!isCurrent(entry)) continue;
+        rest(entry, false);
+        if (isCurrent(entry)) deferred_.push_back(entry);
+    }
+    for (const auto& entry : deferred_) book.sellLimits.push(entry);
+}
+
+// ====================================================== //
+//                     Trailing stops
+// - Sell side trails the highest high, buy side the lowest low
+// - The level is checked with the extreme of previous bars,
+//   then updated with this bar (intrabar order is unknown)
+// ====================================================== //
+
+void orderBook::runTrailing(tickerOrders& book, size_t bar){
+    const double open = (*book.open)[bar];
+    const double high = (*book.high)[bar];
+    const double low = (*book.low)[bar];
+
+    size_t keep = 0;
+    for (size_t i = 0; i < book.trailing.size(); i++){
+        const slotRef ref = book.trailing[i];
+        if (!isCurrent(ref.slot, ref.generation)) continue;
+        if (!isDue(ref.slot, bar)){
+            book.trailing[keep++] = ref;
+            continue;
+        }
+
+        const uint32_t slot = ref.slot;
+        auto& state = slots_[slot];
+
+        const double trail = BPS_TO_FRAC(state.spec.trailBps);
+        const bool sell = state.spec.side == ordertype::Sell;
+        const double level = sell ? state.peak * (1.0 - trail) : state.peak * (1.0 + trail);
+
+        if (sell ? low <= level : high >= level){
+            fill(slot, bar, state.remaining, sell ? std::min(open, level) : std::max(open, level), true);
+            if (state.live) toWorking(slot, orderKind::Market);
+            continue;
+        }
+
+        state.peak = sell ? std::max(state.peak, high) : std::min(state.peak, low);
+        book.trailing[keep++] = ref;
+    }
+    book.trailing.resize(keep);
+}
+
+// ====================================================== //
+//                    Snapshot
+// - Slots (with their generations), the free list and
+//   every ticker's heaps / lists as laid out in memory
+// ====================================================== //
+
+void orderBook::save(snapshotWriter& out) const {
+    out.putVector(slots_);
+    out.putVector(freeSlots_);
+
+    out.put<uint64_t>(tickers_.size());
+    for (const auto& book : tickers_){
+        out.putVector(book.buyLimits.entries());
+        out.putVector(book.sellLimits.entries());
+        out.putVector(book.buyStops.entries());
+        out.putVector(book.sellStops.entries());
+        out.putVector(book.working);
+        out.putVector(book.trailing);
+        out.put<uint64_t>(book.live);
+    }
+}
+
+void orderBook::load(snapshotReader& in){
+    in.getVector(slots_);
+    in.getVector(freeSlots_);
+
+    if (in.get<uint64_t>() != tickers_.size()){
+        throw std::runtime_error("Order book snapshot has a different ticker count");
+    }
+    for (auto& book : tickers_){
+        in.getVector(book.buyLimits.entries());
+        in.getVector(book.sellLimits.entries());
+        in.getVector(book.buyStops.entries());
+        in.getVector(book.sellStops.entries());
+        in.getVector(book.working);
+        in.getVector(book.trailing);
+        book.live = in.get<uint64_t>();
+    }
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "config/config.hpp"
+#include "marketTypes/marketTypes.hpp"
+#include "types/types.hpp"
+
+using Octurn::AnyValue;
+
+class snapshotWriter;
+class snapshotReader;
+
+enum class orderKind {
+    Market, Limit, Stop, StopLimit, TrailingStop, TWAP, VWAP
+};
+
+// ====================================================== //
+//                     Order request
+// - Limit / Stop / StopLimit use limitPrice / stopPrice
+// - TrailingStop: trailBps from the best price since submit
+// - TWAP / VWAP: spread over `slices` bars
+// ====================================================== //
+struct order {
+    orderKind kind = orderKind::Market;
+    ordertype side = ordertype::Buy;
+    double qty = 0.0;
+    double limitPrice = 0.0;
+    double stopPrice = 0.0;
+    double trailBps = 0.0;
+    size_t slices = 1;
+};
+
+struct orderFill {
+    uint64_t orderId;
+    uint32_t tickerId;
+    ordertype side;
+    size_t bar;
+    double qty;
+    double price;
+    double commission;
+};
+
+// ====================================================== //
+//               Per-ticker pending order book
+// - Limits / stops wait in heaps keyed by their level: a bar
+//   only pops the orders its high/low reached
+// - Market remainders, TWAP/VWAP slices and trailing stops
+//   are live every bar and sit in small working lists
+// - Per bar and ticker, fills share maxParticipation * volume
+// - Orders submitted with `bar` are first processed at `bar`,
+//   an earlier processBar() leaves them untouched
+// ====================================================== //
+class orderBook {
+    private:
+        struct orderState {
+            order spec;
+            uint32_t tickerId = 0;
+            uint32_t generation = 0;
+            double remaining = 0.0;
+            double peak = 0.0;              // trailing: best price so far
+            double expectedVolume = 0.0;    // VWAP: average bar volume before submit
+            size_t slicesLeft = 0;
+            size_t submitBar = 0;           // first bar the order may trade on
+            size_t triggeredAt = SIZE_MAX;  // stop-limit: bar its stop fired
+            bool live = false;
+        };
+
+        // ==== Lists and heaps hold (slot, generation): a released slot may be reused before they drop it ==== //
+        struct slotRef {
+            uint32_t slot;
+            uint32_t generation;
+        };
+
+        struct levelEntry {
+            double level;
+            uint32_t slot;
+            uint32_t generation;
+        };
+        struct lowerFirst {
+            bool operator()(const levelEntry& a, const levelEntry& b) const { return a.level > b.level; }
+        };
+        struct higherFirst {
+            bool operator()(const levelEntry& a, const levelEntry& b) const { return a.level < b.level; }
+        };
+
+        // ==== Heap container kept reachable: a snapshot restores the exact heap layout, ties pop in the same order ==== //
+        template <typename Compare>
+        struct levelHeap : std::priority_queue<levelEntry, std::vector<levelEntry>, Compare> {
+            std::vector<levelEntry>& entries() { return this->c; }
+            const std::vector<levelEntry>& entries() const { return this->c; }
+        };
+
+        struct tickerOrders {
+            const std::vector<double>* open;
+            const std::vector<double>* high;
+            const std::vector<double>* low;
+            const std::vector<double>* close;
+            const std::vector<double>* volume;
+
+            levelHeap<higherFirst> buyLimits;
+            levelHeap<lowerFirst> sellLimits;
+            levelHeap<lowerFirst> buyStops;
+            levelHeap<higherFirst> sellStops;
+
+            std::vector<slotRef> working;
+            std::vector<slotRef> trailing;
+            size_t live = 0;
+        };
+
+        const std::unordered_map<std::string, AnyValue>& data_;
+        const config& cfg_;
+
+        std::vector<tickerOrders> tickers_;
+        std::vector<orderState> slots_;
+        std::vector<uint32_t> freeSlots_;
+
+        std::vector<orderFill> fills_;
+        std::vector<levelEntry> deferred_;
+        double barRoom_ = 0.0;
+
+        const std::vector<double>& column(const std::string& ticker, const std::string& field) const;
+        bool isCurrent(uint32_t slot, uint32_t generation) const;
+        bool isCurrent(const levelEntry& entry) const { return isCurrent(entry.slot, entry.generation); }
+        bool isDue(uint32_t slot, size_t bar) const { return bar >= slots_[slot].submitBar; }
+        slotRef refOf(uint32_t slot) const { return {slot, slots_[slot].generation}; }
+        void release(uint32_t slot);
+        void pushLevel(uint32_t slot, double level, bool stop);
+        void toWorking(uint32_t slot, orderKind kind);
+
+        double fill(uint32_t slot, size_t bar, double qty, double refPrice, bool aggressive);
+        void runWorking(tickerOrders& book, size_t bar);
+        void runStops(tickerOrders& book, size_t bar);
+        void runLimits(tickerOrders& book, size_t bar);
+        void runTrailing(tickerOrders& book, size_t bar);
+
+    public:
+        orderBook(const std::unordered_map<std::string, AnyValue>& data, const config& cfg);
+
+        uint32_t addTicker(const std::string& ticker);
+
+        uint64_t submit(uint32_t tickerId, const order& request, size_t bar);
+        bool cancel(uint64_t orderId);
+        size_t pending(uint32_t tickerId) const;
+
+        // ==== Fills of this bar, buffer reused by the next call ==== //
+        const std::vector<orderFill>& processBar(uint32_t tickerId, size_t bar);
+
+        // ==== Pending orders only, tickers must be added in the same order before load() ==== //
+        void save(snapshotWriter& out) const;
+        void load(snapshotReader& in);
+};
@@ -0,0 +1,44 @@
+#include "triggerScan.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#define SCAN_BLOCK 16
+
+size_t firstTouch(const double* low, const double* high, size_t from, size_t to, double lowLevel, double highLevel){
+    size_t b = from;
+
+    for (; b + SCAN_BLOCK <= to; b += SCAN_BLOCK){
+        unsigned hit{0};
+        for (size_t k = 0; k < SCAN_BLOCK; k++){
+            hit |= static_cast<unsigned>(low[b + k] <= lowLevel) | static_cast<unsigned>(high[b + k] >= highLevel);
+        }
+        if (hit) break;
+    }
+
+    for (; b < to; b++){
+        if (low[b] <= lowLevel || high[b] >= highLevel) return b;
+    }
+
+    return to;
+}
+
+triggerHit findTrigger(const double* open, const double* low, const double* high, size_t from, size_t to,
+                       ordertype side, double stop, double target){
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    const bool hasTarget = target > 0.0;
+
+    if (side == ordertype::Buy){
+        const size_t bar = firstTouch(low, high, from, to, stop, hasTarget ? target : inf);
+        if (bar == to) return {to, false, 0.0};
+
+        const bool stopped = low[bar] <= stop;
+        return {bar, stopped, stopped ? std::min(open[bar], stop) : std::max(open[bar], target)};
+    }
+
+    const size_t bar = firstTouch(low, high, from, to, hasTarget ? target : -inf, stop);
+    if (bar == to) return {to, false, 0.0};
+
+    const bool stopped = high[bar] >= stop;
+    return {bar, stopped, stopped ? std::max(open[bar], stop) : std::min(open[bar], target)};
+}
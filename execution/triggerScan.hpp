@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include "marketTypes/marketTypes.hpp"
+
+// ====================================================== //
+//             Intrabar stop / target triggers
+// - firstTouch(): first bar in [from, to) whose low reaches
+//   lowLevel or whose high reaches highLevel
+// - Scans fixed blocks with a branch-free OR reduction
+//   (auto-vectorized), the exact bar is searched only inside
+//   the block that hit
+// ====================================================== //
+
+struct triggerHit {
+    size_t bar;          // == to when nothing was touched
+    bool stopped;        // false -> take-profit
+    double refPrice;     // price the exit is filled around
+};
+
+size_t firstTouch(const double* low, const double* high, size_t from, size_t to, double lowLevel, double highLevel);
+
+// ====================================================== //
+// - target <= 0 disables the take-profit
+// - Both touched in one bar -> stop wins (order inside the bar is unknown)
+// - Gaps through a level fill at the open, not at the level
+// ====================================================== //
+triggerHit findTrigger(const double* open, const double* low, const double* high, size_t from, size_t to,
+                       ordertype side, double stop, double target);
@@ -0,0 +1,36 @@
+#include "rateCurve.hpp"
+
+#include <format>
+#include <stdexcept>
+
+#include "utils/timeIndex.hpp"
+
+#define YEAR_NS (365.0 * static_cast<double>(NS_PER_DAY))
+
+void rateCurve::build(const timeSeries& stamps, double annualBps){
+    cumulative_.clear();
+    if (annualBps == 0.0 || stamps.empty()) return;
+
+    const double rate = annualBps / 10000.0 / YEAR_NS;
+    cumulative_.resize(stamps.size());
+    cumulative_[0] = 0.0;
+    for (size_t i = 1; i < stamps.size(); i++){
+        cumulative_[i] = cumulative_[i - 1] + rate * static_cast<double>(stamps[i] - stamps[i - 1]);
+    }
+}
+
+void rateCurve::build(const timeSeries& stamps, const std::vector<double>& annualBps){
+    if (annualBps.size() != stamps.size()) {
+        throw std::runtime_error(std::format("Rate series has {} values for {} bars", annualBps.size(), stamps.size()));
+    }
+
+    cumulative_.clear();
+    if (stamps.empty()) return;
+
+    cumulative_.resize(stamps.size());
+    cumulative_[0] = 0.0;
+    for (size_t i = 1; i < stamps.size(); i++){
+        const double rate = annualBps[i - 1] / 10000.0 / YEAR_NS;
+        cumulative_[i] = cumulative_[i - 1] + rate * static_cast<double>(stamps[i] - stamps[i - 1]);
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "types/types.hpp"
+
+using Octurn::timeSeries;
+
+// ====================================================== //
+//               Cumulative rate curve
+// - Built once per run from bar timestamps and an annual
+//   rate in bps (constant or one value per bar)
+// - cumulative[i] = sum over k < i of rate[k] * dt[k] / year,
+//   simple ACT/365 accrual on the bar's own interval
+// - Accrual factor over bars [from, to) is one subtraction,
+//   holding periods never walk the bars in between
+// - An empty curve (zero rate) accrues nothing
+// ====================================================== //
+class rateCurve {
+    private:
+        std::vector<double> cumulative_;
+
+    public:
+        void build(const timeSeries& stamps, double annualBps);
+        void build(const timeSeries& stamps, const std::vector<double>& annualBps);
+        void clear() { cumulative_.clear(); }
+
+        bool empty() const { return cumulative_.empty(); }
+
+        double factor(size_t from, size_t to) const {
+            if (cumulative_.empty() || to <= from) return 0.0;
+            return cumulative_[to] - cumulative_[from];
+        }
+};
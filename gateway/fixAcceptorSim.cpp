@@ -0,0 +1,198 @@
+#include "fixAcceptorSim.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "log/logHandler.hpp"
+
+#define FIX_SIM_BUFFER (64 * 1024)
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+static int64_t wallNs(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+fixAcceptorSim::fixAcceptorSim(fixVersion version, std::string compId)
+    : version_(version), compId_(std::move(compId)) {}
+
+fixAcceptorSim::~fixAcceptorSim(){
+    stop();
+}
+
+void fixAcceptorSim::start(uint16_t port){
+    if (running_) throw std::runtime_error("FIX acceptor already running");
+
+    listener_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listener_ < 0) throw std::runtime_error("Cannot create FIX acceptor socket");
+
+    const int on{1};
+    ::setsockopt(listener_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    socklen_t length = sizeof(address);
+    if (::bind(listener_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener_, 1) != 0 ||
+        ::getsockname(listener_, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        ::close(listener_);
+        listener_ = -1;
+        throw std::runtime_error(std::format("Cannot listen on 127.0.0.1:{}", port));
+    }
+
+    port_ = ntohs(address.sin_port);
+    running_ = true;
+    worker_ = std::thread(&fixAcceptorSim::serve, this);
+}
+
+void fixAcceptorSim::stop(){
+    if (!running_) return;
+
+    running_ = false;
+    const int client = client_.exchange(-1);
+    if (client >= 0) ::shutdown(client, SHUT_RDWR);
+    ::shutdown(listener_, SHUT_RDWR);
+    ::close(listener_);
+    listener_ = -1;
+    if (worker_.joinable()) worker_.join();
+}
+
+void fixAcceptorSim::setPrice(const std::string& symbol, double price){
+    std::lock_guard<std::mutex> lock(priceMutex_);
+    prices_[symbol] = price;
+}
+
+void fixAcceptorSim::serve(){
+    while (running_){
+        const int client = ::accept(listener_, nullptr, nullptr);
+        if (client < 0) break;
+
+        const int on{1};
+        ::setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        client_ = client;
+        session(client);
+        client_.exchange(-1);
+        ::close(client);
+    }
+}
+
+bool fixAcceptorSim::reply(int client, fixEncoder& out){
+    const std::string_view message = out.finish(version_);
+    const char* data = message.data();
+    size_t size = message.size();
+    while (size > 0){
+        const ssize_t n = ::send(client, data, size, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// ====================================================== //
+//                     One FIX session
+// - ExecType: 2 (Fill) on FIX 4.2 with ExecTransType 0,
+//   F (Trade) on FIX 4.4
+// - Market orders on a symbol without a price get a
+//   Rejected report (ExecType / OrdStatus 8)
+// ====================================================== //
+
+void fixAcceptorSim::session(int client){
+    std::vector<char> buffer(FIX_SIM_BUFFER);
+    size_t used{0};
+    fixDecoder decoder;
+    fixEncoder out;
+    std::string target;
+    seqNum_ = 1;
+
+    while (running_){
+        const ssize_t n = ::recv(client, buffer.data() + used, buffer.size() - used, 0);
+        if (n <= 0) return;
+        used += static_cast<size_t>(n);
+
+        size_t offset{0};
+        while (true){
+            const std::string_view pending(buffer.data() + offset, used - offset);
+            const size_t length = fixDecoder::frame(pending);
+            if (length == 0) break;
+            offset += length;
+
+            if (!decoder.parse(pending.substr(0, length))){
+                g_logger.report("[FIXSIM] Dropped malformed message");
+                continue;
+            }
+
+            target = std::string(decoder.get(SenderCompID));
+            switch (decoder.msgType()){
+                case 'A':
+                    out.start('A', seqNum_++, compId_, target, wallNs());
+                    out.field(EncryptMethod, int64_t{0});
+                    out.field(HeartBtInt, int64_t{0});
+                    if (!reply(client, out)) return;
+                    break;
+                case 'D': {
+                    const std::string symbol(decoder.get(Symbol));
+                    const double qty = decoder.getDouble(OrderQty);
+                    double price = decoder.getDouble(Price);
+                    if (price <= 0.0){
+                        std::lock_guard<std::mutex> lock(priceMutex_);
+                        auto it = prices_.find(symbol);
+                        price = (it != prices_.end()) ? it->second : 0.0;
+                    }
+
+                    const uint64_t orderId = nextOrderId_++;
+                    const bool rejected = price <= 0.0;
+                    out.start('8', seqNum_++, compId_, target, wallNs());
+                    out.field(OrderID, orderId);
+                    out.field(ClOrdID, decoder.get(ClOrdID));
+                    out.field(ExecID, orderId);
+                    if (version_ == fixVersion::FIX42) out.field(ExecTransType, '0');
+                    if (rejected){
+                        out.field(ExecType, '8');
+                        out.field(OrdStatus, '8');
+                    } else {
+                        out.field(ExecType, version_ == fixVersion::FIX42 ? '2' : 'F');
+                        out.field(OrdStatus, '2');
+                    }
+                    out.field(Symbol, symbol);
+                    out.field(Side, decoder.get(Side));
+                    out.field(OrderQty, qty);
+                    out.field(LastQty, rejected ? 0.0 : qty);
+                    out.field(LastPx, price);
+                    out.field(LeavesQty, 0.0);
+                    out.field(CumQty, rejected ? 0.0 : qty);
+                    out.field(AvgPx, price);
+                    out.timeField(TransactTime, wallNs());
+                    if (rejected) out.field(Text, std::format("No price for {}", symbol));
+                    if (!reply(client, out)) return;
+                    (rejected ? ordersRejected_ : ordersFilled_)++;
+                    break;
+                }
+                case '5':
+                    out.start('5', seqNum_++, compId_, target, wallNs());
+                    reply(client, out);
+                    return;
+                default:
+                    break;
+            }
+        }
+
+        std::memmove(buffer.data(), buffer.data() + offset, used - offset);
+        used -= offset;
+        if (used == buffer.size()) return;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "gateway/fixMessage.hpp"
+
+// ====================================================== //
+//                Local FIX acceptor simulator
+// - Listens on 127.0.0.1, serves one session at a time
+// - Logon -> Logon, NewOrderSingle -> one filled or
+//   rejected ExecutionReport, Logout -> Logout then close
+// - Market orders fill at the last setPrice() of their
+//   symbol, limit orders at their limit, market orders
+//   on a symbol never priced are rejected
+// ====================================================== //
+class fixAcceptorSim {
+    private:
+        fixVersion version_;
+        std::string compId_;
+
+        int listener_ = -1;
+        uint16_t port_ = 0;
+        std::atomic<int> client_{-1};
+        std::thread worker_;
+        std::atomic<bool> running_{false};
+
+        std::mutex priceMutex_;
+        std::unordered_map<std::string, double> prices_;
+
+        uint64_t seqNum_ = 1;
+        uint64_t nextOrderId_ = 1;
+        std::atomic<uint64_t> ordersFilled_{0};
+        std::atomic<uint64_t> ordersRejected_{0};
+
+        void serve();
+        void session(int client);
+        bool reply(int client, fixEncoder& out);
+
+    public:
+        explicit fixAcceptorSim(fixVersion version = fixVersion::FIX44, std::string compId = "PAPER");
+        ~fixAcceptorSim();
+
+        fixAcceptorSim(const fixAcceptorSim&) = delete;
+        fixAcceptorSim& operator=(const fixAcceptorSim&) = delete;
+
+        // ==== port 0 -> ephemeral, see port() ==== //
+        void start(uint16_t port = 0);
+        void stop();
+
+        uint16_t port() const { return port_; }
+        void setPrice(const std::string& symbol, double price);
+        uint64_t ordersFilled() const { return ordersFilled_.load(); }
+        uint64_t ordersRejected() const { return ordersRejected_.load(); }
+};
@@ -0,0 +1,391 @@
+#include "fixGateway.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "log/logHandler.hpp"
+
+#define FIX_RECV_BUFFER (64 * 1024)
+#define FIX_LOGON_TIMEOUT_MS 5000
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+static int64_t steadyNs(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static int64_t wallNs(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static bool writeAll(int fd, const char* data, size_t size){
+    while (size > 0){
+        const ssize_t n = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+fixGateway::fixGateway(account& account, const config& cfg, fixSessionSettings settings)
+    : account_(account), cfg_(cfg), settings_(std::move(settings)) {
+    size_t slots{1};
+    while (slots < std::max<size_t>(settings_.ringSize, 2)) slots <<= 1;
+    ring_.resize(slots);
+    mask_ = slots - 1;
+
+    latencyUs_.resize(settings_.latencySamples);
+    orders_.reserve(settings_.latencySamples);
+}
+
+fixGateway::~fixGateway(){
+    try {
+        stop();
+    } catch (const std::exception& e) {
+        g_logger.report(std::format("[FIX] Stop failed: {}", e.what()));
+    }
+}
+
+uint32_t fixGateway::addTicker(const std::string& ticker){
+    auto it = tickerIds_.find(ticker);
+    if (it != tickerIds_.end()) return it->second;
+
+    const uint32_t id = ledger_.addTicker(ticker);
+    orderedNet_.push_back(0.0);
+    tickerIds_.emplace(ticker, id);
+    return id;
+}
+
+// ====================================================== //
+//                    Session lifecycle
+// ====================================================== //
+
+void fixGateway::start(){
+    if (socket_ >= 0) throw std::runtime_error("FIX session already started");
+
+    socket_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (socket_ < 0) throw std::runtime_error("Cannot create FIX socket");
+
+    const int on{1};
+    ::setsockopt(socket_, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(settings_.port);
+    if (::inet_pton(AF_INET, settings_.host.c_str(), &address.sin_addr) != 1 ||
+        ::connect(socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(socket_);
+        socket_ = -1;
+        throw std::runtime_error(std::format("Cannot connect to FIX acceptor {}:{}", settings_.host, settings_.port));
+    }
+
+    closed_ = false;
+    senderDone_ = false;
+    sender_ = std::thread(&fixGateway::sendLoop, this);
+    receiver_ = std::thread(&fixGateway::receiveLoop, this);
+
+    enqueue('A', 0, false, [](fixEncoder& out){
+        out.field(EncryptMethod, int64_t{0});
+        out.field(HeartBtInt, int64_t{0});
+    });
+
+    const int64_t deadline = steadyNs() + int64_t{FIX_LOGON_TIMEOUT_MS} * 1'000'000;
+    while (!loggedOn_ && !closed_ && steadyNs() < deadline){
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (!loggedOn_) {
+        stop();
+        throw std::runtime_error("FIX acceptor did not answer the Logon");
+    }
+
+    g_logger.report(std::format("[FIX] Logged on {} -> {} ({})", settings_.senderCompId, settings_.targetCompId,
+        fixBeginString(settings_.version)));
+}
+
+void fixGateway::stop(){
+    if (socket_ < 0) return;
+
+    // ==== The Logout slot is the sender's last one, it also wakes a sender idle on a dead socket ==== //
+    if (sender_.joinable()){
+        if (!senderDone_) enqueue('5', 0, true, [](fixEncoder&){});
+        sender_.join();
+    }
+
+    // ==== Give the acceptor a moment to answer the Logout, then unblock the reader ==== //
+    const int64_t deadline = steadyNs() + 1'000'000'000;
+    while (!closed_ && steadyNs() < deadline){
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ::shutdown(socket_, SHUT_RDWR);
+    if (receiver_.joinable()) receiver_.join();
+
+    ::close(socket_);
+    socket_ = -1;
+    loggedOn_ = false;
+}
+
+// ====================================================== //
+//                       Send path
+// - Producer only spins when the ring is full
+// - Encoder output is copied into the slot, the slot
+//   memory is allocated once in the constructor
+// ====================================================== //
+
+void fixGateway::enqueue(char msgType, int64_t signalNs, bool last, auto&& body){
+    if (closed_ && !last) throw std::runtime_error("FIX session is closed");
+
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    while (head - tail_.load(std::memory_order_acquire) > mask_){
+        if (senderDone_) throw std::runtime_error("FIX session is closed");
+        std::this_thread::yield();
+    }
+
+    encoder_.start(msgType, seqNum_++, settings_.senderCompId, settings_.targetCompId, wallNs());
+    body(encoder_);
+    const std::string_view message = encoder_.finish(settings_.version);
+
+    auto& slot = ring_[head & mask_];
+    std::memcpy(slot.bytes.data(), message.data(), message.size());
+    slot.size = message.size();
+    slot.signalNs = signalNs;
+    slot.last = last;
+
+    head_.store(head + 1, std::memory_order_release);
+    head_.notify_one();
+}
+
+void fixGateway::sendLoop(){
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+
+    while (true){
+        const uint64_t head = head_.load(std::memory_order_acquire);
+        if (tail == head){
+            head_.wait(head, std::memory_order_acquire);
+            continue;
+        }
+
+        const auto& slot = ring_[tail & mask_];
+        const bool sent = writeAll(socket_, slot.bytes.data(), slot.size);
+        const bool last = slot.last;
+
+        if (sent && slot.signalNs){
+            const size_t count = latencyCount_.load(std::memory_order_relaxed);
+            if (count < latencyUs_.size()){
+                latencyUs_[count] = static_cast<double>(steadyNs() - slot.signalNs) / 1000.0;
+                latencyCount_.store(count + 1, std::memory_order_release);
+            }
+        }
+
+        tail_.store(++tail, std::memory_order_release);
+
+        if (!sent){
+            if (!last) g_logger.report("[FIX] Send failed, session closed");
+            closed_ = true;
+            break;
+        }
+        if (last) break;
+    }
+
+    senderDone_ = true;
+}
+
+// ====================================================== //
+//                      Receive path
+// ====================================================== //
+
+void fixGateway::receiveLoop(){
+    std::vector<char> buffer(FIX_RECV_BUFFER);
+    size_t used{0};
+    fixDecoder decoder;
+
+    while (true){
+        const ssize_t n = ::recv(socket_, buffer.data() + used, buffer.size() - used, 0);
+        if (n <= 0) break;
+        used += static_cast<size_t>(n);
+
+        size_t offset{0};
+        bool logout{false};
+        while (true){
+            const std::string_view pending(buffer.data() + offset, used - offset);
+            const size_t length = fixDecoder::frame(pending);
+            if (length == 0) break;
+
+            if (!decoder.parse(pending.substr(0, length))){
+                g_logger.report("[FIX] Dropped malformed message");
+            } else {
+                switch (decoder.msgType()){
+                    case 'A':
+                        loggedOn_ = true;
+                        break;
+                    case '8': {
+                        const auto status = decoder.get(OrdStatus);
+                        const executionReport report{
+                            decoder.getUint(ClOrdID), status.empty() ? '\0' : status[0],
+                            decoder.getDouble(LastQty), decoder.getDouble(LastPx), decoder.getDouble(LeavesQty)
+                        };
+                        std::lock_guard<std::mutex> lock(inboundMutex_);
+                        inbound_.push_back(report);
+                        break;
+                    }
+                    case '3':
+                        g_logger.report(std::format("[FIX] Reject: {}", decoder.get(Text)));
+                        break;
+                    case '5':
+                        logout = true;
+                        break;
+                    default:
+                        break;
+                }
+            }
+            offset += length;
+        }
+
+        std::memmove(buffer.data(), buffer.data() + offset, used - offset);
+        used -= offset;
+
+        if (logout) break;
+        if (used == buffer.size()){
+            g_logger.report("[FIX] Receive buffer overflow, session closed");
+            break;
+        }
+    }
+
+    closed_ = true;
+}
+
+// ====================================================== //
+//                         Orders
+// ====================================================== //
+
+uint64_t fixGateway::submit(uint32_t tickerId, ordertype side, double qty, double limitPrice){
+    const int64_t signalNs = steadyNs();
+
+    if (!loggedOn_) throw std::runtime_error("FIX session is not logged on");
+    if (tickerId >= orderedNet_.size()) throw std::runtime_error(std::format("Unknown ticker id {}", tickerId));
+    if (qty <= 0.0) throw std::runtime_error("Order quantity must be positive");
+
+    const uint64_t clOrdId = orders_.size();
+    orders_.push_back({tickerId, side, qty});
+    orderedNet_[tickerId] += (side == ordertype::Buy) ? qty : -qty;
+
+    const std::string& symbol = ledger_.tickerName(tickerId);
+    enqueue('D', signalNs, false, [&](fixEncoder& out){
+        out.field(ClOrdID, clOrdId);
+        out.field(HandlInst, '1');
+        out.field(Symbol, symbol);
+        out.field(Side, side == ordertype::Buy ? '1' : '2');
+        out.timeField(TransactTime, wallNs());
+        out.field(OrderQty, qty);
+        out.field(OrdType, limitPrice > 0.0 ? '2' : '1');
+        if (limitPrice > 0.0) out.field(Price, limitPrice);
+    });
+
+    return clOrdId;
+}
+
+// ==== Exit flattens what was ordered so far, fills may still be in flight ==== //
+uint64_t fixGateway::onDecision(uint32_t tickerId, action decision, double qty){
+    if (decision == action::Entry) return submit(tickerId, ordertype::Buy, qty);
+
+    if (tickerId >= orderedNet_.size()) throw std::runtime_error(std::format("Unknown ticker id {}", tickerId));
+    const double net = orderedNet_[tickerId];
+    if (net == 0.0) return FIX_NO_ORDER;
+
+    return submit(tickerId, net > 0.0 ? ordertype::Sell : ordertype::Buy, std::abs(net));
+}
+
+size_t fixGateway::poll(){
+    {
+        std::lock_guard<std::mutex> lock(inboundMutex_);
+        applying_.swap(inbound_);
+    }
+
+    for (const auto& report : applying_){
+        if (report.ordStatus == '8') applyReject(report);
+        else applyFill(report);
+    }
+
+    const size_t applied = applying_.size();
+    applying_.clear();
+    return applied;
+}
+
+// ====================================================== //
+//                  Fill -> ledger / account
+// - Opening qty posts margin (longInitMargin for longs,
+//   shortInitMargin for shorts), closing qty releases it
+//   at the average cost and realizes PnL net of commission
+// - A reject posts nothing, its qty leaves the ordered net
+// ====================================================== //
+
+void fixGateway::applyFill(const executionReport& report){
+    if (report.lastQty <= 0.0) return;
+    if (report.clOrdId >= orders_.size()){
+        g_logger.report(std::format("[FIX] Execution report for unknown ClOrdID {}", report.clOrdId));
+        return;
+    }
+
+    const auto& order = orders_[report.clOrdId];
+    const bool buy = order.side == ordertype::Buy;
+    const ledgerPosition before = ledger_.position(order.tickerId);
+
+    const double commission = report.lastQty * report.lastPx * cfg_.commissionBps / 10000.0;
+    const double pnl = ledger_.onFill(order.tickerId, order.side, report.lastQty, report.lastPx, commission);
+
+    const bool reducing = before.netQty != 0.0 && (before.netQty > 0.0) != buy;
+    const double closed = reducing ? std::min(report.lastQty, std::abs(before.netQty)) : 0.0;
+    const double released = closed * before.avgCost * (before.netQty > 0.0 ? cfg_.longInitMargin : cfg_.shortInitMargin);
+    const double posted = (report.lastQty - closed) * report.lastPx * (buy ? cfg_.longInitMargin : cfg_.shortInitMargin);
+
+    account_.updateReservedMargin(posted - released);
+    account_.updateFreeCash(released - posted);
+    account_.realizeTradePnL(pnl);
+}
+
+void fixGateway::applyReject(const executionReport& report){
+    if (report.clOrdId >= orders_.size()){
+        g_logger.report(std::format("[FIX] Reject for unknown ClOrdID {}", report.clOrdId));
+        return;
+    }
+
+    const auto& order = orders_[report.clOrdId];
+    orderedNet_[order.tickerId] -= (order.side == ordertype::Buy) ? order.qty : -order.qty;
+    ordersRejected_++;
+    g_logger.report(std::format("[FIX] Order {} on {} rejected", report.clOrdId, ledger_.tickerName(order.tickerId)));
+}
+
+latencyStats fixGateway::latency() const {
+    latencyStats stats;
+    stats.count = latencyCount_.load(std::memory_order_acquire);
+    if (stats.count == 0) return stats;
+
+    std::vector<double> samples(latencyUs_.begin(), latencyUs_.begin() + static_cast<std::ptrdiff_t>(stats.count));
+    double sum{0};
+    for (double sample : samples){
+        sum += sample;
+        stats.maxUs = std::max(stats.maxUs, sample);
+    }
+    stats.meanUs = sum / static_cast<double>(stats.count);
+
+    auto percentile = [&](double q){
+        const size_t k = std::min(samples.size() - 1, static_cast<size_t>(q * static_cast<double>(samples.size())));
+        std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(k), samples.end());
+        return samples[k];
+    };
+    stats.p50Us = percentile(0.50);
+    stats.p99Us = percentile(0.99);
+
+    return stats;
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "account/account.hpp"
+#include "config/config.hpp"
+#include "gateway/fixMessage.hpp"
+#include "marketTypes/marketTypes.hpp"
+#include "trade/positionLedger.hpp"
+
+#define FIX_NO_ORDER UINT64_MAX
+
+struct fixSessionSettings {
+    std::string host = "127.0.0.1";
+    uint16_t port = 0;
+    std::string senderCompId = "OCTURN";
+    std::string targetCompId = "PAPER";
+    fixVersion version = fixVersion::FIX44;
+    size_t ringSize = 1024;          // outbound slots, rounded up to a power of two
+    size_t latencySamples = 1 << 16; // signal-to-wire samples kept
+};
+
+struct executionReport {
+    uint64_t clOrdId;
+    char ordStatus;
+    double lastQty;
+    double lastPx;
+    double leavesQty;
+};
+
+struct latencyStats {
+    size_t count = 0;
+    double meanUs = 0.0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+};
+
+// ====================================================== //
+//                  FIX paper-trading gateway
+// - Initiator side of one FIX session over TCP
+// - Send path: the caller encodes into a preallocated ring
+//   slot (no allocation), a sender thread writes the ring
+//   to the socket -> submit() never blocks on I/O
+// - Receive path: a reader thread frames and decodes
+//   execution reports, poll() applies them to the ledger
+//   and the account on the caller's thread
+// - A rejected order is taken back out of the ordered net,
+//   a later exit only flattens what was accepted
+// - Latency = steady clock from the decision to the end of
+//   the socket write, stored in microseconds
+// ====================================================== //
+class fixGateway {
+    private:
+        struct outboundSlot {
+            std::array<char, FIX_MAX_MESSAGE + 32> bytes;
+            size_t size;
+            int64_t signalNs;
+            bool last;
+        };
+
+        struct orderRecord {
+            uint32_t tickerId;
+            ordertype side;
+            double qty;
+        };
+
+        account& account_;
+        const config& cfg_;
+        fixSessionSettings settings_;
+
+        int socket_ = -1;
+        uint64_t seqNum_ = 1;
+        fixEncoder encoder_;
+
+        // ==== SPSC ring: caller produces, sender thread consumes ==== //
+        std::vector<outboundSlot> ring_;
+        size_t mask_ = 0;
+        std::atomic<uint64_t> head_{0};
+        std::atomic<uint64_t> tail_{0};
+
+        std::vector<double> latencyUs_;
+        std::atomic<size_t> latencyCount_{0};
+
+        std::mutex inboundMutex_;
+        std::vector<executionReport> inbound_;
+        std::vector<executionReport> applying_;
+        std::atomic<bool> loggedOn_{false};
+        std::atomic<bool> closed_{false};
+        std::atomic<bool> senderDone_{false};
+
+        std::vector<orderRecord> orders_;
+        std::vector<double> orderedNet_;     // signed qty sent per ticker, net of rejects
+        size_t ordersRejected_ = 0;
+        std::unordered_map<std::string, uint32_t> tickerIds_;
+        positionLedger ledger_;
+
+        std::thread sender_;
+        std::thread receiver_;
+
+        void enqueue(char msgType, int64_t signalNs, bool last, auto&& body);
+        void sendLoop();
+        void receiveLoop();
+        void applyFill(const executionReport& report);
+        void applyReject(const executionReport& report);
+
+    public:
+        fixGateway(account& account, const config& cfg, fixSessionSettings settings);
+        ~fixGateway();
+
+        fixGateway(const fixGateway&) = delete;
+        fixGateway& operator=(const fixGateway&) = delete;
+
+        // ==== Connects, sends Logon and waits for the acceptor's Logon ==== //
+        void start();
+        // ==== Logout, drains the ring and joins both threads ==== //
+        void stop();
+
+        uint32_t addTicker(const std::string& ticker);
+
+        // ==== Market order when limitPrice == 0, returns its ClOrdID ==== //
+        uint64_t submit(uint32_t tickerId, ordertype side, double qty, double limitPrice = 0.0);
+        // ==== Entry buys `qty`, exit flattens what was ordered (FIX_NO_ORDER if flat) ==== //
+        uint64_t onDecision(uint32_t tickerId, action decision, double qty);
+
+        // ==== Applies received execution reports, returns how many ==== //
+        size_t poll();
+
+        const positionLedger& ledger() const { return ledger_; }
+        bool loggedOn() const { return loggedOn_.load(); }
+        size_t ordersSent() const { return orders_.size(); }
+        size_t ordersRejected() const { return ordersRejected_; }
+        latencyStats latency() const;
+};
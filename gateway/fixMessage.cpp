@@ -0,0 +1,198 @@
+#include "fixMessage.hpp"
+
+#include <charconv>
+#include <ctime>
+#include <stdexcept>
+
+static constexpr char SOH = FIX_SOH;
+
+std::string_view fixBeginString(fixVersion version){
+    return version == fixVersion::FIX42 ? "FIX.4.2" : "FIX.4.4";
+}
+
+// ====================================================== //
+//                        Encoder
+// ====================================================== //
+
+void fixEncoder::raw(std::string_view text){
+    if (end_ + text.size() > buffer_.size()) {
+        throw std::runtime_error("FIX message exceeds FIX_MAX_MESSAGE");
+    }
+    for (char c : text) buffer_[end_++] = c;
+}
+
+void fixEncoder::tag(int tag){
+    char digits[16];
+    auto [ptr, ec] = std::to_chars(digits, digits + sizeof(digits), tag);
+    raw({digits, static_cast<size_t>(ptr - digits)});
+    raw("=");
+}
+
+void fixEncoder::start(char msgType, uint64_t seqNum, std::string_view sender, std::string_view target, int64_t sendingTimeNs){
+    begin_ = HEADROOM;
+    end_ = HEADROOM;
+
+    field(MsgType, msgType);
+    field(SenderCompID, sender);
+    field(TargetCompID, target);
+    field(MsgSeqNum, seqNum);
+    timeField(SendingTime, sendingTimeNs);
+}
+
+void fixEncoder::field(int id, std::string_view value){
+    tag(id);
+    raw(value);
+    raw({&SOH, 1});
+}
+
+void fixEncoder::field(int id, char value){
+    field(id, std::string_view(&value, 1));
+}
+
+void fixEncoder::field(int id, int64_t value){
+    char digits[24];
+    auto [ptr, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+    field(id, std::string_view(digits, static_cast<size_t>(ptr - digits)));
+}
+
+void fixEncoder::field(int id, uint64_t value){
+    char digits[24];
+    auto [ptr, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+    field(id, std::string_view(digits, static_cast<size_t>(ptr - digits)));
+}
+
+void fixEncoder::field(int id, double value){
+    char digits[32];
+    auto [ptr, ec] = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, 6);
+    if (ec != std::errc{}) throw std::runtime_error("FIX price/qty is out of range");
+    field(id, std::string_view(digits, static_cast<size_t>(ptr - digits)));
+}
+
+// ==== UTCTimestamp YYYYMMDD-HH:MM:SS.sss ==== //
+void fixEncoder::timeField(int id, int64_t epochNs){
+    const std::time_t seconds = static_cast<std::time_t>(epochNs / 1'000'000'000);
+    const int millis = static_cast<int>((epochNs / 1'000'000) % 1000);
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+
+    char text[32];
+    const size_t n = std::strftime(text, sizeof(text), "%Y%m%d-%H:%M:%S", &utc);
+    text[n] = '.';
+    text[n + 1] = static_cast<char>('0' + millis / 100);
+    text[n + 2] = static_cast<char>('0' + (millis / 10) % 10);
+    text[n + 3] = static_cast<char>('0' + millis % 10);
+    field(id, std::string_view(text, n + 4));
+}
+
+// ==== Prepends 8=|9=, appends 10= (sum of every byte before it, mod 256) ==== //
+std::string_view fixEncoder::finish(fixVersion version){
+    const size_t bodyLength = end_ - HEADROOM;
+
+    char header[HEADROOM];
+    size_t n = 0;
+    auto put = [&](std::string_view text){ for (char c : text) header[n++] = c; };
+
+    char digits[16];
+    auto [ptr, ec] = std::to_chars(digits, digits + sizeof(digits), bodyLength);
+    put("8=");
+    put(fixBeginString(version));
+    put({&SOH, 1});
+    put("9=");
+    put({digits, static_cast<size_t>(ptr - digits)});
+    put({&SOH, 1});
+
+    begin_ = HEADROOM - n;
+    for (size_t i = 0; i < n; i++) buffer_[begin_ + i] = header[i];
+
+    unsigned sum{0};
+    for (size_t i = begin_; i < end_; i++) sum += static_cast<unsigned char>(buffer_[i]);
+
+    sum %= 256;
+    const char checksum[3] = {
+        static_cast<char>('0' + sum / 100),
+        static_cast<char>('0' + (sum / 10) % 10),
+        static_cast<char>('0' + sum % 10)
+    };
+    field(CheckSum, std::string_view(checksum, 3));
+
+    return {buffer_.data() + begin_, end_ - begin_};
+}
+
+// ====================================================== //
+//                        Decoder
+// ====================================================== //
+
+size_t fixDecoder::frame(std::string_view bytes){
+    // ==== 8=...|9=<len>|<body>10=xxx| ==== //
+    const size_t lengthTag = bytes.find("\x01" "9=");
+    if (lengthTag == std::string_view::npos) return 0;
+
+    const size_t lengthStart = lengthTag + 3;
+    const size_t lengthEnd = bytes.find(FIX_SOH, lengthStart);
+    if (lengthEnd == std::string_view::npos) return 0;
+
+    size_t bodyLength{0};
+    auto [ptr, ec] = std::from_chars(bytes.data() + lengthStart, bytes.data() + lengthEnd, bodyLength);
+    if (ec != std::errc{}) throw std::runtime_error("FIX BodyLength is not a number");
+
+    const size_t total = lengthEnd + 1 + bodyLength + 7;   // "10=xxx|"
+    return bytes.size() >= total ? total : 0;
+}
+
+bool fixDecoder::parse(std::string_view message){
+    count_ = 0;
+
+    unsigned sum{0};
+    size_t pos{0};
+    while (pos < message.size()){
+        const size_t eq = message.find('=', pos);
+        const size_t soh = message.find(FIX_SOH, pos);
+        if (eq == std::string_view::npos || soh == std::string_view::npos || eq > soh) return false;
+
+        int id{0};
+        auto [ptr, ec] = std::from_chars(message.data() + pos, message.data() + eq, id);
+        if (ec != std::errc{} || count_ == FIX_MAX_FIELDS) return false;
+
+        const std::string_view value = message.substr(eq + 1, soh - eq - 1);
+        if (id == CheckSum){
+            unsigned expected{0};
+            std::from_chars(value.data(), value.data() + value.size(), expected);
+            if (expected != sum % 256) return false;
+        } else {
+            for (size_t i = pos; i <= soh; i++) sum += static_cast<unsigned char>(message[i]);
+        }
+
+        tags_[count_] = id;
+        values_[count_] = value;
+        count_++;
+        pos = soh + 1;
+    }
+
+    return count_ > 0 && tags_[count_ - 1] == CheckSum;
+}
+
+std::string_view fixDecoder::get(int tag) const {
+    for (size_t i = 0; i < count_; i++){
+        if (tags_[i] == tag) return values_[i];
+    }
+    return {};
+}
+
+char fixDecoder::msgType() const {
+    const auto value = get(MsgType);
+    return value.size() == 1 ? value[0] : '\0';
+}
+
+double fixDecoder::getDouble(int tag) const {
+    const auto value = get(tag);
+    double result{0.0};
+    std::from_chars(value.data(), value.data() + value.size(), result);
+    return result;
+}
+
+uint64_t fixDecoder::getUint(int tag) const {
+    const auto value = get(tag);
+    uint64_t result{0};
+    std::from_chars(value.data(), value.data() + value.size(), result);
+    return result;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// ====================================================== //
+//                  FIX 4.2 / 4.4 messages
+// - fixEncoder writes into its own fixed buffer: no heap
+//   allocation per message, BodyLength and CheckSum are
+//   filled in by finish()
+// - fixDecoder indexes one framed message in place,
+//   field values are views into the receive buffer
+// ====================================================== //
+
+#define FIX_MAX_MESSAGE 512
+#define FIX_MAX_FIELDS 64
+#define FIX_SOH '\x01'
+
+enum class fixVersion {
+    FIX42, FIX44
+};
+
+enum fixTag : int {
+    AvgPx = 6,
+    BeginString = 8,
+    BodyLength = 9,
+    CheckSum = 10,
+    ClOrdID = 11,
+    CumQty = 14,
+    ExecID = 17,
+    ExecTransType = 20,
+    HandlInst = 21,
+    LastPx = 31,
+    LastQty = 32,
+    MsgSeqNum = 34,
+    MsgType = 35,
+    OrderID = 37,
+    OrderQty = 38,
+    OrdStatus = 39,
+    OrdType = 40,
+    Price = 44,
+    SenderCompID = 49,
+    SendingTime = 52,
+    Side = 54,
+    Symbol = 55,
+    TargetCompID = 56,
+    Text = 58,
+    TransactTime = 60,
+    EncryptMethod = 98,
+    HeartBtInt = 108,
+    ExecType = 150,
+    LeavesQty = 151
+};
+
+std::string_view fixBeginString(fixVersion version);
+
+class fixEncoder {
+    private:
+        // ==== Header (8=...|9=...|) is written right-aligned into the headroom by finish() ==== //
+        static constexpr size_t HEADROOM = 32;
+
+        std::array<char, HEADROOM + FIX_MAX_MESSAGE> buffer_;
+        size_t begin_ = HEADROOM;
+        size_t end_ = HEADROOM;
+
+        void raw(std::string_view text);
+        void tag(int tag);
+
+    public:
+        // ==== Starts a message: MsgType, then the standard header fields ==== //
+        void start(char msgType, uint64_t seqNum, std::string_view sender, std::string_view target, int64_t sendingTimeNs);
+
+        void field(int tag, std::string_view value);
+        void field(int tag, char value);
+        void field(int tag, int64_t value);
+        void field(int tag, uint64_t value);
+        void field(int tag, double value);
+        void timeField(int tag, int64_t epochNs);
+
+        std::string_view finish(fixVersion version);
+};
+
+class fixDecoder {
+    private:
+        std::array<int, FIX_MAX_FIELDS> tags_;
+        std::array<std::string_view, FIX_MAX_FIELDS> values_;
+        size_t count_ = 0;
+
+    public:
+        // ==== Length of the first complete message in `bytes`, 0 if it is not complete yet ==== //
+        static size_t frame(std::string_view bytes);
+
+        // ==== Indexes one framed message, false on a malformed one or a bad checksum ==== //
+        bool parse(std::string_view message);
+
+        std::string_view get(int tag) const;
+        char msgType() const;
+        double getDouble(int tag) const;
+        uint64_t getUint(int tag) const;
+};
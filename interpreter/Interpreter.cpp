@@ -1,9 +1,9 @@
 #include "Interpreter.hpp"
 #include "utils/Utils.hpp"
 #include "log/logHandler.hpp"
+#include <format>
 #include <numeric>
 #include <string>
-#include <regex>
 #include <utility>
 
 
@@ -16,67 +16,100 @@
 // ====================================================== //
 
 // ====================================================== //
-Interpreter::Interpreter(std::shared_ptr<ASTNode>& root, MarketDataView&& marketDataView)
-    : root_(std::move(root)), marketDataView_(std::move(marketDataView)), cfg_(&variables_)
+Interpreter::Interpreter(std::shared_ptr<const syntaxTree> tree, MarketDataView&& marketDataView)
+    : tree_(std::move(tree)), marketDataView_(std::move(marketDataView)), cfg_(&variables_)
 {
     strategy_blocks = {
-        {Tokentype::Config, [this](const std::shared_ptr<ASTBlock>& block){
+        {Tokentype::Config, [this](const ASTBlock* block){
             this->eval_config(block);
         }},
-        { Tokentype::Parameters, [this](const std::shared_ptr<ASTBlock>& block) {
+        { Tokentype::Parameters, [this](const ASTBlock* block) {
             this->eval_parameters(block);
         }},
-        { Tokentype::Indicators, [this](const std::shared_ptr<ASTBlock>& block) {
+        { Tokentype::Indicators, [this](const ASTBlock* block) {
             this->eval_indicators(block);
         }},
-        { Tokentype::Entry, [this](const std::shared_ptr<ASTBlock>& block) {
+        { Tokentype::Entry, [this](const ASTBlock* block) {
             this->eval_entry(block);
         }},
-        { Tokentype::Exit, [this](const std::shared_ptr<ASTBlock>& block) {
+        { Tokentype::Exit, [this](const ASTBlock* block) {
             this->eval_exit(block);
         }}
     };
 }
+
+Interpreter::Interpreter(const strategyImage& image, MarketDataView&& marketDataView)
+    : Interpreter(std::shared_ptr<const syntaxTree>{}, std::move(marketDataView))
+{
+    image_.emplace(image);
+}
 // ------------------------------------------------------------------------------------------------------------------- //
 
-AnyValue Interpreter::eval_entry(const std::shared_ptr<ASTBlock>& block){
+AnyValue Interpreter::eval_entry(const ASTBlock* block){
     g_logger.report("[INTERPRETER] Entry evaluation started.");
     if (block->block_type == Tokentype::Entry){
 
         // ==== Start to interpret conditions ==== //
-        auto condition = std::dynamic_pointer_cast<ASTNode>(block->entries["Entry"]);
-
-        // ==== Create visitor to get callable type ==== //
-        ExecutionContext ctx{variables_, data_, marketDataView_.data(), functionMap};
-        Visitor visitor(ctx);
+        auto it = block->entries.find("Entry");
+        if (it == block->entries.end() || !it->second) throw std::runtime_error("\"Entry\" condition is missing!");
+        const ASTNode* condition = it->second;
 
-        // ==== Recursive propagation through all childs ==== //
-        auto evaluated_expression = condition->accept(visitor);
+        auto evaluated_expression = eval_signal(*condition, "Entry");
         variables_["Entry"] = evaluated_expression;
 
         return evaluated_expression;
     } else throw std::runtime_error("\"Entry\" block is not defined!");
 }
 
-AnyValue Interpreter::eval_exit(const std::shared_ptr<ASTBlock>& block){
+AnyValue Interpreter::eval_exit(const ASTBlock* block){
     g_logger.report("[INTERPRETER] Exit evaluation started.");
     if (block->block_type == Tokentype::Exit){
 
         // ==== Start to interpret conditions ==== //
-        auto condition = std::dynamic_pointer_cast<ASTNode>(block->entries["Exit"]);
+        auto it = block->entries.find("Exit");
+        if (it == block->entries.end() || !it->second) throw std::runtime_error("\"Exit\" condition is missing!");
+        const ASTNode* condition = it->second;
 
-        // ==== Create visitor to get callable type ==== //
-        ExecutionContext ctx{variables_, data_, marketDataView_.data(), functionMap};
-        Visitor visitor(ctx);
-
-        // ==== Recursive propagation through all childs ==== //
-        auto evaluated_expression = condition->accept(visitor);
+        auto evaluated_expression = eval_signal(*condition, "Exit");
         variables_["Exit"] = evaluated_expression;
 
         return evaluated_expression;
     } else throw std::runtime_error("\"Exit\" block is not defined!");
 }
 
+// ====================================================== //
+//                Evaluate Entry/Exit condition
+// - JIT kernel when one is set and accepts the condition
+// - Visitor otherwise, and as the reference in verify mode
+// ====================================================== //
+
+AnyValue Interpreter::eval_signal(const ASTNode& condition, const char* name){
+
+    // ==== Create visitor to get callable type ==== //
+    ExecutionContext ctx{variables_, data_, std::as_const(marketDataView_).data(), functionMap};
+    Visitor visitor(ctx);
+
+    if (jit_){
+        if (auto native = jit_->evaluate(condition, ctx)){
+            if (jit_->options().verify){
+                auto reference = visitor.visit(condition);
+                auto expected = std::get_if<std::vector<bool>>(&reference);
+                if (!expected || *expected != std::get<std::vector<bool>>(*native)){
+                    throw std::runtime_error(std::format("JIT result for \"{}\" differs from the interpreter", name));
+                }
+            }
+            return std::move(*native);
+        }
+    }
+
+    // ==== Recursive propagation through all childs ==== //
+    return visitor.visit(condition);
+}
+
+void Interpreter::set_jit(std::shared_ptr<strategyJit> jit){
+    jit_ = std::move(jit);
+}
+
 // ====================================================== //
 
 // ------------------------------------------------------------------------------------------------------------------- //
@@ -87,17 +120,25 @@ AnyValue Interpreter::eval_exit(const std::shared_ptr<ASTBlock>& block){
 // ====================================================== //
 void Interpreter::run(){
 
-    // ==== Cast ASTNode object to ASTRoot ==== //
-    auto root_cast = std::dynamic_pointer_cast<ASTRoot>(root_);
+    // ==== Image path: no tree behind it ==== //
+    if (image_){
+        g_logger.report(std::format("[INTERPRETER] Run started from image ({} bytes).", image_->size()));
+        eval_image(*image_);
+        return;
+    }
+
+    // ==== Root of the parsed tree ==== //
+    const ASTRoot* root = tree_ ? tree_->root() : nullptr;
 
     // ==== If invalid ==== //
-    if (!root_cast){
+    if (!root){
         g_logger.report("[INTERPRETER][ERROR] Root node is not recognizable.");
+        throw std::runtime_error("Unable to run: syntax tree has no root.");
     }
 
-    // ==== Evaluate script if cast is successful ==== //
+    // ==== Evaluate script ==== //
     g_logger.report("[INTERPRETER] Run started.");
-    eval_program(root_cast);
+    eval_program(root);
 }
 // ====================================================== //
 
@@ -107,26 +148,61 @@ void Interpreter::run(){
 
 // ------------------------------------------------------------------------------------------------------------------- //
 
+// ====================================================== //
+//                 Re-evaluate signals
+// - Used by sweeps / walk-forward: same script, other parameters
+// - Requires run() to have loaded data first
+// ====================================================== //
+
+void Interpreter::set_parameter_overrides(const std::unordered_map<std::string,double>& overrides){
+    parameterOverrides_ = overrides;
+}
+
+std::pair<std::vector<bool>,std::vector<bool>> Interpreter::evaluate_signals(const std::unordered_map<std::string,double>& overrides){
+    if (image_){
+        set_parameter_overrides(overrides);
+        eval_image_strategy(*image_);
+    } else {
+        const ASTRoot* root = tree_ ? tree_->root() : nullptr;
+        const Strategy* strategy = root ? node_cast<Strategy>(root->strategy) : nullptr;
+        if (!strategy){
+            throw std::runtime_error("Unable to evaluate signals: strategy block is missing.");
+        }
+
+        set_parameter_overrides(overrides);
+        eval_strategy(strategy);
+    }
+
+    auto entries = std::get_if<std::vector<bool>>(&variables_["Entry"]);
+    auto exits = std::get_if<std::vector<bool>>(&variables_["Exit"]);
+    if (!entries || !exits){
+        throw std::runtime_error("Entry/Exit conditions did not evaluate to boolean series.");
+    }
+
+    return {*entries, *exits};
+}
+// ====================================================== //
+
+// ------------------------------------------------------------------------------------------------------------------- //
+
 // ====================================================== //
 //                   Evaluate Indicators
 // - Loops through all assignments
 // - key -> function interpretor (appends to variables_) 
 // ====================================================== //
 
-void Interpreter::eval_indicators(const std::shared_ptr<ASTBlock>& block){
+void Interpreter::eval_indicators(const ASTBlock* block){
     
     // ==== Evaluates indicator section and expands indicator section ==== //
-    ExecutionContext ctx{variables_, data_, marketDataView_.data(), functionMap};
+    ExecutionContext ctx{variables_, data_, std::as_const(marketDataView_).data(), functionMap};
+    Visitor visitor(ctx);
     for (auto& [key,assignment] : block->entries){
 
         // ==== Loop through all key-value pair ==== //
-        if (auto assign_node = std::dynamic_pointer_cast<ASTAssignment>(assignment)){
+        if (auto assign_node = node_cast<ASTAssignment>(assignment)){
             // ==== If corresponding value is function call ==== //
-            auto function_node = std::dynamic_pointer_cast<ASTFunctionCall>(assign_node->expr);
-            if (function_node){
-                function_node->ctx = &ctx;
-                std::optional<std::shared_ptr<ASTNode>> func_ptr = function_node;
-                variables_[key] = function_node->eval_node(std::nullopt,std::nullopt,func_ptr);
+            if (auto function_node = node_cast<ASTFunctionCall>(assign_node->expr)){
+                variables_[key] = visitor.visit(*function_node);
             }
         }
     }
@@ -144,25 +220,22 @@ void Interpreter::eval_indicators(const std::shared_ptr<ASTBlock>& block){
 // -> "Config" + "Strategy" blocks
 // ====================================================== //
 
-void Interpreter::eval_program(const std::shared_ptr<ASTRoot>& root){
+void Interpreter::eval_program(const ASTRoot* root){
 
     // ==== Cast general purpose objects into their specific substructs ==== //
     if (root->config.has_value()) {
         g_logger.report("[INTERPRETER] Config evaluation started.");
-        auto config_block = std::dynamic_pointer_cast<ASTBlock>(root->config.value());
-        eval_config(config_block);
+        if (auto config_block = node_cast<ASTBlock>(root->config.value())) eval_config(config_block);
     }
 
     if (root->data) {
         g_logger.report("[INTERPRETER] Data fetch started.");
-        auto data_block = std::dynamic_pointer_cast<ASTList>(root->data);
-        marketDataView_.extract(data_block);
+        marketDataView_.extract(node_cast<ASTList>(root->data));
     }
 
     if (root->strategy){
         g_logger.report("[INTERPRETER] Strategy evaluation started.");
-        auto strategy_block = std::dynamic_pointer_cast<Strategy>(root->strategy);
-        eval_strategy(strategy_block);
+        if (auto strategy_block = node_cast<Strategy>(root->strategy)) eval_strategy(strategy_block);
     }
 };
 // ====================================================== //
@@ -176,13 +249,13 @@ void Interpreter::eval_program(const std::shared_ptr<ASTRoot>& root){
 // - Calls specified functions related to these blocks
 // ====================================================== //
 
-void Interpreter::eval_strategy(const std::shared_ptr<Strategy>& strategy){
+void Interpreter::eval_strategy(const Strategy* strategy){
 
     // ==== Interprets all internal blocks in strategy section ==== //
     // ==== Entry/Exit -> are necessary , others : indicators, parameters are optional ==== // 
 
     for (auto& block : strategy->blocks){
-        if (auto block_node = std::dynamic_pointer_cast<ASTBlock>(block)){
+        if (auto block_node = node_cast<ASTBlock>(block)){
             auto type = block_node->block_type.value();
             auto it = strategy_blocks.find(type);
 
@@ -203,7 +276,7 @@ void Interpreter::eval_strategy(const std::shared_ptr<Strategy>& strategy){
 // -> for key "ticker.*" retrives related data via API 
 // ====================================================== //
 
-void Interpreter::eval_parameters(const std::shared_ptr<ASTBlock>& block){
+void Interpreter::eval_parameters(const ASTBlock* block){
     
     // ====================================== //
     // If value is double -> put this in variable section
@@ -214,6 +287,10 @@ void Interpreter::eval_parameters(const std::shared_ptr<ASTBlock>& block){
     for (auto& [key,value] : block->entries){
         apply_kv(key, value, false);
     }
+
+    for (auto& [key,value] : parameterOverrides_){
+        variables_[key] = value;
+    }
 }
 // ====================================================== //
 
@@ -227,13 +304,17 @@ std::unordered_map<std::string,AnyValue>& Interpreter::get_variables() {
     return variables_;
 }
 
-std::unordered_map<std::string,AnyValue>& Interpreter::get_data() {
+const std::unordered_map<std::string,AnyValue>& Interpreter::get_data() const {
     return marketDataView_.data();
 }
 
 std::unordered_map<std::string,bool> Interpreter::get_flags(){
     return flags_;
 }
+
+config& Interpreter::get_config(){
+    return cfg_;
+}
 // ====================================================== //
 
 // ------------------------------------------------------------------------------------------------------------------- //
@@ -242,17 +323,19 @@ std::unordered_map<std::string,bool> Interpreter::get_flags(){
 //                   Evaluate Config Map
 // - Helper function for evaluate parameters
 // ====================================================== //
-void Interpreter::apply_kv(const std::string& key, const std::shared_ptr<ASTNode>& node, bool allow_nested){
-    if (auto value = std::dynamic_pointer_cast<ASTValueNode>(node)) {
+void Interpreter::apply_kv(const std::string& key, const ASTNode* node, bool allow_nested){
+    if (auto value = node_cast<ASTValueNode>(node)) {
         if (std::holds_alternative<double>(value->value)) {
             variables_[key] = std::get<double>(value->value);
         } else if (std::holds_alternative<bool>(value->value)) {
             flags_[key] = std::get<bool>(value->value);
+        } else if (std::holds_alternative<std::string>(value->value)) {
+            variables_[key] = std::get<std::string>(value->value);
         } else if (allow_nested && std::holds_alternative<NodeMap>(value->value)) {
             eval_config_map(std::get<NodeMap>(value->value));
         }
     } else if (allow_nested) {
-        if (auto block = std::dynamic_pointer_cast<ASTBlock>(node)) {
+        if (auto block = node_cast<ASTBlock>(node)) {
             eval_config_map(block->entries);
         }
     }
@@ -264,7 +347,79 @@ void Interpreter::eval_config_map(const NodeMap& map){
     }
 }
 
-void Interpreter::eval_config(const std::shared_ptr<ASTBlock>& block){
+void Interpreter::eval_config(const ASTBlock* block){
     eval_config_map(block->entries);
     cfg_.cfgValidator_.requiredCfgParametersCheckThenBuild(cfgRules,cfg_);
 }
+
+// ------------------------------------------------------------------------------------------------------------------- //
+
+// ====================================================== //
+//                  Evaluate Strategy Image
+// - Mirrors eval_program / eval_strategy block by block
+// - Expressions run on the image stack machine
+// ====================================================== //
+
+void Interpreter::apply_value(const strategyImage& image, const imageValue& value){
+    std::string key(image.text(value.key));
+    switch (value.type) {
+        case imageValueType::Number: variables_[key] = value.number; break;
+        case imageValueType::Bool:   flags_[key] = value.number != 0.0; break;
+        case imageValueType::Text:   variables_[key] = std::string(image.text(value.text)); break;
+    }
+}
+
+void Interpreter::eval_image(const strategyImage& image){
+    if (image.hasConfig()){
+        g_logger.report("[INTERPRETER] Config evaluation started.");
+        for (const auto& value : image.config()) apply_value(image, value);
+        cfg_.cfgValidator_.requiredCfgParametersCheckThenBuild(cfgRules,cfg_);
+    }
+
+    if (!image.data().empty()){
+        g_logger.report("[INTERPRETER] Data fetch started.");
+        marketDataView_.extract(image.requests());
+    }
+
+    g_logger.report("[INTERPRETER] Strategy evaluation started.");
+    eval_image_strategy(image);
+}
+
+void Interpreter::eval_image_strategy(const strategyImage& image){
+    ExecutionContext ctx{variables_, data_, std::as_const(marketDataView_).data(), functionMap};
+
+    for (const auto& block : image.blocks()){
+        switch (block.kind) {
+            case imageBlockKind::Config:
+                for (const auto& value : image.values().subspan(block.first, block.count)) apply_value(image, value);
+                cfg_.cfgValidator_.requiredCfgParametersCheckThenBuild(cfgRules,cfg_);
+                break;
+
+            case imageBlockKind::Parameters:
+                for (const auto& value : image.values().subspan(block.first, block.count)) apply_value(image, value);
+                for (auto& [key,value] : parameterOverrides_){
+                    variables_[key] = value;
+                }
+                break;
+
+            case imageBlockKind::Indicators:
+                for (const auto& assignment : image.assignments().subspan(block.first, block.count)){
+                    variables_[std::string(image.text(assignment.name))] = image.evaluate(assignment.first, assignment.count, ctx, stack_);
+                }
+                g_logger.report("[INTERPRETER] Indicators evaluated.");
+                break;
+
+            case imageBlockKind::Entry:
+                g_logger.report("[INTERPRETER] Entry evaluation started.");
+                if (block.count == 0) throw std::runtime_error("\"Entry\" condition is missing!");
+                variables_["Entry"] = image.evaluate(block.first, block.count, ctx, stack_);
+                break;
+
+            case imageBlockKind::Exit:
+                g_logger.report("[INTERPRETER] Exit evaluation started.");
+                if (block.count == 0) throw std::runtime_error("\"Exit\" condition is missing!");
+                variables_["Exit"] = image.evaluate(block.first, block.count, ctx, stack_);
+                break;
+        }
+    }
+}
@@ -3,12 +3,15 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <optional>
 #include <variant>
 #include "node/Node.hpp"
+#include "compiler/strategyImage.hpp"
+#include "compiler/strategyJit.hpp"
 #include "types/types.hpp"
 #include "mappers/maps.hpp"
 #include "config/config.hpp"
-#include "marketDataView/MarketDataView.hpp"
+#include "marketDataView/DataLayer.hpp"
 
 
 using Octurn::AnyValue;
@@ -22,46 +25,68 @@ class Interpreter {
         // ============= Constructor + Run + Getters ============ //
         // ===== Constructor takes root pointer to the tree ===== //
 
-        Interpreter(std::shared_ptr<ASTNode>& root, MarketDataView&& marketDataView);
+        Interpreter(std::shared_ptr<const syntaxTree> tree, MarketDataView&& marketDataView);
+        // ==== Runs a strategy image in place, its bytes must outlive the interpreter ==== //
+        Interpreter(const strategyImage& image, MarketDataView&& marketDataView);
         void run();
 
         // ========== Getters for variables and flags =========== //
         std::unordered_map<std::string,AnyValue>& get_variables();
-        std::unordered_map<std::string,AnyValue>& get_data();
+        const std::unordered_map<std::string,AnyValue>& get_data() const;
         std::unordered_map<std::string,bool> get_flags();
+        config& get_config();
+        // ====================================================== //
+
+        // ============ Re-evaluation on loaded data ============ //
+        // ==== Overrides win over the 'parameters' block values ==== //
+        void set_parameter_overrides(const std::unordered_map<std::string,double>& overrides);
+        // ==== Re-runs the strategy block only, market data is not fetched again ==== //
+        std::pair<std::vector<bool>,std::vector<bool>> evaluate_signals(const std::unordered_map<std::string,double>& overrides);
+        // ==== Native Entry/Exit kernels, the Visitor still runs whatever the JIT declines ==== //
+        void set_jit(std::shared_ptr<strategyJit> jit);
         // ====================================================== //
 
         // ================= Principal evaluators ================= // 
-        void eval_program(const std::shared_ptr<ASTRoot>& root);
-        void eval_config(const std::shared_ptr<ASTBlock>& block);
-        void eval_strategy(const std::shared_ptr<Strategy>& strategy);
-        void eval_parameters(const std::shared_ptr<ASTBlock>& block);
-        void eval_indicators(const std::shared_ptr<ASTBlock>& block);
+        void eval_program(const ASTRoot* root);
+        void eval_config(const ASTBlock* block);
+        void eval_strategy(const Strategy* strategy);
+        void eval_parameters(const ASTBlock* block);
+        void eval_indicators(const ASTBlock* block);
+
+        AnyValue eval_entry(const ASTBlock* block);
+        AnyValue eval_exit(const ASTBlock* block);
+        AnyValue eval_signal(const ASTNode& condition, const char* name);
 
-        AnyValue eval_entry(const std::shared_ptr<ASTBlock>& block);
-        AnyValue eval_exit(const std::shared_ptr<ASTBlock>& block);
+        // ==== Same evaluation order and results over a strategy image ==== //
+        void eval_image(const strategyImage& image);
+        void eval_image_strategy(const strategyImage& image);
 
         // =============== Principal evaluators END =============== // 
 
         // ================== Optional methods ==================== //
-        bool eval_condition(const std::shared_ptr<ASTNode>& node);
-        void execute_action(const std::shared_ptr<ASTAction>& action);
+        bool eval_condition(const ASTNode* node);
+        void execute_action(const ASTAction* action);
         void eval_config_map(const NodeMap& map);
-        void apply_kv(const std::string& key, const std::shared_ptr<ASTNode>& node, bool allow_nested);
+        void apply_kv(const std::string& key, const ASTNode* node, bool allow_nested);
+        void apply_value(const strategyImage& image, const imageValue& value);
         void build_config(std::unordered_map<std::string, Rule>::iterator& cfgIt,
         std::unordered_map<std::string, Octurn::AnyValue>::iterator& varIt);
         void required_config_parameteters_in();
         // ================ Optional methods END ================== //
 
 
-        std::unordered_map<Tokentype, std::function<void(const std::shared_ptr<ASTBlock>&)>> strategy_blocks;
+        std::unordered_map<Tokentype, std::function<void(const ASTBlock*)>> strategy_blocks;
 
 
     private:
         // ==== Environment to keep variables and flags ==== //
-        std::shared_ptr<ASTNode> root_;
+        std::shared_ptr<const syntaxTree> tree_;
+        std::optional<strategyImage> image_;
+        std::vector<AnyValue> stack_;
+        std::shared_ptr<strategyJit> jit_;
         std::unordered_map<std::string,AnyValue> variables_;
         std::unordered_map<std::string,bool> flags_;
+        std::unordered_map<std::string,double> parameterOverrides_;
         MarketDataView marketDataView_;
 
         // ==== Variable storage for each block ==== //
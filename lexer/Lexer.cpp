@@ -1,81 +1,151 @@
 #include "Lexer.hpp"
 #include <fstream>
-#include <iostream>
-#include <cctype>
-#include <unordered_map>
 #include <sstream>
-#include <string>
-#include <regex>
-
-// ==== Reverved words by DSL ==== //
-const std::unordered_map<std::string, Tokentype> Lexer::keywords_ = {
-    {"when", Tokentype::When},
-    {"crosses", Tokentype::Crosses},
-    {"above", Tokentype::Above},
-    {"below", Tokentype::Below},
-    {"buy", Tokentype::Buy},
-    {"sell", Tokentype::Sell},
-    {"all", Tokentype::All},
-    {"false", Tokentype::False},
-    {"true", Tokentype::True},
-    {"strategy", Tokentype::Strategy},
-    {"parameters", Tokentype::Parameters},
-    {"indicators", Tokentype::Indicators},
-    {"data", Tokentype::Data},
-    {"entry", Tokentype::Entry},
-    {"exit", Tokentype::Exit},
-    {"config", Tokentype::Config},
+#include <stdexcept>
+#include <format>
+
+// ====================================================== //
+//                 Character class table
+// ====================================================== //
+
+enum charClass : uint8_t {
+    CC_SPACE    = 1 << 0,
+    CC_NEWLINE  = 1 << 1,
+    CC_ALPHA    = 1 << 2,   // letters and '_'
+    CC_DIGIT    = 1 << 3,
+    CC_OPERATOR = 1 << 4    // + - * / > <
+};
+
+static constexpr std::array<uint8_t, 256> CHAR_CLASS = []{
+    std::array<uint8_t, 256> table{};
+    table[' '] = CC_SPACE;
+    table['\t'] = CC_SPACE;
+    table['\r'] = CC_SPACE;
+    table['\n'] = CC_NEWLINE;
+    for (int c = 'a'; c <= 'z'; c++) table[c] = CC_ALPHA;
+    for (int c = 'A'; c <= 'Z'; c++) table[c] = CC_ALPHA;
+    table['_'] = CC_ALPHA;
+    for (int c = '0'; c <= '9'; c++) table[c] = CC_DIGIT;
+    for (char c : std::string_view("+-*/><")) table[static_cast<uint8_t>(c)] = CC_OPERATOR;
+    return table;
+}();
+
+static constexpr bool is(char c, uint8_t mask) {
+    return CHAR_CLASS[static_cast<uint8_t>(c)] & mask;
+}
+
+// ====================================================== //
+//            Reserved words, perfect hash
+// - h = (len + 2 * first + 26 * last) & 63 is collision
+//   free over the set below (checked at compile time)
+// - "crosses" stays a keyword, as before the word operators
+// ====================================================== //
+
+struct reservedWord {
+    std::string_view word;
+    Tokentype type;
+    OperatorType op;
 };
 
-// ==== Defines operator types ==== //
-const std::unordered_map<std::string, OperatorType> Lexer::operators_ = {
-    // Logical operators
-    {"and", OperatorType::And},
-    {"or", OperatorType::Or},
-
-    // Comparison operators
-    {">", OperatorType::Greater},
-    {"<", OperatorType::Less},
-    {"==", OperatorType::Equal},
-
-    // Arithmetic operators
-    {"+", OperatorType::Plus},
-    {"-", OperatorType::Minus},
-    {"*", OperatorType::Multiply},
-    {"/", OperatorType::Divide},
-
-    // Special domain operators
-    {"crosses", OperatorType::Crosses},
-    {"crosses_above", OperatorType::CrossesAbove},
-    {"crosses_below", OperatorType::CrossesBelow}
+static constexpr reservedWord RESERVED[] = {
+    {"when", Tokentype::When, OperatorType::None},
+    {"crosses", Tokentype::Crosses, OperatorType::None},
+    {"above", Tokentype::Above, OperatorType::None},
+    {"below", Tokentype::Below, OperatorType::None},
+    {"buy", Tokentype::Buy, OperatorType::None},
+    {"sell", Tokentype::Sell, OperatorType::None},
+    {"all", Tokentype::All, OperatorType::None},
+    {"false", Tokentype::False, OperatorType::None},
+    {"true", Tokentype::True, OperatorType::None},
+    {"strategy", Tokentype::Strategy, OperatorType::None},
+    {"parameters", Tokentype::Parameters, OperatorType::None},
+    {"indicators", Tokentype::Indicators, OperatorType::None},
+    {"data", Tokentype::Data, OperatorType::None},
+    {"entry", Tokentype::Entry, OperatorType::None},
+    {"exit", Tokentype::Exit, OperatorType::None},
+    {"config", Tokentype::Config, OperatorType::None},
+    {"and", Tokentype::Operator, OperatorType::And},
+    {"or", Tokentype::Operator, OperatorType::Or},
+    {"crosses_above", Tokentype::Operator, OperatorType::CrossesAbove},
+    {"crosses_below", Tokentype::Operator, OperatorType::CrossesBelow},
+    {"for", Tokentype::For, OperatorType::None},
+    {"within", Tokentype::Within, OperatorType::None},
+    {"bars", Tokentype::Bars, OperatorType::None},
+    {"of", Tokentype::Of, OperatorType::None},
 };
 
-Lexer::Lexer(const std::string& strategy_text) : pos_(0), lineNum_(1), colNum_(1) {
-    // ==== Read strategy as string ==== //
-    input_ = strategy_text;
-    input_size_ = input_.size();
+#define RESERVED_SLOTS 64
+
+static constexpr size_t reservedHash(std::string_view word) {
+    return (word.size() + 2u * static_cast<uint8_t>(word.front()) + 26u * static_cast<uint8_t>(word.back())) & (RESERVED_SLOTS - 1);
+}
+
+// ==== Slot -> index into RESERVED + 1, 0 = empty ==== //
+static constexpr std::array<uint8_t, RESERVED_SLOTS> RESERVED_TABLE = []{
+    std::array<uint8_t, RESERVED_SLOTS> table{};
+    for (size_t i = 0; i < std::size(RESERVED); i++) table[reservedHash(RESERVED[i].word)] = static_cast<uint8_t>(i + 1);
+    return table;
+}();
+
+static constexpr bool reservedTableIsPerfect() {
+    size_t used{0};
+    for (auto slot : RESERVED_TABLE) used += (slot != 0);
+    return used == std::size(RESERVED);
+}
+static_assert(reservedTableIsPerfect(), "reserved word hash has a collision, pick new multipliers");
+
+static const reservedWord* findReserved(std::string_view word) {
+    const uint8_t slot = RESERVED_TABLE[reservedHash(word)];
+    if (slot == 0 || RESERVED[slot - 1].word != word) return nullptr;
+    return &RESERVED[slot - 1];
+}
+
+static OperatorType symbolOperator(char c) {
+    switch (c) {
+        case '+': return OperatorType::Plus;
+        case '-': return OperatorType::Minus;
+        case '*': return OperatorType::Multiply;
+        case '/': return OperatorType::Divide;
+        case '>': return OperatorType::Greater;
+        case '<': return OperatorType::Less;
+        default:  return OperatorType::None;
+    }
+}
+
+// ====================================================== //
+
+Lexer::Lexer(std::string strategy_text) : source_(std::move(strategy_text)), pos_(0), lineNum_(1), colNum_(1) {
     tokenize();
 }
 
 void Lexer::read_file_to_string(const std::string& filename) {
     std::ifstream file(filename);
     if (!file) {
-        std::cerr << "Error: Could not open file '" << filename << "'\n";
-        return;
+        throw std::runtime_error(std::format("Could not open file '{}'", filename));
     }
     std::stringstream buffer;
-    buffer << file.rdbuf(); // Считываем весь файл в строковый поток
+    buffer << file.rdbuf();
 
-    input_ = buffer.str();
+    source_ = buffer.str();
+    pos_ = 0;
+    lineNum_ = 1;
+    colNum_ = 1;
+    tokens_.clear();
+    tokenize();
+}
+
+void Lexer::advance(size_t count) {
+    pos_ += count;
+    colNum_ += count;
 }
 
 void Lexer::skip_whitespace() {
-    while (pos_ < input_size_) {
-        char c = input_[pos_];
-        if (c == ' ' || c == '\t') {
+    while (pos_ < source_.size()) {
+        const char c = source_[pos_];
+        if (is(c, CC_SPACE)) {
             ++pos_;
             ++colNum_;
-        } else if (c == '\n') {
+        } else if (is(c, CC_NEWLINE)) {
             ++pos_;
             ++lineNum_;
             colNum_ = 1;
@@ -85,138 +155,106 @@ void Lexer::skip_whitespace() {
     }
 }
 
-
-std::string Lexer::get_word_or_symbol() {
-    size_t start = pos_;
-
-    // Word or '_'
-    if (std::isalpha(input_[pos_]) || input_[pos_] == '_') {
-        while (pos_ < input_size_ && (std::isalnum(input_[pos_]) || input_[pos_] == '_')) {
-            ++pos_;
-            ++colNum_;
-        }
-    } 
-    // Operator-symbol (+ - * / > < >= <=)
-    else if (std::string("+-*/><=").find(input_[pos_]) != std::string::npos) {
-        ++pos_;
-        ++colNum_;
-
-        if (pos_ < input_size_ && input_[pos_] == '=') { // for "==", ">=", "<="
-            ++pos_;
-            ++colNum_;
-        }
-    } 
-    // Special symbols
-    else {
-        ++pos_;
-        ++colNum_;
-    }
-
-    return input_.substr(start, pos_ - start);
+std::string_view Lexer::get_word() {
+    const size_t start = pos_;
+    while (pos_ < source_.size() && is(source_[pos_], CC_ALPHA | CC_DIGIT)) ++pos_;
+    colNum_ += pos_ - start;
+    return std::string_view(source_).substr(start, pos_ - start);
 }
 
-
-std::string Lexer::get_number() {
-    size_t start = pos_;
-    while (pos_ < input_size_ && std::isdigit(input_[pos_])) {
-        ++pos_;
-        ++colNum_;
-    }
-    return input_.substr(start, pos_ - start);
+std::string_view Lexer::get_number() {
+    const size_t start = pos_;
+    while (pos_ < source_.size() && is(source_[pos_], CC_DIGIT)) ++pos_;
+    colNum_ += pos_ - start;
+    return std::string_view(source_).substr(start, pos_ - start);
 }
 
 // ====================================================== //
 //                     Get Date 
-// - Returns date as string
+// - The whole run of digits and '-' must be YYYY-MM-DD
 // - Doesn't move position till it's confirmed to be a date
-// - Format : %Y-%M-%D
 // ====================================================== //
 
-std::string Lexer::get_date() {
-    
-    size_t start = pos_;
-    size_t tmp_pos = pos_;
-    size_t tmp_colNum = colNum_;
+std::string_view Lexer::get_date() {
+    size_t end = pos_;
+    while (end < source_.size() && (is(source_[end], CC_DIGIT) || source_[end] == '-')) ++end;
 
-    while (tmp_pos < input_size_ && (std::isdigit(input_[tmp_pos])||input_[tmp_pos] == '-')) {
-        ++tmp_pos;
-        ++tmp_colNum;
+    if (end - pos_ != 10) return {};
+    const std::string_view date = std::string_view(source_).substr(pos_, 10);
+    for (size_t i = 0; i < date.size(); i++) {
+        const bool dash = (i == 4 || i == 7);
+        if (dash ? date[i] != '-' : !is(date[i], CC_DIGIT)) return {};
     }
-    auto date = input_.substr(start, tmp_pos - start);
-    if (std::regex_match(date,std::regex(R"(^\d{4}-\d{2}-\d{2}$)"))){
-            colNum_ = tmp_colNum;
-            pos_ = tmp_pos;
-            return date;
-        }
-    return "";
-}
-// ====================================================== //
-
 
-bool Lexer::is_operator_symbol(char character) {
-    return std::string("+-*/><").find(character) != std::string::npos;
+    advance(10);
+    return date;
 }
+// ====================================================== //
 
 Token Lexer::next_token() {
     skip_whitespace();
-    if (pos_ >= input_size_) return {Tokentype::End, "", lineNum_, colNum_};
+    if (pos_ >= source_.size()) return {Tokentype::End, {}, lineNum_, colNum_};
 
-    char c = input_[pos_];
-    size_t startCol = colNum_;
+    const char c = source_[pos_];
+    const size_t startCol = colNum_;
+    const uint8_t cls = CHAR_CLASS[static_cast<uint8_t>(c)];
 
-    // ====== Symbol operators ( >, <, >=, <=, +, -, * etc ) ======
-    if (is_operator_symbol(c)) {
-        std::string symbol = get_word_or_symbol(); 
-        auto it_operator_type = operators_.find(symbol);
-        if (it_operator_type != operators_.end()) {
-            return {Tokentype::Operator, symbol, lineNum_, startCol, it_operator_type->second};
+    // ====== Symbol operators ( +, -, *, /, >, < ) ======
+    if (cls & CC_OPERATOR) {
+        const bool compound = pos_ + 1 < source_.size() && source_[pos_ + 1] == '=';
+        const std::string_view symbol = std::string_view(source_).substr(pos_, compound ? 2 : 1);
+        advance(symbol.size());
+        if (!compound) {
+            return {Tokentype::Operator, symbol, lineNum_, startCol, symbolOperator(c)};
         }
-    } else if (std::isalpha(c) || c == '_'){
-        std::string word = get_word_or_symbol();
-
-        auto it_keywords = keywords_.find(word);
-        auto it_operator_type = operators_.find(word);
+        // ">=", "<=" ... are not part of the language yet
+        return {Tokentype::End, {}, lineNum_, startCol};
+    }
 
-        if (it_keywords != keywords_.end()) {
-            return {it_keywords->second, word, lineNum_, startCol};
-        } else if (it_operator_type != operators_.end()){
-            return {Tokentype::Operator, word, lineNum_, startCol, it_operator_type->second};
-        }
-        else {
-            return {Tokentype::Identifier, word, lineNum_, startCol};
+    if (cls & CC_ALPHA) {
+        const std::string_view word = get_word();
+        if (const auto* reserved = findReserved(word)) {
+            if (reserved->op != OperatorType::None) {
+                return {Tokentype::Operator, word, lineNum_, startCol, reserved->op};
+            }
+            return {reserved->type, word, lineNum_, startCol};
         }
-    } else if (std::isdigit(c)) {
-        auto date = get_date();
-        if (!date.empty()){
-            return {Tokentype::Date,date,lineNum_, startCol};
+        return {Tokentype::Identifier, word, lineNum_, startCol};
+    }
+
+    if (cls & CC_DIGIT) {
+        const std::string_view date = get_date();
+        if (!date.empty()) {
+            return {Tokentype::Date, date, lineNum_, startCol};
         }
-        std::string number = get_number();
-        return {Tokentype::Number, number, lineNum_, startCol};
+        return {Tokentype::Number, get_number(), lineNum_, startCol};
     }
+
     // ====== Punctuation ======
+    const std::string_view single = std::string_view(source_).substr(pos_, 1);
+    advance();
     switch (c) {
-        case '(': ++pos_; ++colNum_; return {Tokentype::LeftParen, "(", lineNum_, startCol};
-        case ')': ++pos_; ++colNum_; return {Tokentype::RightParen, ")", lineNum_, startCol};
-        case ',': ++pos_; ++colNum_; return {Tokentype::Comma, ",", lineNum_, startCol};
-        case '{': ++pos_; ++colNum_; return {Tokentype::LeftBrace, "{", lineNum_, startCol};
-        case '}': ++pos_; ++colNum_; return {Tokentype::RightBrace, "}", lineNum_, startCol};
-        case ':': ++pos_; ++colNum_; return {Tokentype::Colon, ":", lineNum_, startCol};
-        case '=': ++pos_; ++colNum_; return {Tokentype::Equals, "=", lineNum_, startCol};
-        case '[': ++pos_; ++colNum_; return {Tokentype::LeftSBracket, "[", lineNum_, startCol};
-        case ']': ++pos_; ++colNum_; return {Tokentype::RightSBracket, "]", lineNum_, startCol};
+        case '(': return {Tokentype::LeftParen, single, lineNum_, startCol};
+        case ')': return {Tokentype::RightParen, single, lineNum_, startCol};
+        case ',': return {Tokentype::Comma, single, lineNum_, startCol};
+        case '{': return {Tokentype::LeftBrace, single, lineNum_, startCol};
+        case '}': return {Tokentype::RightBrace, single, lineNum_, startCol};
+        case ':': return {Tokentype::Colon, single, lineNum_, startCol};
+        case '=': return {Tokentype::Equals, single, lineNum_, startCol};
+        case '[': return {Tokentype::LeftSBracket, single, lineNum_, startCol};
+        case ']': return {Tokentype::RightSBracket, single, lineNum_, startCol};
     }
 
     // ====== Unknown character ======
-    ++pos_;
-    ++colNum_;
-    return {Tokentype::End, "", lineNum_, startCol};
+    return {Tokentype::End, {}, lineNum_, startCol};
 }
 
 void Lexer::tokenize() {
+    // ==== Rough upper bound, avoids regrowth on long scripts ==== //
+    tokens_.reserve(source_.size() / 3 + 1);
     while (true) {
-        Token token = next_token();
-        tokens_.push_back(token);
-        if (token.token_type == Tokentype::End)
+        tokens_.push_back(next_token());
+        if (tokens_.back().token_type == Tokentype::End)
             break;
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <optional>
 #include <unordered_map>
 
@@ -14,7 +15,8 @@ enum class Tokentype {
     Colon,When,Crosses,Above,Below,
     Buy,Sell,All,Strategy,Parameters,
     Indicators, Entry, Exit, Config, False, True,
-    Equals,Function,Operator,Ticker,String, Data, Date
+    Equals,Function,Operator,Ticker,String, Data, Date,
+    For, Within, Bars, Of
 };
 
 // ================================================
@@ -60,7 +62,7 @@ struct Token {
 
     // ==== Token characteristics ==== //
     Tokentype token_type;
-    std::string value;
+    std::string_view value;     // view into the Lexer's source buffer
 
     // ==== Track token position ==== //
     size_t lineNum;
@@ -109,7 +111,11 @@ inline std::string to_string(Tokentype type) {
         case Tokentype::RightSBracket: return "RightSBracket";
         case Tokentype::LeftSBracket: return "LeftSBracket";
         case Tokentype::Date: return "Date";
-        case Tokentype::Operator: return "Operator";      
+        case Tokentype::Operator: return "Operator";
+        case Tokentype::For: return "For";
+        case Tokentype::Within: return "Within";
+        case Tokentype::Bars: return "Bars";
+        case Tokentype::Of: return "Of";
         default: return "Unknown";
     }
 }
@@ -234,3 +234,85 @@ inline std::unordered_map<std::string, OperatorVariant> OperatorMap {
     {"and", OpAnd{}},
     {"or", OpOr{}}
 };
+
+// ==== Applies a resolved operator, compare_vectors_values() looks it up by symbol first ==== //
+AnyValue apply_operator(AnyValue& left, AnyValue& right, const OperatorVariant& functor);
+
+// ============================================================================================ //
+//                                   Typed kernels
+// Chosen by the semantic pass once operand shapes are known -> no variant dispatch, no
+// broadcast copy of scalars, no modulo indexing when both series have the same length
+// ** A value of another shape than expected (e.g. a variable rebound at runtime) falls back
+//    to apply_operator(), so a kernel never changes the result **
+// ============================================================================================ //
+
+template <typename T>
+struct is_series : std::false_type {};
+
+template <typename T>
+struct is_series<std::vector<T>> : std::true_type {};
+
+template <typename Op, typename L, typename R>
+AnyValue typed_kernel(AnyValue& left, AnyValue& right){
+    const auto* lhs = std::get_if<L>(&left);
+    const auto* rhs = std::get_if<R>(&right);
+    if (!lhs || !rhs) return apply_operator(left, right, Op{});
+
+    Op op;
+    if constexpr (!is_series<L>::value && !is_series<R>::value) {
+        return AnyValue{op(*lhs, *rhs)};
+    } else if constexpr (is_series<L>::value && is_series<R>::value) {
+        if (lhs->size() != rhs->size()) return vector_op(*lhs, *rhs, op);
+
+        std::vector<decltype(op((*lhs)[0], (*rhs)[0]))> result(lhs->size());
+        for (size_t i = 0; i < lhs->size(); ++i) result[i] = op((*lhs)[i], (*rhs)[i]);
+        return AnyValue{std::move(result)};
+    } else if constexpr (is_series<L>::value) {
+        std::vector<decltype(op((*lhs)[0], *rhs))> result(lhs->size());
+        for (size_t i = 0; i < lhs->size(); ++i) result[i] = op((*lhs)[i], *rhs);
+        return AnyValue{std::move(result)};
+    } else {
+        std::vector<decltype(op(*lhs, (*rhs)[0]))> result(rhs->size());
+        for (size_t i = 0; i < rhs->size(); ++i) result[i] = op(*lhs, (*rhs)[i]);
+        return AnyValue{std::move(result)};
+    }
+}
+
+// ============================================================================================ //
+//                                   Series views
+// Operands read in place (a stored series, possibly lagged) instead of copied into an AnyValue
+// ** Same functors and element order as vector_op() on equal lengths, invalid bars read NaN **
+// ============================================================================================ //
+
+inline double view_at(const Octurn::seriesView& view, size_t i) { return view[i]; }
+inline double view_at(double value, size_t) { return value; }
+
+// ==== No validity check: only past the lag of every operand ==== //
+inline double view_valid_at(const Octurn::seriesView& view, size_t i) { return view.data[i - view.lag]; }
+inline double view_valid_at(double value, size_t) { return value; }
+
+inline size_t view_size(const Octurn::seriesView& view) { return view.size; }
+inline size_t view_size(double) { return 0; }
+
+inline size_t view_lag(const Octurn::seriesView& view) { return view.lag; }
+inline size_t view_lag(double) { return 0; }
+
+// ==== L / R: seriesView or double, at least one view (same length when both) ==== //
+template <typename L, typename R>
+AnyValue view_operator(const L& left, const R& right, const OperatorVariant& functor){
+    const size_t size = std::max(view_size(left), view_size(right));
+    const size_t valid = std::min(size, std::max(view_lag(left), view_lag(right)));
+
+    return std::visit([&](const auto& op) -> AnyValue {
+        std::vector<decltype(op(view_at(left, 0), view_at(right, 0)))> result(size);
+        for (size_t i = 0; i < valid; ++i) result[i] = op(view_at(left, i), view_at(right, i));
+        for (size_t i = valid; i < size; ++i) result[i] = op(view_valid_at(left, i), view_valid_at(right, i));
+        return AnyValue{std::move(result)};
+    }, functor);
+}
+
+// ==== Shape of 'left op right', Unknown when the operator rejects these operands ==== //
+Octurn::valueType binary_result_type(const std::string& op, Octurn::valueType left, Octurn::valueType right);
+
+// ==== nullptr when no kernel exists for this combination ==== //
+Octurn::binaryKernel select_kernel(const std::string& op, Octurn::valueType left, Octurn::valueType right);
@@ -1,4 +1,6 @@
 #include "logHandler.hpp"
+#include <chrono>
+#include <ctime>
 #include <iostream>
 
 
@@ -17,6 +19,7 @@ void logHandler::create_file(){
 }
 
 void logHandler::report(std::string message){
+    std::lock_guard<std::mutex> lock(mutex_);
     if(file.is_open()){
         file << "[ " + current_time() + " ] " + message +"\n";
         file.flush();
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <fstream>
+#include <mutex>
 
 class logHandler {
     public:
@@ -10,6 +11,7 @@ class logHandler {
         void create_file();
         std::string current_time();
         std::ofstream file;
+        std::mutex mutex_;   // report() is called from thread pool workers
 
 };
 
@@ -1,13 +1,318 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 #include "engine/octurn.hpp"
+#include "interpreter/Interpreter.hpp"
+#include "node/Node.hpp"
+#include "engine/batchRunner.hpp"
+#include "backtester/walkForward.hpp"
+#include "lexer/Lexer.hpp"
+#include "parser/Parser.hpp"
+#include "marketDataView/DataLayer.hpp"
+#include "gateway/fixGateway.hpp"
+#include "gateway/fixAcceptorSim.hpp"
+#include "compiler/strategyJit.hpp"
 
-int main() {
+// ====================================================== //
+//                      Batch mode
+// Octurn --batch [--threads N] [--jit|--jit-verify] [--out report.json] [--curves] a.oct b.oct ...
+// - API key is read from OCTURN_API_KEY
+// ====================================================== //
+
+// ==== --jit: native Entry/Exit kernels, --jit-verify: also run the Visitor and fail on any difference ==== //
+static bool jitFlag(const std::string& arg, std::shared_ptr<strategyJit>& jit) {
+    if (arg != "--jit" && arg != "--jit-verify") return false;
+    jitOptions options;
+    options.verify = arg == "--jit-verify";
+    jit = std::make_shared<strategyJit>(options);
+    return true;
+}
+
+static int runBatch(int argc, char** argv, const std::string& api_key) {
+    size_t threads = 0;
+    std::string out;
+    bool curves = false;
+    std::vector<std::string> files;
+    std::shared_ptr<strategyJit> jit;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (jitFlag(arg, jit)) continue;
+        if (arg == "--threads" && i + 1 < argc) threads = std::stoul(argv[++i]);
+        else if (arg == "--out" && i + 1 < argc) out = argv[++i];
+        else if (arg == "--curves") curves = true;
+        else files.push_back(arg);
+    }
+
+    if (files.empty()) {
+        std::cerr << "Usage: Octurn --batch [--threads N] [--jit|--jit-verify] [--out report.json] [--curves] <strategy files...>\n";
+        return 1;
+    }
+
+    try {
+        batchRunner runner(api_key, threads);
+        runner.setJit(jit);
+        for (const auto& file : files) runner.addFile(file);
+
+        const auto report = batchReport(runner.run(), curves).dump(2);
+        if (out.empty()) {
+            std::cout << report << "\n";
+        } else {
+            std::ofstream(out) << report << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Batch failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+// ====================================================== //
+//                   Walk-forward mode
+// Octurn --walkforward --window N --step M [--anchored] [--threads N] [--jit|--jit-verify]
+//        [--param name=v1,v2,...]... [--out report.json] [--curves] a.oct
+// - window: in-sample bars, step: out-of-sample bars, the
+//   windows roll forward by `step`
+// - Each --param adds one axis of the grid swept in-sample
+// ====================================================== //
+
+static void addGridAxis(parameterGrid& grid, const std::string& arg) {
+    const auto eq = arg.find('=');
+    if (eq == std::string::npos || eq == 0) {
+        throw std::runtime_error(std::format("--param expects name=v1,v2,... got '{}'", arg));
+    }
+
+    auto& values = grid[arg.substr(0, eq)];
+    std::stringstream list(arg.substr(eq + 1));
+    for (std::string value; std::getline(list, value, ',');) {
+        values.push_back(std::stod(value));
+    }
+}
+
+static int runWalkForward(int argc, char** argv, const std::string& api_key) {
+    walkForwardOptions options;
+    parameterGrid grid;
+    std::string out;
+    std::string file;
+    bool curves = false;
+
+    try {
+        for (int i = 2; i < argc; i++) {
+            std::string arg = argv[i];
+            if (jitFlag(arg, options.jit)) continue;
+            if (arg == "--window" && i + 1 < argc) options.inSampleBars = std::stoul(argv[++i]);
+            else if (arg == "--step" && i + 1 < argc) options.outOfSampleBars = std::stoul(argv[++i]);
+            else if (arg == "--anchored") options.anchored = true;
+            else if (arg == "--threads" && i + 1 < argc) options.threads = std::stoul(argv[++i]);
+            else if (arg == "--param" && i + 1 < argc) addGridAxis(grid, argv[++i]);
+            else if (arg == "--out" && i + 1 < argc) out = argv[++i];
+            else if (arg == "--curves") curves = true;
+            else file = arg;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Bad walk-forward arguments: " << e.what() << "\n";
+        return 1;
+    }
+
+    if (file.empty() || options.inSampleBars == 0 || options.outOfSampleBars == 0) {
+        std::cerr << "Usage: Octurn --walkforward --window N --step M [--anchored] [--threads N] [--jit|--jit-verify] "
+                     "[--param name=v1,v2,...] [--out report.json] [--curves] <strategy file>\n";
+        return 1;
+    }
+
+    try {
+        std::ifstream source(file);
+        if (!source) throw std::runtime_error(std::format("Could not open strategy file '{}'", file));
+        std::stringstream script;
+        script << source.rdbuf();
+
+        Lexer lexer(script.str());
+        Parser parser(lexer.get_tokens());
+        const auto results = walkForwardScript(parser.parse(), MarketDataView(api_key), grid, options);
+
+        const auto report = walkForwardReport(results, curves).dump(2);
+        if (out.empty()) {
+            std::cout << report << "\n";
+        } else {
+            std::ofstream(out) << report << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Walk-forward failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+// ====================================================== //
+//                      Paper mode
+// Octurn --paper [--fix42] [--port P] [--qty Q] a.oct b.oct ...
+// - Traded ticker = first entry of each script's data block
+// - Every script's bars are replayed in timestamp order: an
+//   Entry while flat buys Q, an Exit while long flattens
+// - Without --port a local acceptor simulator is started,
+//   priced at each bar's close before its decisions, each
+//   order waits up to PAPER_REPLY_TIMEOUT_MS for its answer
+// ====================================================== //
+
+struct paperDecision {
+    int64_t stamp;
+    uint32_t tickerId;
+    action decision;
+    double close;
+};
+
+static std::string readScript(const std::string& file) {
+    std::ifstream source(file);
+    if (!source) throw std::runtime_error(std::format("Could not open strategy file '{}'", file));
+    std::stringstream script;
+    script << source.rdbuf();
+    return script.str();
+}
+
+// ==== One script's flat/long transitions, the gateway only sees state changes ==== //
+static void collectDecisions(const std::string& file, const std::string& api_key, fixGateway& gateway,
+                             std::vector<std::string>& tickers, std::vector<paperDecision>& decisions) {
+    Lexer lexer(readScript(file));
+    Parser parser(lexer.get_tokens());
+    const auto tree = parser.parse();
+
+    const ASTRoot* root = tree ? tree->root() : nullptr;
+    const auto requests = MarketDataView::requests(root ? node_cast<ASTList>(root->data) : nullptr);
+    if (requests.empty()) throw std::runtime_error(std::format("'{}' has no data block", file));
+    const std::string& ticker = requests.front().ticker;
+
+    Interpreter interpreter(tree, MarketDataView(api_key));
+    interpreter.run();
+
+    auto& variables = interpreter.get_variables();
+    auto entries = std::get_if<std::vector<bool>>(&variables["Entry"]);
+    auto exits = std::get_if<std::vector<bool>>(&variables["Exit"]);
+    if (!entries || !exits) {
+        throw std::runtime_error(std::format("'{}': Entry/Exit conditions did not evaluate to boolean series.", file));
+    }
+
+    const auto& data = interpreter.get_data();
+    const auto& stamps = std::get<Octurn::timeSeries>(data.at(MarketDataView::makeField(ticker, "timestamp")));
+    const auto& closes = std::get<std::vector<double>>(data.at(MarketDataView::makeField(ticker, "close")));
+    const size_t bars = std::min({stamps.size(), closes.size(), entries->size(), exits->size()});
+
+    const uint32_t tickerId = gateway.addTicker(ticker);
+    if (tickerId == tickers.size()) tickers.push_back(ticker);
+
+    bool holding = false;
+    for (size_t i = 0; i < bars; i++) {
+        if (!holding && (*entries)[i]) {
+            decisions.push_back({stamps[i], tickerId, action::Entry, closes[i]});
+            holding = true;
+        } else if (holding && (*exits)[i]) {
+            decisions.push_back({stamps[i], tickerId, action::Exit, closes[i]});
+            holding = false;
+        }
+    }
+}
+
+#define PAPER_REPLY_TIMEOUT_MS 5000
+
+static int runPaper(int argc, char** argv, const std::string& api_key) {
+    fixSessionSettings settings;
+    double qty = 10.0;
+    bool external = false;
+    std::vector<std::string> files;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--fix42") settings.version = fixVersion::FIX42;
+        else if (arg == "--qty" && i + 1 < argc) qty = std::stod(argv[++i]);
+        else if (arg == "--port" && i + 1 < argc) { settings.port = static_cast<uint16_t>(std::stoul(argv[++i])); external = true; }
+        else files.push_back(arg);
+    }
+
+    if (files.empty() || qty <= 0.0) {
+        std::cerr << "Usage: Octurn --paper [--fix42] [--port P] [--qty Q] <strategy files...>\n";
+        return 1;
+    }
+
+    try {
+        fixAcceptorSim simulator(settings.version);
+        if (!external) {
+            simulator.start();
+            settings.port = simulator.port();
+        }
+
+        std::unordered_map<std::string, AnyValue> variables;
+        config cfg(&variables);
+        account paperAccount(100000.0);
+        fixGateway gateway(paperAccount, cfg, settings);
+
+        std::vector<std::string> tickers;
+        std::vector<paperDecision> decisions;
+        for (const auto& file : files) collectDecisions(file, api_key, gateway, tickers, decisions);
+        std::stable_sort(decisions.begin(), decisions.end(),
+            [](const paperDecision& a, const paperDecision& b) { return a.stamp < b.stamp; });
+
+        gateway.start();
+
+        size_t applied = 0;
+        for (const auto& decision : decisions) {
+            if (!external) simulator.setPrice(tickers[decision.tickerId], decision.close);
+            if (gateway.onDecision(decision.tickerId, decision.decision, qty) == FIX_NO_ORDER) continue;
+
+            // ==== The simulator prices on receipt: let it answer before the next bar reprices it ==== //
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(PAPER_REPLY_TIMEOUT_MS);
+            while (!external && simulator.ordersFilled() + simulator.ordersRejected() < gateway.ordersSent()) {
+                if (!gateway.loggedOn()) throw std::runtime_error("FIX session logged off while an order was pending");
+                if (std::chrono::steady_clock::now() > deadline) {
+                    throw std::runtime_error(std::format("No answer to order {} within {} ms", gateway.ordersSent(), PAPER_REPLY_TIMEOUT_MS));
+                }
+                std::this_thread::yield();
+            }
+            applied += gateway.poll();
+        }
+        gateway.stop();
+        applied += gateway.poll();
+
+        const auto stats = gateway.latency();
+        std::cout << std::format("decisions: {}, orders sent: {}, reports applied: {}, rejected: {}, free cash: {:.2f}\n",
+            decisions.size(), gateway.ordersSent(), applied, gateway.ordersRejected(), paperAccount.availableFreeCash());
+        std::cout << std::format("signal-to-wire us: mean {:.1f} p50 {:.1f} p99 {:.1f} max {:.1f}\n",
+            stats.meanUs, stats.p50Us, stats.p99Us, stats.maxUs);
+    } catch (const std::exception& e) {
+        std::cerr << "Paper session failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv) {
+
+    const char* env_key = std::getenv("OCTURN_API_KEY");
+    std::string api_key = env_key ? env_key : "fOCoE61aBE9Ndpln9eFMWwAKPH682n4T";
+
+    if (argc > 1 && std::string(argv[1]) == "--batch") {
+        return runBatch(argc, argv, api_key);
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--walkforward") {
+        return runWalkForward(argc, argv, api_key);
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--paper") {
+        return runPaper(argc, argv, api_key);
+    }
 
     std::string script = "config { equity: 100 positionSize: 1 slippageBps: 10 } data [ { ticker: AAPL timespan: day multiplier: 1 from: 2025-09-01 to: 2025-10-27}, { ticker: MSFT timespan: day multiplier: 1 from: 2025-08-01 to: 2025-10-27} ] strategy SimpleMA { parameters { fast_ma: 5 slow_ma: 30 } indicators {RSI1=RSI(AAPL_close,12)} entry {when RSI1>50} exit {when RSI1>250}}";
 
-    std::string api_key = "fOCoE61aBE9Ndpln9eFMWwAKPH682n4T";
     octurn engine = octurn(script, api_key);
-    
+
     engine.run();
 }
@@ -1,4 +1,4 @@
-#include "MarketDataView.hpp"
+#include "DataLayer.hpp"
 
 #include <format>
 #include <stdexcept>
@@ -6,6 +6,7 @@
 
 #include "node/Node.hpp"
 #include "src/polygon/polygonClient.hpp"
+#include "utils/timeIndex.hpp"
 
 using Octurn::AnyValue;
 
@@ -27,54 +28,89 @@ Bar MarketDataView::getBar(const std::string& ticker, size_t idx) {
     };
 }
 
-void MarketDataView::extract(const std::shared_ptr<ASTList>& list) {
+MarketDataView::MarketDataView(std::shared_ptr<const std::unordered_map<std::string, AnyValue>> shared)
+    : feeder_(polygonClient(std::string{})), shared_(std::move(shared)) {}
+
+std::vector<dataRequest> MarketDataView::requests(const ASTList* list) {
+    std::vector<dataRequest> out;
     if (!list) {
-        return;
+        return out;
     }
 
-    for (auto& data_block : list->list) {
-        std::string ticker, timespan, from, to;
-        int multiplier = 0;
+    for (const ASTNode* data_block : list->list) {
+        dataRequest request;
 
-        if (auto fetching_params_node = std::dynamic_pointer_cast<ASTBlock>(data_block)) {
+        if (auto fetching_params_node = node_cast<ASTBlock>(data_block)) {
             auto& fetching_params = fetching_params_node->entries;
             for (auto& [key, value] : fetching_params) {
-                if (auto value_node = std::dynamic_pointer_cast<ASTValueNode>(value)) {
+                if (auto value_node = node_cast<ASTValueNode>(value)) {
                     if (std::holds_alternative<std::string>(value_node->value)) {
                         std::string strVal = std::get<std::string>(value_node->value);
-                        if (key == "ticker") ticker = strVal;
-                        else if (key == "from") from = strVal;
-                        else if (key == "to") to = strVal;
-                        else if (key == "timespan") timespan = strVal;
+                        if (key == "ticker") request.ticker = strVal;
+                        else if (key == "from") request.from = strVal;
+                        else if (key == "to") request.to = strVal;
+                        else if (key == "timespan") request.timespan = strVal;
                     } else if (std::holds_alternative<double>(value_node->value)) {
                         if (key == "multiplier") {
-                            multiplier = static_cast<int>(std::get<double>(value_node->value));
+                            request.multiplier = static_cast<int>(std::get<double>(value_node->value));
                         }
                     }
                 }
             }
         }
 
-        if (ticker.empty()) {
+        if (request.ticker.empty()) {
             throw std::runtime_error("No ticker found");
         }
 
-        auto fetched = feeder_.loadBars(ticker, multiplier, from, to, timespan);
-        dataMap_.merge(std::move(fetched));
+        out.push_back(std::move(request));
+    }
+
+    return out;
+}
+
+void MarketDataView::load(const dataRequest& request) {
+    if (shared_) {
+        throw std::runtime_error("Market data is shared read-only, nothing can be loaded into it");
+    }
+
+    auto fetched = feeder_.loadBars(request.ticker, request.multiplier, request.from, request.to, request.timespan);
+    dataMap_.merge(std::move(fetched));
+}
+
+void MarketDataView::extract(const ASTList* list) {
+    extract(requests(list));
+}
+
+void MarketDataView::extract(const std::vector<dataRequest>& requests) {
+    for (const auto& request : requests) {
+        if (!shared_) {
+            load(request);
+        } else if (!shared_->contains(makeField(request.ticker, "timestamp"))) {
+            throw std::runtime_error(std::format("Ticker {} is missing from the shared dataset", request.ticker));
+        }
     }
 }
 
+bool MarketDataView::isShared() const {
+    return static_cast<bool>(shared_);
+}
+
 std::unordered_map<std::string, AnyValue>& MarketDataView::data() {
+    if (shared_) {
+        throw std::runtime_error("Market data is shared read-only");
+    }
     return dataMap_;
 }
 
 const std::unordered_map<std::string, AnyValue>& MarketDataView::data() const {
-    return dataMap_;
+    return shared_ ? *shared_ : dataMap_;
 }
 
 double MarketDataView::getValue(const std::string& key, size_t idx) const {
-    auto it = dataMap_.find(key);
-    if (it == dataMap_.end()) {
+    const auto& dataMap = data();
+    auto it = dataMap.find(key);
+    if (it == dataMap.end()) {
         throw std::runtime_error(std::format("Series {} not found", key));
     }
 
@@ -86,3 +122,27 @@ double MarketDataView::getValue(const std::string& key, size_t idx) const {
 
     return series[idx];
 }
+
+const Octurn::timeSeries& MarketDataView::timestamps(const std::string& ticker) const {
+    const std::string key = makeField(ticker, "timestamp");
+    const auto& dataMap = data();
+    auto it = dataMap.find(key);
+    if (it == dataMap.end()) {
+        throw std::runtime_error(std::format("Series {} not found", key));
+    }
+
+    const auto* stamps = std::get_if<Octurn::timeSeries>(&it->second);
+    if (!stamps) {
+        throw std::runtime_error(std::format("Series {} is not a timestamp column", key));
+    }
+
+    return *stamps;
+}
+
+size_t MarketDataView::indexAt(const std::string& ticker, int64_t ns) const {
+    return stampToIndex(timestamps(ticker), ns);
+}
+
+std::pair<size_t, size_t> MarketDataView::sliceRange(const std::string& ticker, int64_t fromNs, int64_t toNs) const {
+    return stampRange(timestamps(ticker), fromNs, toNs);
+}
@@ -3,6 +3,8 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "types/types.hpp"
 #include "src/polygon/polygonDataFeed.hpp"
@@ -10,11 +12,23 @@
 
 struct ASTList;
 
+// ==== One entry of a script's 'data' block ==== //
+struct dataRequest {
+    std::string ticker;
+    std::string timespan;
+    std::string from;
+    std::string to;
+    int multiplier = 0;
+};
+
 class MarketDataView {
 private:
     polygonDataFeed feeder_;
     std::unordered_map<std::string, Octurn::AnyValue> dataMap_;
 
+    // ==== Set when the view reads a dataset loaded elsewhere (batch runs) ==== //
+    std::shared_ptr<const std::unordered_map<std::string, Octurn::AnyValue>> shared_;
+
 public:
 
     static std::string makeField(const std::string& ticker, const std::string& field);
@@ -22,9 +36,21 @@ public:
 
     explicit MarketDataView(const std::string& apiKey);
     explicit MarketDataView(polygonDataFeed&& feeder);
+    explicit MarketDataView(std::shared_ptr<const std::unordered_map<std::string, Octurn::AnyValue>> shared);
 
-    void extract(const std::shared_ptr<ASTList>& list);
+    static std::vector<dataRequest> requests(const ASTList* list);
+    void load(const dataRequest& request);
+
+    // ==== Shared views fetch nothing, they only check the tickers are there ==== //
+    void extract(const ASTList* list);
+    void extract(const std::vector<dataRequest>& requests);
+    bool isShared() const;
     std::unordered_map<std::string, Octurn::AnyValue>& data();
     const std::unordered_map<std::string, Octurn::AnyValue>& data() const;
     double getValue(const std::string& key, size_t idx) const;
+
+    // ==== Time indexing over <ticker>_timestamp (int64 ns, O(log n)) ==== //
+    const Octurn::timeSeries& timestamps(const std::string& ticker) const;
+    size_t indexAt(const std::string& ticker, int64_t ns) const;
+    std::pair<size_t, size_t> sliceRange(const std::string& ticker, int64_t fromNs, int64_t toNs) const;
 };
@@ -1,10 +1,14 @@
-#include <string>
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 
+// ==== Epoch ns (UTC), rendered to strings only at export ==== //
 struct timestamp {
-    std::string entryTimestamp;
-    size_t entryIdx;
-    std::string exitTimestamp;
-    size_t exitIdx;
+    int64_t entryTimestamp = 0;
+    size_t entryIdx = 0;
+    int64_t exitTimestamp = 0;
+    size_t exitIdx = 0;
 };
 
 enum class ordertype {
@@ -19,6 +23,7 @@ struct QtyState {
 
     double targetQty = 0.0;
     double filledQty = 0.0;
+    double filledNotional = 0.0;   // sum(price * qty) over fills -> O(1) average price
 
     double remainingQty() const {
         return std::max(0.0, targetQty - filledQty);
@@ -28,6 +33,8 @@ struct QtyState {
 struct PriceState {
     double avgPrice;
     double stopLossPrice;
+    double takeProfitPrice;   // 0 -> no target
+    double exitPrice;
 };
 
 struct PriceQty{
@@ -0,0 +1,148 @@
+#include "performanceMetrics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "utils/timeIndex.hpp"
+#include "snapshot/snapshot.hpp"
+
+void performanceMetrics::reset(size_t bars, double initialEquity, double periodsPerYear){
+    equityCurve_.assign(bars, 0.0);
+    count_ = 0;
+
+    initialEquity_ = initialEquity;
+    periodsPerYear_ = periodsPerYear;
+    prevEquity_ = initialEquity;
+    peak_ = initialEquity;
+    maxDrawdown_ = 0.0;
+
+    meanReturn_ = 0.0;
+    m2_ = 0.0;
+    downsideSq_ = 0.0;
+
+    barsInMarket_ = 0;
+    tradedNotional_ = 0.0;
+    equitySum_ = 0.0;
+}
+
+// ====================================================== //
+//                       Per bar
+// - Bar return is taken against the previous bar equity
+//   (initial equity for the first bar)
+// ====================================================== //
+
+void performanceMetrics::onBar(double equity, double grossExposure){
+    if (count_ >= equityCurve_.size()){
+        throw std::runtime_error("performanceMetrics: more bars than preallocated");
+    }
+
+    equityCurve_[count_++] = equity;
+    equitySum_ += equity;
+
+    const double ret = (prevEquity_ != 0.0) ? equity / prevEquity_ - 1.0 : 0.0;
+    const double delta = ret - meanReturn_;
+    meanReturn_ += delta / static_cast<double>(count_);
+    m2_ += delta * (ret - meanReturn_);
+    downsideSq_ += (ret < 0.0) ? ret * ret : 0.0;
+
+    peak_ = std::max(peak_, equity);
+    if (peak_ > 0.0) maxDrawdown_ = std::max(maxDrawdown_, (peak_ - equity) / peak_);
+
+    barsInMarket_ += (grossExposure > 0.0);
+    prevEquity_ = equity;
+}
+
+void performanceMetrics::onFill(double notional){
+    tradedNotional_ += std::abs(notional);
+}
+
+metricsSummary performanceMetrics::summary() const {
+    metricsSummary summary;
+    summary.bars = count_;
+    summary.finalEquity = count_ ? equityCurve_[count_ - 1] : initialEquity_;
+    summary.maxDrawdown = maxDrawdown_;
+
+    if (initialEquity_ != 0.0){
+        summary.totalReturn = (summary.finalEquity - initialEquity_) / initialEquity_;
+    }
+
+    if (count_ == 0) return summary;
+
+    const double annualize = std::sqrt(periodsPerYear_);
+    const double stdev = (count_ > 1) ? std::sqrt(m2_ / static_cast<double>(count_ - 1)) : 0.0;
+    const double downside = std::sqrt(downsideSq_ / static_cast<double>(count_));
+
+    summary.sharpe = (stdev > 0.0) ? meanReturn_ / stdev * annualize : 0.0;
+    summary.sortino = (downside > 0.0) ? meanReturn_ / downside * annualize : 0.0;
+    summary.exposure = static_cast<double>(barsInMarket_) / static_cast<double>(count_);
+
+    const double avgEquity = equitySum_ / static_cast<double>(count_);
+    summary.turnover = (avgEquity > 0.0) ? tradedNotional_ / avgEquity : 0.0;
+
+    return summary;
+}
+
+const std::vector<double>& performanceMetrics::equityCurve() const {
+    return equityCurve_;
+}
+
+// ==== Curve is saved with its full preallocated size, the loop keeps writing into it ==== //
+void performanceMetrics::save(snapshotWriter& out) const {
+    out.putVector(equityCurve_);
+    out.put<uint64_t>(count_);
+    out.put(initialEquity_);
+    out.put(periodsPerYear_);
+    out.put(prevEquity_);
+    out.put(peak_);
+    out.put(maxDrawdown_);
+    out.put(meanReturn_);
+    out.put(m2_);
+    out.put(downsideSq_);
+    out.put<uint64_t>(barsInMarket_);
+    out.put(tradedNotional_);
+    out.put(equitySum_);
+}
+
+void performanceMetrics::load(snapshotReader& in){
+    in.getVector(equityCurve_);
+    count_ = in.get<uint64_t>();
+    initialEquity_ = in.get<double>();
+    periodsPerYear_ = in.get<double>();
+    prevEquity_ = in.get<double>();
+    peak_ = in.get<double>();
+    maxDrawdown_ = in.get<double>();
+    meanReturn_ = in.get<double>();
+    m2_ = in.get<double>();
+    downsideSq_ = in.get<double>();
+    barsInMarket_ = in.get<uint64_t>();
+    tradedNotional_ = in.get<double>();
+    equitySum_ = in.get<double>();
+}
+
+nlohmann::json performanceMetrics::toJson(const Octurn::timeSeries* stamps, size_t firstBar) const {
+    const auto s = summary();
+
+    nlohmann::json out;
+    out["summary"] = {
+        {"bars", s.bars},
+        {"finalEquity", s.finalEquity},
+        {"totalReturn", s.totalReturn},
+        {"sharpe", s.sharpe},
+        {"sortino", s.sortino},
+        {"maxDrawdown", s.maxDrawdown},
+        {"exposure", s.exposure},
+        {"turnover", s.turnover}
+    };
+    out["equityCurve"] = std::vector<double>(equityCurve_.begin(), equityCurve_.begin() + count_);
+
+    if (stamps){
+        nlohmann::json times = nlohmann::json::array();
+        for (size_t i = 0; i < count_ && firstBar + i < stamps->size(); i++){
+            times.push_back(formatStamp((*stamps)[firstBar + i]));
+        }
+        out["timestamps"] = std::move(times);
+    }
+
+    return out;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "types/types.hpp"
+
+class snapshotWriter;
+class snapshotReader;
+
+// ====================================================== //
+//              Streaming performance metrics
+// - onBar() is O(1): running moments of bar returns,
+//   running peak / drawdown, exposure counter
+// - Equity curve is written into a column preallocated
+//   for the whole run, no reallocation inside the loop
+// ====================================================== //
+
+struct metricsSummary {
+    size_t bars = 0;
+    double finalEquity = 0.0;
+    double totalReturn = 0.0;
+    double sharpe = 0.0;
+    double sortino = 0.0;
+    double maxDrawdown = 0.0;
+    double exposure = 0.0;    // share of bars with an open position
+    double turnover = 0.0;    // traded notional / average equity
+};
+
+class performanceMetrics {
+    private:
+        std::vector<double> equityCurve_;
+        size_t count_ = 0;
+
+        double initialEquity_ = 0.0;
+        double periodsPerYear_ = 252.0;
+        double prevEquity_ = 0.0;
+        double peak_ = 0.0;
+        double maxDrawdown_ = 0.0;
+
+        // ==== Welford moments of bar returns ==== //
+        double meanReturn_ = 0.0;
+        double m2_ = 0.0;
+        double downsideSq_ = 0.0;
+
+        size_t barsInMarket_ = 0;
+        double tradedNotional_ = 0.0;
+        double equitySum_ = 0.0;
+
+    public:
+        void reset(size_t bars, double initialEquity, double periodsPerYear = 252.0);
+
+        void onBar(double equity, double grossExposure);
+        void onFill(double notional);
+
+        metricsSummary summary() const;
+        const std::vector<double>& equityCurve() const;
+
+        void save(snapshotWriter& out) const;
+        void load(snapshotReader& in);
+
+        // ==== Stamps (optional) are rendered to strings only here ==== //
+        nlohmann::json toJson(const Octurn::timeSeries* stamps = nullptr, size_t firstBar = 0) const;
+};
@@ -1,22 +1,31 @@
 #include "node/Node.hpp"
 #include "lexer/operators.hpp"
+#include "ta/crosses.hpp"
+#include "ta/temporal.hpp"
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <limits>
 
 using Octurn::AnyValue;
 using Octurn::multiValue;
 
 
 // ASTValueNode constructors
-ASTValueNode::ASTValueNode(bool value_) : value(value_) {}
+ASTValueNode::ASTValueNode(bool value_) : ASTNode(KIND), value(value_) {}
 
-ASTValueNode::ASTValueNode(double value_) : value(value_) {}
+ASTValueNode::ASTValueNode(double value_) : ASTNode(KIND), value(value_) {}
 
-ASTValueNode::ASTValueNode(NodeMap value_) : value(value_) {}
+ASTValueNode::ASTValueNode(NodeMap value_) : ASTNode(KIND), value(std::move(value_)) {}
 
-ASTValueNode::ASTValueNode(std::string value_) : value(value_) {}
+ASTValueNode::ASTValueNode(std::string value_) : ASTNode(KIND), value(std::move(value_)) {}
 
 
 AnyValue compare_vectors_values(AnyValue& left, AnyValue& right, const std::string& op) {
-    const auto& functor_variant = OperatorMap.at(op);
+    return apply_operator(left, right, OperatorMap.at(op));
+}
+
+AnyValue apply_operator(AnyValue& left, AnyValue& right, const OperatorVariant& functor_variant) {
     return std::visit([&](auto&& functor) -> AnyValue {
         return std::visit([&](auto&& lhs, auto&& rhs) -> AnyValue {
 
@@ -38,10 +47,384 @@ AnyValue compare_vectors_values(AnyValue& left, AnyValue& right, const std::stri
     }, functor_variant);
 }
 
+// ====================================================== //
+//                  Operator typing rules
+// - Same acceptance as apply_operator(): both operands
+//   numeric or both boolean, arithmetic is numeric only
+// - A series on either side makes the result a series
+// ====================================================== //
+
+namespace {
+
+bool is_numeric(valueType type){
+    return type == valueType::Number || type == valueType::NumberSeries;
+}
+
+bool is_boolean(valueType type){
+    return type == valueType::Bool || type == valueType::BoolSeries;
+}
+
+bool is_series_type(valueType type){
+    return type == valueType::NumberSeries || type == valueType::BoolSeries;
+}
+
+template <typename Scalar, typename Op>
+binaryKernel kernel_for(bool left_series, bool right_series){
+    using Series = std::vector<Scalar>;
+    if (left_series && right_series) return &typed_kernel<Op, Series, Series>;
+    if (left_series) return &typed_kernel<Op, Series, Scalar>;
+    if (right_series) return &typed_kernel<Op, Scalar, Series>;
+    return &typed_kernel<Op, Scalar, Scalar>;
+}
+
+}
+
+valueType binary_result_type(const std::string& op, valueType left, valueType right){
+    const bool series = is_series_type(left) || is_series_type(right);
+    const bool numeric = is_numeric(left) && is_numeric(right);
+    const bool boolean = is_boolean(left) && is_boolean(right);
+
+    if (op == "+" || op == "-" || op == "*" || op == "/"){
+        if (numeric) return series ? valueType::NumberSeries : valueType::Number;
+    } else if (op == ">" || op == "<"){
+        if (numeric) return series ? valueType::BoolSeries : valueType::Bool;
+    } else if (op == "==" || op == "and" || op == "or"){
+        if (numeric || boolean) return series ? valueType::BoolSeries : valueType::Bool;
+    }
+    return valueType::Unknown;
+}
+
+binaryKernel select_kernel(const std::string& op, valueType left, valueType right){
+    auto it = OperatorMap.find(op);
+    if (it == OperatorMap.end() || binary_result_type(op, left, right) == valueType::Unknown) return nullptr;
+
+    const bool left_series = is_series_type(left);
+    const bool right_series = is_series_type(right);
+    return std::visit([&](auto functor) -> binaryKernel {
+        using Op = decltype(functor);
+        if (is_numeric(left)) return kernel_for<double, Op>(left_series, right_series);
+        return kernel_for<bool, Op>(left_series, right_series);
+    }, it->second);
+}
 
+// ====================================================== //
+//                     Syntax tree
+// ====================================================== //
+
+astArena& syntaxTree::arena(){
+    return arena_;
+}
+
+void syntaxTree::set_root(ASTRoot* root){
+    root_ = root;
+}
+
+const ASTRoot* syntaxTree::root() const {
+    return root_;
+}
 
-AnyValue ASTNode::eval_node(std::optional<AnyValue>,std::optional<AnyValue>,std::optional<std::shared_ptr<ASTNode>>){
-    throw std::runtime_error("ASTNode::eval_node not implemented for this node type.");
+ASTRoot* syntaxTree::root(){
+    return root_;
+}
+
+// ====================================================== //
+//                   Visitor dispatch
+// ====================================================== //
+
+AnyValue Visitor::visit(const ASTNode& node){
+    switch (node.kind) {
+        case NodeKind::Value:
+            return visit_value(static_cast<const ASTValueNode&>(node));
+        case NodeKind::FunctionCall:
+            return visit_function(static_cast<const ASTFunctionCall&>(node));
+        case NodeKind::Arithmetics:
+        case NodeKind::Comparison:
+        case NodeKind::Expression:
+            return visit_binary(static_cast<const ASTBinary&>(node));
+        case NodeKind::Crosses:
+            return visit_crosses(static_cast<const ASTCrosses&>(node));
+        case NodeKind::Temporal:
+            return visit_temporal(static_cast<const ASTTemporal&>(node));
+        case NodeKind::Lag:
+            return visit_lag(static_cast<const ASTLag&>(node));
+        case NodeKind::Condition:
+        case NodeKind::LogicalCondition:
+            throw std::runtime_error("Visitor: evaluation not implemented for this node type.");
+        case NodeKind::Term:
+        case NodeKind::Action:
+        case NodeKind::Block:
+        case NodeKind::List:
+        case NodeKind::Root:
+        case NodeKind::Strategy:
+        case NodeKind::Assignment:
+            return false;
+    }
+    throw std::runtime_error("Visitor: unknown node kind.");
+}
+
+// ==== Identifiers resolve to series / numbers (parameters) stored in variables, otherwise the literal itself ==== //
+AnyValue Visitor::visit_value(const ASTValueNode& node){
+    return std::visit([this](auto&& val) -> AnyValue {
+        using T = std::decay_t<decltype(val)>;
+        if constexpr (std::is_same_v<T, NodeMap>) {
+            throw std::runtime_error("Unable to cast NodeMap to AnyValue type.");
+        } else {
+            if constexpr (std::is_same_v<T, std::string>) {
+                auto it = context.variables.find(val);
+                if (it != context.variables.end()){
+                    if (auto series = std::get_if<std::vector<double>>(&it->second)) {
+                        return *series;
+                    }
+                    if (auto number = std::get_if<double>(&it->second)) {
+                        return *number;
+                    }
+                }
+            }
+            return val;
+        }
+    }, node.value);
+}
+
+AnyValue Visitor::visit_binary(const ASTBinary& node){
+    auto left_view = view_of(*node.left);
+    auto right_view = view_of(*node.right);
+
+    if (left_view || right_view){
+        const bool left_stored = left_view.has_value();
+        const bool right_stored = right_view.has_value();
+        AnyValue left_value, right_value;
+        if (!left_view) left_view = evaluated_view(*node.left, left_value);
+        if (!right_view) right_view = evaluated_view(*node.right, right_value);
+
+        const auto& functor = OperatorMap.at(node.op);
+        const auto* left_number = left_stored ? nullptr : std::get_if<double>(&left_value);
+        const auto* right_number = right_stored ? nullptr : std::get_if<double>(&right_value);
+
+        if (left_view && right_view && left_view->size == right_view->size) return view_operator(*left_view, *right_view, functor);
+        if (left_view && right_number) return view_operator(*left_view, *right_number, functor);
+        if (left_number && right_view) return view_operator(*left_number, *right_view, functor);
+
+        // ==== Broadcast lengths / other types: generic path on evaluated operands ==== //
+        if (left_stored) left_value = visit(*node.left);
+        if (right_stored) right_value = visit(*node.right);
+        return compare_vectors_values(left_value, right_value, node.op);
+    }
+
+    auto left_value = visit(*node.left);
+    auto right_value = visit(*node.right);
+    if (node.kernel) return node.kernel(left_value, right_value);
+    return compare_vectors_values(left_value, right_value, node.op);
+}
+
+// ==== Evaluates the node into storage, viewed when it is a number series ==== //
+std::optional<Octurn::seriesView> Visitor::evaluated_view(const ASTNode& node, AnyValue& storage){
+    storage = visit(node);
+    if (const auto* series = std::get_if<std::vector<double>>(&storage)) return Octurn::seriesView{series->data(), series->size(), 0};
+    return std::nullopt;
+}
+
+// ==== Stored number series (an identifier), lagged or not, nullopt for anything to compute ==== //
+std::optional<Octurn::seriesView> Visitor::view_of(const ASTNode& node){
+    if (const auto* value = node_cast<ASTValueNode>(&node)){
+        const auto* name = std::get_if<std::string>(&value->value);
+        auto it = name ? context.variables.find(*name) : context.variables.end();
+        if (it == context.variables.end()) return std::nullopt;
+        const auto* series = std::get_if<std::vector<double>>(&it->second);
+        if (!series) return std::nullopt;
+        return Octurn::seriesView{series->data(), series->size(), 0};
+    }
+    if (const auto* lag = node_cast<ASTLag>(&node)){
+        auto view = view_of(*lag->series);
+        if (!view) return std::nullopt;
+        const AnyValue bars = visit(*lag->bars);
+        view->lag = std::min(view->size, view->lag + lag_bars(bars, view->size));
+        return view;
+    }
+    return std::nullopt;
+}
+
+AnyValue Visitor::visit_crosses(const ASTCrosses& node){
+    auto left_view = view_of(*node.left);
+    auto right_view = view_of(*node.right);
+
+    if (left_view || right_view){
+        const bool left_stored = left_view.has_value();
+        const bool right_stored = right_view.has_value();
+        AnyValue left_value, right_value;
+        if (!left_view) left_view = evaluated_view(*node.left, left_value);
+        if (!right_view) right_view = evaluated_view(*node.right, right_value);
+
+        const auto direction = (node.op == "crosses_below") ? crossDirection::Below : crossDirection::Above;
+        const auto flipped = (direction == crossDirection::Above) ? crossDirection::Below : crossDirection::Above;
+        const auto* left_number = left_stored ? nullptr : std::get_if<double>(&left_value);
+        const auto* right_number = right_stored ? nullptr : std::get_if<double>(&right_value);
+
+        if (left_view && right_view && left_view->size == right_view->size) return cross_signals(*left_view, *right_view, direction);
+        if (left_view && right_number) return cross_signals(*left_view, *right_number, direction);
+        if (left_number && right_view) return cross_signals(*right_view, *left_number, flipped);
+
+        if (left_stored) left_value = visit(*node.left);
+        if (right_stored) right_value = visit(*node.right);
+        return cross_values(left_value, right_value, node.op);
+    }
+
+    auto left_value = visit(*node.left);
+    auto right_value = visit(*node.right);
+    return cross_values(left_value, right_value, node.op);
+}
+
+// ==== A one-element series (scalar broadcast by the generic path) counts as a threshold ==== //
+AnyValue cross_values(const AnyValue& left, const AnyValue& right, const std::string& op){
+    const auto direction = (op == "crosses_below") ? crossDirection::Below : crossDirection::Above;
+
+    const auto* left_series = std::get_if<std::vector<double>>(&left);
+    const auto* right_series = std::get_if<std::vector<double>>(&right);
+    const auto* left_level = std::get_if<double>(&left);
+    const auto* right_level = std::get_if<double>(&right);
+
+    if (left_series && left_series->size() == 1 && right_series && right_series->size() != 1){
+        left_level = &left_series->front();
+        left_series = nullptr;
+    }
+    if (right_series && right_series->size() == 1 && left_series && left_series->size() != 1){
+        right_level = &right_series->front();
+        right_series = nullptr;
+    }
+
+    if (left_series && right_series) return cross_signals(*left_series, *right_series, direction);
+    if (left_series && right_level) return cross_signals(*left_series, *right_level, direction);
+
+    // ==== level crosses above series <=> series crosses below level ==== //
+    if (left_level && right_series){
+        const auto flipped = (direction == crossDirection::Above) ? crossDirection::Below : crossDirection::Above;
+        return cross_signals(*right_series, *left_level, flipped);
+    }
+
+    throw std::runtime_error(std::format("Operator '{}' needs a number series on at least one side.", op));
+}
+
+AnyValue Visitor::visit_temporal(const ASTTemporal& node){
+    AnyValue args[3];
+    size_t argc = 0;
+    args[argc++] = visit(*node.condition);
+    if (node.series) args[argc++] = visit(*node.series);
+    if (node.window) args[argc++] = visit(*node.window);
+    // ==== 'for N bars' is 'for N of N bars' ==== //
+    if (node.op == temporalOp::For) args[argc++] = visit(node.required ? *node.required : *node.window);
+    return temporal_values(node.op, std::span<const AnyValue>(args, argc));
+}
+
+const char* temporal_name(temporalOp op){
+    switch (op) {
+        case temporalOp::For: return "for";
+        case temporalOp::Within: return "within";
+        case temporalOp::BarsSince: return "bars_since";
+        case temporalOp::Count: return "count";
+        case temporalOp::HighestSince: return "highest_since";
+    }
+    return "temporal";
+}
+
+size_t temporal_arity(temporalOp op){
+    switch (op) {
+        case temporalOp::For: return 3;
+        case temporalOp::BarsSince: return 1;
+        default: return 2;
+    }
+}
+
+namespace {
+
+const std::vector<bool>& temporal_condition(temporalOp op, const AnyValue& value){
+    const auto* signals = std::get_if<std::vector<bool>>(&value);
+    if (!signals) throw std::runtime_error(std::format("Operator '{}' needs a bool series as its condition.", temporal_name(op)));
+    return *signals;
+}
+
+size_t temporal_bars(temporalOp op, const AnyValue& value){
+    const auto* number = std::get_if<double>(&value);
+    if (!number || !(*number >= 1.0) || *number != std::floor(*number)){
+        throw std::runtime_error(std::format("Operator '{}' needs a whole number of bars >= 1.", temporal_name(op)));
+    }
+    return static_cast<size_t>(*number);
+}
+
+}
+
+AnyValue temporal_values(temporalOp op, std::span<const AnyValue> args){
+    if (args.size() != temporal_arity(op)){
+        throw std::runtime_error(std::format("Operator '{}' takes {} operands.", temporal_name(op), temporal_arity(op)));
+    }
+
+    const auto& signals = temporal_condition(op, args[0]);
+    const size_t n = signals.size();
+    const auto words = pack_signals(signals);
+
+    switch (op) {
+        case temporalOp::For:
+        case temporalOp::Within: {
+            const size_t window = temporal_bars(op, args[1]);
+            std::vector<uint64_t> out(words.size());
+            if (op == temporalOp::Within) within_bars(words.data(), n, window, out.data());
+            else {
+                const size_t required = temporal_bars(op, args[2]);
+                if (required > window) throw std::runtime_error("Operator 'for': K of N bars needs K <= N.");
+                if (required == window) held_for(words.data(), n, window, out.data());
+                else held_count(words.data(), n, window, required, out.data());
+            }
+            return unpack_signals(out, n);
+        }
+        case temporalOp::Count: {
+            std::vector<double> out(n);
+            count_window(words.data(), n, temporal_bars(op, args[1]), out.data());
+            return out;
+        }
+        case temporalOp::BarsSince: {
+            std::vector<double> out(n);
+            bars_since(words.data(), n, out.data());
+            return out;
+        }
+        case temporalOp::HighestSince: {
+            const auto* values = std::get_if<std::vector<double>>(&args[1]);
+            if (!values || values->size() != n){
+                throw std::runtime_error("Operator 'highest_since' needs a number series as long as its condition.");
+            }
+            std::vector<double> out(n);
+            highest_since(words.data(), values->data(), n, out.data());
+            return out;
+        }
+    }
+    throw std::runtime_error("Unknown temporal operator.");
+}
+
+AnyValue Visitor::visit_lag(const ASTLag& node){
+    return lag_values(visit(*node.series), visit(*node.bars));
+}
+
+size_t lag_bars(const AnyValue& bars, size_t length){
+    const auto* number = std::get_if<double>(&bars);
+    if (!number || !(*number >= 0.0) || *number != std::floor(*number)){
+        throw std::runtime_error("Lag needs a whole number of bars >= 0.");
+    }
+    // ==== Compared as a double first: casting one past size_t's range is undefined ==== //
+    if (*number >= static_cast<double>(length)) return length;
+    return static_cast<size_t>(*number);
+}
+
+AnyValue lag_values(AnyValue value, const AnyValue& bars){
+    if (auto* series = std::get_if<std::vector<double>>(&value)){
+        const size_t kept = series->size() - lag_bars(bars, series->size());
+        std::move_backward(series->begin(), series->begin() + kept, series->end());
+        std::fill(series->begin(), series->end() - kept, std::numeric_limits<double>::quiet_NaN());
+        return value;
+    }
+    if (auto* signals = std::get_if<std::vector<bool>>(&value)){
+        const size_t kept = signals->size() - lag_bars(bars, signals->size());
+        std::copy_backward(signals->begin(), signals->begin() + kept, signals->end());
+        std::fill(signals->begin(), signals->end() - kept, false);
+        return value;
+    }
+    throw std::runtime_error("Lag needs a series.");
 }
 
 // ====================================================== //
@@ -52,46 +435,41 @@ AnyValue ASTNode::eval_node(std::optional<AnyValue>,std::optional<AnyValue>,std:
 // - Returns result of func execution
 // ====================================================== //
 
-AnyValue ASTFunctionCall::eval_node(std::optional<AnyValue>left,std::optional<AnyValue>right,std::optional<std::shared_ptr<ASTNode>>func_ptr_node){
-    auto func_node = std::dynamic_pointer_cast<ASTFunctionCall>(func_ptr_node.value());
+AnyValue Visitor::visit_function(const ASTFunctionCall& node){
     multiValue args;
+    args.reserve(node.expr.size());
 
     // ==== Loop through every argument in the function call -> treat it ==== //
-    for (auto& arg : func_node->expr){
-        // ==== If value or bool -> just append to use it ==== //
-        if (auto val_node = std::dynamic_pointer_cast<ASTValueNode>(arg)){
-            if (std::holds_alternative<double>(val_node->value)){
-                args.push_back(std::get<double>(val_node->value));
-                }
-            else if (std::holds_alternative<bool>(val_node->value)){
-                args.push_back(std::get<bool>(val_node->value));
-            }
-            else if (std::holds_alternative<std::string>(val_node->value)){
-                args.push_back(std::get<std::string>(val_node->value));
+    for (const ASTNode* arg : node.expr){
+        switch (arg->kind) {
+            // ==== If value or bool -> just append to use it ==== //
+            case NodeKind::Value: {
+                const auto& value = static_cast<const ASTValueNode*>(arg)->value;
+                if (auto number = std::get_if<double>(&value)) args.push_back(*number);
+                else if (auto flag = std::get_if<bool>(&value)) args.push_back(*flag);
+                else if (auto text = std::get_if<std::string>(&value)) args.push_back(*text);
+                break;
             }
-        }
-        // ==== If nested function -> recursively evaluate it ==== //
-        else if (auto val_node = std::dynamic_pointer_cast<ASTFunctionCall>(arg)){
-
-            if (!val_node->ctx){
-                val_node->ctx = ctx;
-            }
-
-            std::optional<std::shared_ptr<ASTNode>> nested_ptr = val_node;
-            args.push_back(val_node->eval_node(std::nullopt,std::nullopt,nested_ptr));
+            // ==== If nested function -> recursively evaluate it ==== //
+            case NodeKind::FunctionCall:
+                args.push_back(visit_function(*static_cast<const ASTFunctionCall*>(arg)));
+                break;
+            default:
+                break;
         }
     }
 
-    auto name = func_node->name;
+    const auto& name = node.name;
 
-    auto it = ctx->functionMapper.find(name);
-    auto& variables_ = ctx->variables;
-    auto& data_ = ctx->data;
+    auto it = context.functionMapper.find(name);
+    if (it == context.functionMapper.end()){
+        throw std::runtime_error(std::format("Unknown function '{}'", name));
+    }
 
     std::vector<double> output;
 
     try {
-        output = it->second(args, variables_,ctx->dataMap);
+        output = it->second(args, context.variables, context.dataMap);
     } catch (const std::exception& e) {
         std::cerr << "TA func " << name << " failed: " << e.what() << "\n";
         throw;
@@ -100,6 +478,7 @@ AnyValue ASTFunctionCall::eval_node(std::optional<AnyValue>left,std::optional<An
         throw;
     }
 
+    if (node.lag) return lag_values(std::move(output), visit(*node.lag));
     return output;
 
 }
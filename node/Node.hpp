@@ -6,407 +6,295 @@
 #include <variant>
 #include <iostream>
 #include <map>
+#include <optional>
+#include <span>
 #include "lexer/Lexer.hpp"
+#include "node/astArena.hpp"
 #include "types/types.hpp"
 
 using Octurn::NodeMap;
 using Octurn::AnyValue;
 using Octurn::taFunctionCall;
 using Octurn::multiValue;
+using Octurn::valueType;
+using Octurn::binaryKernel;
 
 AnyValue compare_vectors_values(AnyValue& left, AnyValue& right, const std::string& op);
+// ==== op: "crosses_above" / "crosses_below", a scalar side is a threshold ==== //
+AnyValue cross_values(const AnyValue& left, const AnyValue& right, const std::string& op);
+
+// ====================================================== //
+//                  Temporal operators
+//   cond for N bars / cond for K of N bars / cond within N bars
+//   bars_since(cond) / count(cond, N) / highest_since(cond, series)
+// ====================================================== //
+enum class temporalOp : uint8_t { For, Within, BarsSince, Count, HighestSince };
+
+const char* temporal_name(temporalOp op);
+// ==== Operands in node order: condition, then window (+ required) or the series ==== //
+size_t temporal_arity(temporalOp op);
+AnyValue temporal_values(temporalOp op, std::span<const AnyValue> args);
+
+// ==== series[bars]: shifts in place, the first bars become invalid (NaN / false) ==== //
+AnyValue lag_values(AnyValue value, const AnyValue& bars);
+// ==== Clamped to length: a lag past the end leaves no valid bar, whatever its size ==== //
+size_t lag_bars(const AnyValue& bars, size_t length);
 
 struct ExecutionContext {
     std::unordered_map<std::string, AnyValue>& variables;
     std::unordered_map<std::string, AnyValue>& data;
-    std::unordered_map<std::string, AnyValue>& dataMap;
+    const std::unordered_map<std::string, AnyValue>& dataMap;
     std::unordered_map<std::string, taFunctionCall>& functionMapper;
 };
 
-struct Visitor;
+// ====================================================== //
+//                      Node kinds
+// - Every node carries its kind, consumers switch on it
+//   instead of probing types with casts
+// - Nodes live in the astArena of their parse, children are
+//   plain non-owning pointers into the same arena
+// - Nodes holding child lists take the arena as their memory
+//   resource (default resource when built outside a parse)
+// ====================================================== //
+enum class NodeKind {
+    List, Value, Block, FunctionCall, Condition, Comparison, Term,
+    Action, Crosses, Expression, LogicalCondition, Assignment, Strategy, Root, Arithmetics, Temporal, Lag
+};
 
+// ==== line/col of the first token, type is filled in by the semantic pass ==== //
 struct ASTNode {
-    virtual ~ASTNode() = default;
-    virtual AnyValue accept(Visitor& visitor) = 0;
-    virtual AnyValue eval_node(std::optional<AnyValue>left,std::optional<AnyValue>right,std::optional<std::shared_ptr<ASTNode>>func_ptr_node);
+    const NodeKind kind;
+    valueType type = valueType::Unknown;
+    uint32_t line = 0;
+    uint32_t col = 0;
 
+    explicit ASTNode(NodeKind kind_) : kind(kind_) {}
 };
 
-struct ASTList : public ASTNode {
-    std::vector<std::shared_ptr<ASTNode>> list;
+// ==== Tag-checked downcast, nullptr when the kind does not match ==== //
+template <typename T>
+T* node_cast(ASTNode* node){
+    return (node && node->kind == T::KIND) ? static_cast<T*>(node) : nullptr;
+}
 
-    AnyValue accept(Visitor& visitor) override;
-};
+template <typename T>
+const T* node_cast(const ASTNode* node){
+    return (node && node->kind == T::KIND) ? static_cast<const T*>(node) : nullptr;
+}
+
+struct ASTList : ASTNode {
+    static constexpr NodeKind KIND = NodeKind::List;
+    std::pmr::vector<ASTNode*> list;
 
-// ==== Declare <Value Node> ==== //
-struct ASTValueNode;
+    explicit ASTList(std::pmr::memory_resource* mr = std::pmr::get_default_resource()) : ASTNode(KIND), list(mr) {}
+};
 
 // ==== Definition of value node , that could be of type of bool,double,string,map ====//
 struct ASTValueNode : ASTNode {
+    static constexpr NodeKind KIND = NodeKind::Value;
     std::variant<std::string, double, bool, NodeMap> value;
 
     ASTValueNode(double value_);
     ASTValueNode(bool value_);
     ASTValueNode(std::string value_);
     ASTValueNode(NodeMap map = {});
-
-    ExecutionContext* ctx = nullptr;
-
-    AnyValue accept(Visitor& visitor) override;
-
-    AnyValue eval_node(std::optional<AnyValue>left,std::optional<AnyValue>right,std::optional<std::shared_ptr<ASTNode>>func_ptr_node) override {
-        return std::visit([this](auto&& val) -> AnyValue {
-            using T = std::decay_t<decltype(val)>;
-            if constexpr (std::is_same_v<T, NodeMap>) {
-                throw std::runtime_error("Unable to cast NodeMap to AnyValue type.");
-            } else {
-                if constexpr (std::is_same_v<T, std::string>) {
-                    auto& variables_ = ctx->variables;
-                    auto it = variables_.find(val);
-                    if (it != variables_.end()){
-                        if (std::holds_alternative<std::vector<double>>(it->second)) {
-                            return std::get<std::vector<double>>(it->second);
-                        }
-                    }
-                }
-                return val;
-            }
-        }, value);
-    }
-
 };
 
 // ==== Defines entier blocks (inner content of '{}') in AST structure ==== //
-struct ASTBlock : ASTNode{
+struct ASTBlock : ASTNode {
+    static constexpr NodeKind KIND = NodeKind::Block;
     NodeMap entries;
     std::optional<Tokentype> block_type;
 
-    AnyValue accept(Visitor& visitor) override;
+    explicit ASTBlock(std::pmr::memory_resource* mr = std::pmr::get_default_resource()) : ASTNode(KIND), entries(mr) {}
 };
 
 
 // ==== Defines function call ==== //
 struct ASTFunctionCall : ASTNode {
+    static constexpr NodeKind KIND = NodeKind::FunctionCall;
     std::string name;
-    std::vector<std::shared_ptr<ASTNode>> expr;
-    std::optional<std::shared_ptr<ASTNode>> ptr;
+    std::pmr::vector<ASTNode*> expr;
+    // ==== MA(x[1], n) is parsed as MA(x, n)[1]: indicators are causal, the result is lagged instead ==== //
+    ASTNode* lag = nullptr;
 
-    ExecutionContext* ctx = nullptr;
+    explicit ASTFunctionCall(std::pmr::memory_resource* mr = std::pmr::get_default_resource()) : ASTNode(KIND), expr(mr) {}
+};
 
-    AnyValue accept(Visitor& visitor) override;
+// ==== Shared layout of every 'left op right' node ==== //
+struct ASTBinary : ASTNode {
+    // ==== Left - Right expressions ==== //
+    ASTNode* left = nullptr;
+    ASTNode* right = nullptr;
+    std::string op;
+    Origin origin_op;
 
-    AnyValue eval_node(std::optional<AnyValue>left_node_value,std::optional<AnyValue>right_node_value,std::optional<std::shared_ptr<ASTNode>>func_ptr_node) override;
+    // ==== Set by the semantic pass when both operand shapes are known, else the generic path runs ==== //
+    binaryKernel kernel = nullptr;
 
+    using ASTNode::ASTNode;
 };
 
 // ==== Used to treat conditions ==== //
-struct ASTCondition : ASTNode {
-    // ==== Left - Right expressions ==== //
-    std::shared_ptr<ASTNode> left;
-    std::shared_ptr<ASTNode> right;
+struct ASTCondition : ASTBinary {
+    static constexpr NodeKind KIND = NodeKind::Condition;
 
     // ==== Operator between left and right expressions and its direction ==== //
     //                  operator direction
-    // **** when fast_ma crosses above slow_ma ****    
-    std::string op;
-    Origin origin_op;
-
+    // **** when fast_ma crosses above slow_ma ****
     std::string direction;
 
-    AnyValue accept(Visitor& visitor) override;
-
-
+    ASTCondition() : ASTBinary(KIND) {}
 };
 
 // ==== Used to treat comparisons ==== //
-struct ASTComparison : ASTNode {
-    // ==== Left - Right expressions ==== //
-    std::shared_ptr<ASTNode> left;
-    std::shared_ptr<ASTNode> right;
-    std::string op;
-    Origin origin_op;
-
-    AnyValue accept(Visitor& visitor) override;
-
-    AnyValue eval_node(std::optional<AnyValue>left_node_value,std::optional<AnyValue>right_node_value,std::optional<std::shared_ptr<ASTFunctionCall>>func_ptr_node){
-        if (left_node_value.has_value() && right_node_value.has_value()){
-            return compare_vectors_values(left_node_value.value(),right_node_value.value(),op);
-        } else throw std::runtime_error("Impossible to evaluate comparison node, no left/right value");
-    }
+struct ASTComparison : ASTBinary {
+    static constexpr NodeKind KIND = NodeKind::Comparison;
 
+    ASTComparison() : ASTBinary(KIND) {}
 };
 
 // ==== Used to treat terms ==== //
-struct ASTTerm : ASTNode {
-    // ==== Left , right operands ==== //
-    std::shared_ptr<ASTNode> left;
-    std::shared_ptr<ASTNode> right;
-    std::string op;
-    Origin origin_op;
-
-    AnyValue accept(Visitor& visitor) override;
-
-    AnyValue eval_node(std::optional<AnyValue>left_node_value,std::optional<AnyValue>right_node_value,std::optional<std::shared_ptr<ASTFunctionCall>>func_ptr_node){
-        if (left_node_value.has_value() && right_node_value.has_value()){
-            return compare_vectors_values(left_node_value.value(),right_node_value.value(),op);
-        }else throw std::runtime_error("Impossible to evaluate term node, no left/right value");
-    };
+struct ASTTerm : ASTBinary {
+    static constexpr NodeKind KIND = NodeKind::Term;
 
+    ASTTerm() : ASTBinary(KIND) {}
 };
 
 // ==== Used to treat actions ==== //
 struct ASTAction : ASTNode {
-    ActionType type; 
+    static constexpr NodeKind KIND = NodeKind::Action;
+    ActionType type;
     std::optional<double> quantity;
     bool all = false;
 
-    AnyValue accept(Visitor& visitor) override;
+    ASTAction() : ASTNode(KIND) {}
 };
 
-// ==== Crosses operator ==== //
-struct ASTCrosses : ASTNode {
-    // ==== Left , right operands ==== //
-    std::shared_ptr<ASTNode> left;
-    std::shared_ptr<ASTNode> right;
-    std::string op;
-    Origin origin_op;
-
-    AnyValue accept(Visitor& visitor) override;
+// ==== Crosses operator, op = "crosses_above" / "crosses_below" ==== //
+struct ASTCrosses : ASTBinary {
+    static constexpr NodeKind KIND = NodeKind::Crosses;
 
+    ASTCrosses() : ASTBinary(KIND) {}
 };
 
-struct ASTExpression : ASTNode {
-    // ==== Left - Right terms ==== //
-    std::shared_ptr<ASTNode> left;
-    std::shared_ptr<ASTNode> right;
-    std::string op;
-    Origin origin_op;
-
-    AnyValue accept(Visitor& visitor) override;
-
-    AnyValue eval_node(std::optional<AnyValue>left_node_value,std::optional<AnyValue>right_node_value,std::optional<std::shared_ptr<ASTFunctionCall>>func_ptr_node){
-        if (left_node_value.has_value() && right_node_value.has_value()){
-            return compare_vectors_values(left_node_value.value(),right_node_value.value(),op);
-        }
-        return {};
-    };
+struct ASTExpression : ASTBinary {
+    static constexpr NodeKind KIND = NodeKind::Expression;
 
+    ASTExpression() : ASTBinary(KIND) {}
 };
 
 // ==== Defines logical operators ==== //
-struct ASTLogicalCondition : ASTNode {
-    std::shared_ptr<ASTNode> left;
-    std::shared_ptr<ASTNode> right;
-    std::string op;
-    Origin origin_op;
+struct ASTLogicalCondition : ASTBinary {
+    static constexpr NodeKind KIND = NodeKind::LogicalCondition;
 
-    AnyValue accept(Visitor& visitor) override;
+    ASTLogicalCondition() : ASTBinary(KIND) {}
 };
 
 // ==== Defines assignement operator ==== //
 struct ASTAssignment : ASTNode {
+    static constexpr NodeKind KIND = NodeKind::Assignment;
     std::string name;
-    std::shared_ptr<ASTNode> expr;
-
-    AnyValue accept(Visitor& visitor) override;
-
+    ASTNode* expr = nullptr;
 
+    ASTAssignment() : ASTNode(KIND) {}
 };
 
 // ==== Assembels entire strategy structure ==== //
 struct Strategy : ASTNode {
+    static constexpr NodeKind KIND = NodeKind::Strategy;
     std::string name;
-    std::vector<std::shared_ptr<ASTNode>> blocks;
+    std::pmr::vector<ASTNode*> blocks;
 
-    AnyValue accept(Visitor& visitor) override;
+    explicit Strategy(std::pmr::memory_resource* mr = std::pmr::get_default_resource()) : ASTNode(KIND), blocks(mr) {}
 };
 
-struct ASTRoot : public ASTNode {
-    std::optional<std::shared_ptr<ASTNode>> config;
-    std::shared_ptr<ASTNode> strategy;
-    std::shared_ptr<ASTNode> data;
+struct ASTRoot : ASTNode {
+    static constexpr NodeKind KIND = NodeKind::Root;
+    std::optional<ASTNode*> config;
+    ASTNode* strategy = nullptr;
+    ASTNode* data = nullptr;
 
-    AnyValue accept(Visitor& visitor) override;
+    ASTRoot() : ASTNode(KIND) {}
+};
+
+struct ASTArithmetics : ASTBinary {
+    static constexpr NodeKind KIND = NodeKind::Arithmetics;
 
+    ASTArithmetics() : ASTBinary(KIND) {}
 };
 
-struct ASTArithmetics : ASTNode{
-    std::shared_ptr<ASTNode> left;
-    std::shared_ptr<ASTNode> right;
-    std::string op;
-    Origin origin_op;
+// ==== Temporal operator, window / required are a number or a parameter ==== //
+struct ASTTemporal : ASTNode {
+    static constexpr NodeKind KIND = NodeKind::Temporal;
+    temporalOp op;
+    ASTNode* condition = nullptr;
+    // ==== for / within / count ==== //
+    ASTNode* window = nullptr;
+    // ==== K of 'for K of N bars', nullptr -> all N ==== //
+    ASTNode* required = nullptr;
+    // ==== highest_since ==== //
+    ASTNode* series = nullptr;
+
+    explicit ASTTemporal(temporalOp op_) : ASTNode(KIND), op(op_) {}
+};
 
-    AnyValue accept(Visitor& visitor);
+// ==== series[bars], bars is a number or a parameter (no lead: it would read the future) ==== //
+struct ASTLag : ASTNode {
+    static constexpr NodeKind KIND = NodeKind::Lag;
+    ASTNode* series = nullptr;
+    ASTNode* bars = nullptr;
 
-    AnyValue eval_node(std::optional<AnyValue>left_node_value,std::optional<AnyValue>right_node_value){
-        if (left_node_value.has_value() && right_node_value.has_value()){
-            return compare_vectors_values(left_node_value.value(),right_node_value.value(),op);
-        } else throw std::runtime_error("Impossible to evaluate arithmetic node, no left/right value");
-    };
+    ASTLag() : ASTNode(KIND) {}
+};
+
+// ====================================================== //
+//                     Syntax tree
+// - Owns the arena of one parse, the root points into it
+// - Pinned in memory (held by shared_ptr), nodes never move
+// - Read-only once parsed: evaluation state lives in the
+//   ExecutionContext, so one tree can be shared by threads
+// ====================================================== //
+class syntaxTree {
+    private:
+        astArena arena_;
+        ASTRoot* root_ = nullptr;
 
+    public:
+        syntaxTree() = default;
+        syntaxTree(const syntaxTree&) = delete;
+        syntaxTree& operator=(const syntaxTree&) = delete;
+
+        astArena& arena();
+        void set_root(ASTRoot* root);
+        const ASTRoot* root() const;
+        // ==== Mutable access for passes that run before the tree is handed out ==== //
+        ASTRoot* root();
 };
 
+// ====================================================== //
+//                        Visitor
+// - Evaluates expression nodes with one switch on the kind
+// - Non-expression nodes (blocks, actions, ...) yield false
+// - Binary operands that are stored series, lagged or not,
+//   are read in place through a seriesView
+// ====================================================== //
 struct Visitor {
     public:
         Visitor(ExecutionContext& ctx):context(ctx){};
 
         ExecutionContext& context;
 
-        AnyValue visit(ASTArithmetics& node){
-            auto left_value = node.left->accept(*this);
-            auto right_value = node.right->accept(*this);
-            auto node_value = node.eval_node(left_value,right_value);
-            return node_value;
-        }
-
-        AnyValue visit(ASTValueNode& node){
-            node.ctx = &context;
-            return node.eval_node(std::nullopt,std::nullopt,std::nullopt);
-        }
-
-        AnyValue visit(ASTAction& node){
-            return false;
-        }
-
-        AnyValue visit(ASTCrosses& node){
-            auto left_value = node.left->accept(*this);
-            auto right_value = node.right->accept(*this);
-            return node.eval_node(left_value,right_value,std::nullopt);
-        }
-
-        AnyValue visit(ASTBlock& node){
-            return false;
-        }
-
-        AnyValue visit(ASTList& node){
-            return false;
-        }
-
-        AnyValue visit(ASTRoot& node){
-            return false;
-        }
-
-        AnyValue visit(Strategy& node){
-            return false;
-        }
-
-        AnyValue visit(ASTAssignment& node){
-            return false;
-        }
-
-        AnyValue visit(ASTFunctionCall& node){
-
-            std::shared_ptr<ASTFunctionCall> fn_ptr;
-            node.ctx = &context;
-
-            if (auto call = std::dynamic_pointer_cast<ASTFunctionCall>(node.ptr.value())){
-                fn_ptr = call;
-            }
-
-            auto value = node.eval_node(std::nullopt,std::nullopt,fn_ptr);
-            return value;
-        }
-
-        AnyValue visit(ASTLogicalCondition& node){
-            auto left_value = node.left->accept(*this);
-            auto right_value = node.right->accept(*this);
-            return node.eval_node(left_value,right_value,std::nullopt);
-        }
-
-        AnyValue visit(ASTExpression& node){
-            auto left_value = node.left->accept(*this);
-            auto right_value = node.right->accept(*this);
-            return node.eval_node(left_value,right_value,std::nullopt);
-        }
-
-        AnyValue visit(ASTCondition& node){
-            auto left_value = node.left->accept(*this);
-            auto right_value = node.right->accept(*this);
-            return node.eval_node(left_value,right_value,std::nullopt);
-        }
-
-        AnyValue visit(ASTTerm& node){
-            return false;
-        }
-
-        AnyValue visit(ASTComparison& node){
-            auto left_value = node.left->accept(*this);
-            auto right_value = node.right->accept(*this);
-            return node.eval_node(left_value,right_value,std::nullopt);
-        }
-};
-
-// ===== ASTList =====
-inline  AnyValue ASTList::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
-
-// ===== ASTValueNode =====
-inline AnyValue ASTValueNode::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
-
-// ===== ASTBlock =====
-inline AnyValue ASTBlock::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
-
-// ===== ASTCondition =====
-inline AnyValue ASTCondition::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
-
-// ===== ASTComparison =====
-inline AnyValue ASTComparison::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
-
-// ===== ASTTerm =====
-inline AnyValue ASTTerm::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
-
-// ===== ASTAction =====
-inline AnyValue ASTAction::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
-
-// ===== ASTCrosses =====
-inline AnyValue ASTCrosses::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
+        AnyValue visit(const ASTNode& node);
 
-// ===== ASTExpression =====
-inline AnyValue ASTExpression::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
+    private:
+        AnyValue visit_value(const ASTValueNode& node);
+        AnyValue visit_function(const ASTFunctionCall& node);
+        AnyValue visit_binary(const ASTBinary& node);
+        AnyValue visit_crosses(const ASTCrosses& node);
+        AnyValue visit_temporal(const ASTTemporal& node);
+        AnyValue visit_lag(const ASTLag& node);
 
-// ===== ASTLogicalCondition =====
-inline AnyValue ASTLogicalCondition::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
-
-// ===== ASTAssignment =====
-inline AnyValue ASTAssignment::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
-
-// ===== ASTFunctionCall =====
-inline AnyValue ASTFunctionCall::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
-
-// ===== Strategy =====
-inline AnyValue Strategy::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
-
-// ===== ASTRoot =====
-inline AnyValue ASTRoot::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
-
-// ===== ASTArithmetics =====
-inline AnyValue ASTArithmetics::accept(Visitor& visitor) {
-    return visitor.visit(*this);
-}
+        std::optional<Octurn::seriesView> view_of(const ASTNode& node);
+        std::optional<Octurn::seriesView> evaluated_view(const ASTNode& node, AnyValue& storage);
+};
@@ -0,0 +1,56 @@
+#include "node/astArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+astArena::astArena() : cursor_(inline_), limit_(inline_ + INLINE_BYTES) {}
+
+// ==== Records are pushed at the front, so this walks in reverse construction order ==== //
+astArena::~astArena(){
+    for (cleanup* it = cleanups_; it; it = it->next){
+        it->destroy(it->object);
+    }
+}
+
+void astArena::grow(size_t minSize){
+    const size_t size = std::max(nextBlock_, minSize);
+    blocks_.push_back(std::make_unique_for_overwrite<std::byte[]>(size));
+    cursor_ = blocks_.back().get();
+    limit_ = cursor_ + size;
+    nextBlock_ = size * 2;
+}
+
+void* astArena::bump(size_t size, size_t align){
+    // ==== align is a power of two ==== //
+    auto aligned = [&](){
+        const auto address = reinterpret_cast<std::uintptr_t>(cursor_);
+        return cursor_ + (((address + align - 1) & ~(align - 1)) - address);
+    };
+
+    std::byte* slot = aligned();
+    if (slot + size > limit_){
+        grow(size + align);
+        slot = aligned();
+    }
+
+    cursor_ = slot + size;
+    used_ += size;
+    return slot;
+}
+
+void* astArena::do_allocate(size_t bytes, size_t align){
+    return bump(bytes, align);
+}
+
+bool astArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+size_t astArena::bytesUsed() const {
+    return used_;
+}
+
+// ==== Inline block included ==== //
+size_t astArena::blockCount() const {
+    return blocks_.size() + 1;
+}
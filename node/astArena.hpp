@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ====================================================== //
+//                     AST arena
+// - One arena per parse, nodes are bump-allocated
+// - The first block is inline, a typical script allocates
+//   nothing else; bigger ones chain blocks of doubling size
+// - Also a pmr resource: child vectors / maps of the nodes
+//   draw from the same blocks, deallocation is a no-op
+// - Nodes owning heap members (strings, maps, vectors) get a
+//   cleanup record in the arena itself, run in reverse order
+//   when the arena dies, then all blocks go in one shot
+// - Not thread-safe while parsing, read-only sharing after
+// ====================================================== //
+class astArena : public std::pmr::memory_resource {
+    private:
+        static constexpr size_t INLINE_BYTES = 4096;
+
+        struct cleanup {
+            cleanup* next;
+            void* object;
+            void (*destroy)(void*);
+        };
+
+        alignas(std::max_align_t) std::byte inline_[INLINE_BYTES];
+        std::vector<std::unique_ptr<std::byte[]>> blocks_;
+        cleanup* cleanups_ = nullptr;
+        std::byte* cursor_;
+        std::byte* limit_;
+        size_t nextBlock_ = INLINE_BYTES * 2;
+        size_t used_ = 0;
+
+        void* bump(size_t size, size_t align);
+        void grow(size_t minSize);
+
+        void* do_allocate(size_t bytes, size_t align) override;
+        void do_deallocate(void*, size_t, size_t) override {}
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    public:
+        astArena();
+        ~astArena() override;
+
+        astArena(const astArena&) = delete;
+        astArena& operator=(const astArena&) = delete;
+
+        template <typename T, typename... Args>
+        T* make(Args&&... args){
+            void* slot = bump(sizeof(T), alignof(T));
+            T* object = ::new (slot) T(std::forward<Args>(args)...);
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                void* record = bump(sizeof(cleanup), alignof(cleanup));
+                cleanups_ = ::new (record) cleanup{cleanups_, object, [](void* p){ static_cast<T*>(p)->~T(); }};
+            }
+            return object;
+        }
+
+        size_t bytesUsed() const;
+        size_t blockCount() const;
+};
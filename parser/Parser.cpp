@@ -1,6 +1,7 @@
 #include "Parser.hpp"
 #include "node/Node.hpp"
 #include "utils/Utils.hpp"
+#include "compiler/semanticPass.hpp"
 #include <stdexcept>
 #include <format>
 #include "log/logHandler.hpp"
@@ -14,32 +15,39 @@ std::string Parser::operator_to_string(OperatorType op) {
     }
 }
 
-// ===== Init Parser Class + Handler to avoid explicit if - else problems =====
+// ===== Handler to avoid explicit if - else problems =====
+// ==== Scalable maps ==== //
+const std::unordered_map<Tokentype, ASTNode* (Parser::*)()> Parser::block_parsers = {
+    {Tokentype::Parameters, &Parser::parse_parameters},
+    {Tokentype::Config,     &Parser::parse_config},
+    {Tokentype::Strategy,   &Parser::parse_strategy},
+    {Tokentype::Indicators, &Parser::parse_indicators},
+    {Tokentype::Data,       &Parser::parse_data},
+    {Tokentype::Entry,      &Parser::parse_entry},
+    {Tokentype::Exit,       &Parser::parse_exit}
+};
+
+const std::unordered_map<std::string, std::string> Parser::SpecialTypes = {
+    {"ticker", "string"},
+    {"exchange", "string"},
+    {"symbol", "string"},
+    {"timespan", "string"},
+    {"from", "string"},
+    {"to", "string"}
+};
+
+// ==== Temporal functions, parsed before TA calls: their first argument is a condition ==== //
+const std::unordered_map<std::string, temporalOp> Parser::TemporalFunctions = {
+    {"bars_since", temporalOp::BarsSince},
+    {"count", temporalOp::Count},
+    {"highest_since", temporalOp::HighestSince}
+};
+
+// ===== Init Parser Class =====
 Parser::Parser(const std::vector<Token>& tokens)
-        : tokens_(tokens), pos_(0) {
-        // ==== Scalable maps ==== //
-        block_parsers = {
-            {Tokentype::Parameters, [this](){ return parse_parameters(); }},
-            {Tokentype::Config, [this](){ return parse_config(); }},
-            {Tokentype::Strategy, [this](){ return parse_strategy(); }},
-            {Tokentype::Indicators, [this](){ return parse_indicators(); }},
-            {Tokentype::Data,      [this](){ return parse_data(); }},
-            {Tokentype::Entry,      [this](){ return parse_entry(); }},
-            {Tokentype::Exit,       [this](){ return parse_exit(); }}
-        };
-
-        SpecialTypes = {
-            {"ticker", "string"},
-            {"exchange", "string"},
-            {"symbol", "string"},
-            {"timespan", "string"},
-            {"from", "string"},
-            {"to", "string"}
-        };
-
-}
-
-Parser::Parser(Parser&& other): tokens_(other.tokens_),pos_(other.pos_),block_parsers(other.block_parsers) {};
+        : tokens_(tokens), pos_(0), tree_(std::make_shared<syntaxTree>()) {}
+
+Parser::Parser(Parser&& other): tokens_(std::move(other.tokens_)),pos_(other.pos_),tree_(std::move(other.tree_)) {};
 
 const Token& Parser::current_token() const {
     return tokens_[pos_];
@@ -72,20 +80,20 @@ void Parser::consume_token(Tokentype type) {
 // =============================================================== //
 void Parser::parse_key_value(std::string& key, NodeMap& map) {
     auto assign_value = [&](auto value) {
-        map[key] = std::make_shared<ASTValueNode>(value);
+        map[key] = make_node<ASTValueNode>(value);
     };
     if (match(Tokentype::Number)) {
-        assign_value(std::stod(current_token().value));
+        assign_value(str_to_number(current_token().value));
         consume_token(Tokentype::Number);
     } else if (match(Tokentype::True) || match(Tokentype::False)) {
         assign_value(str_to_bool(current_token().value));
         consume_token(current_token().token_type);
     } else if (match(Tokentype::Identifier) && SpecialTypes.contains(key)){
 
-        assign_value(current_token().value);
+        assign_value(std::string(current_token().value));
         consume_token(Tokentype::Identifier);
     }else if (match(Tokentype::Date)){
-        assign_value(current_token().value);
+        assign_value(std::string(current_token().value));
         consume_token(Tokentype::Date);}
     else {
         throw_error();
@@ -94,7 +102,7 @@ void Parser::parse_key_value(std::string& key, NodeMap& map) {
 // =============================================================== //
 
 
-std::shared_ptr<ASTAssignment> Parser::create_assignment_node(const std::string& identifierName) {
+ASTAssignment* Parser::create_assignment_node(const std::string& identifierName) {
     
     // ========= Assignment operation ============ //
     // Parse the function
@@ -102,26 +110,26 @@ std::shared_ptr<ASTAssignment> Parser::create_assignment_node(const std::string&
     consume_token(Tokentype::Identifier);
 
     // ==== Create assignement node ==== //
-    auto assignment = std::make_shared<ASTAssignment>();
+    auto assignment = make_node<ASTAssignment>();
     assignment->name = identifierName;
     assignment->expr = function;
 
     return assignment;
 }
 
-std::shared_ptr<ASTBlock> Parser::create_block_node(Tokentype block_type, NodeMap&& map) {
-    auto block = std::make_shared<ASTBlock>();
+ASTBlock* Parser::create_block_node(Tokentype block_type, NodeMap&& map) {
+    auto block = make_node<ASTBlock>(&arena());
     block->block_type = block_type;
     block->entries = std::move(map);
     return block;
 }
 
-std::shared_ptr<ASTNode> Parser::parse_nested_block(Tokentype& block_type){
-    NodeMap map;
+ASTNode* Parser::parse_nested_block(Tokentype& block_type){
+    NodeMap map(&arena());
 
     while (match(Tokentype::Identifier)){
 
-        std::string IdentifierName = current_token().value;
+        std::string IdentifierName(current_token().value);
 
         consume_token(Tokentype::Identifier);
         
@@ -137,7 +145,7 @@ std::shared_ptr<ASTNode> Parser::parse_nested_block(Tokentype& block_type){
             consume_token(Tokentype::Equals);
             if(match(Tokentype::Identifier)) {
                 auto assignment_node = create_assignment_node(IdentifierName);
-                map[IdentifierName] = std::static_pointer_cast<ASTNode>(assignment_node);
+                map[IdentifierName] = assignment_node;
             }
         }
         else{
@@ -151,7 +159,7 @@ std::shared_ptr<ASTNode> Parser::parse_nested_block(Tokentype& block_type){
     return block;
 }
 
-std::shared_ptr<ASTNode> Parser::parse_config(){
+ASTNode* Parser::parse_config(){
     if (match(Tokentype::Config)){
         // ==== Specify block type ==== //
         auto type = current_token().token_type;
@@ -178,31 +186,31 @@ void Parser::throw_error(){
     ));
 }
 
-std::shared_ptr<ASTNode> Parser::parse_argument(){
+ASTNode* Parser::parse_argument(){
     if (is_function_call()) {
-        return parse_function();
+        return parse_lag(parse_function());
     }
     else if (match(Tokentype::Identifier)) {
-        std::string varName = current_token().value;
+        std::string varName(current_token().value);
         consume_token(Tokentype::Identifier);
-        return std::make_shared<ASTValueNode>(varName);
+        return parse_lag(make_node<ASTValueNode>(varName));
     }
     else if (match(Tokentype::Number)) {
-        double number = std::stod(current_token().value);
+        double number = str_to_number(current_token().value);
         consume_token(Tokentype::Number);
-        return std::make_shared<ASTValueNode>(number);
+        return make_node<ASTValueNode>(number);
     }
     else if (match(Tokentype::True) || match(Tokentype::False)) {
         bool boolean_val = str_to_bool(current_token().value);
         consume_token(current_token().token_type);
-        return std::make_shared<ASTValueNode>(boolean_val);
+        return make_node<ASTValueNode>(boolean_val);
     }
     throw_error();
 
     return nullptr;
 }
 
-std::shared_ptr<ASTNode> Parser::parse_parameters(){
+ASTNode* Parser::parse_parameters(){
     if (!match(Tokentype::Parameters)){
         throw std::runtime_error("Can't find parameters block.");
     }
@@ -223,13 +231,13 @@ bool Parser::is_function_call() {
 }
 
 
-std::shared_ptr<ASTNode> Parser::parse_function() {
+ASTNode* Parser::parse_function() {
 
     // ==== Function call is created for every present function ==== //
-    auto current_func_call = std::make_shared<ASTFunctionCall>();
+    auto current_func_call = make_node<ASTFunctionCall>(&arena());
 
     // ==== Function name ==== //
-    std::string name = current_token().value;
+    std::string name(current_token().value);
     consume_token(Tokentype::Identifier);
     current_func_call->name = name;
 
@@ -254,13 +262,44 @@ std::shared_ptr<ASTNode> Parser::parse_function() {
 
     // Closing parenthesis
     consume_token(Tokentype::RightParen);
-    current_func_call->ptr = current_func_call;
+
+    // ==== MA(x[1], n) -> MA(x, n)[1]: one lag for the call, read from the arguments ==== //
+    for (ASTNode*& arg : current_func_call->expr){
+        auto lag = node_cast<ASTLag>(arg);
+        if (!lag) continue;
+        if (node_cast<ASTLag>(lag->series) || (current_func_call->lag && !same_bar_count(current_func_call->lag, lag->bars))){
+            throw std::runtime_error(std::format("Lagged arguments of '{}' must share one lag, at line {}, col {}", name, lag->line, lag->col));
+        }
+        current_func_call->lag = lag->bars;
+        arg = lag->series;
+    }
     return current_func_call;
 }
 
-std::shared_ptr<ASTNode> Parser::parse_indicators(){
+// ==== series[N] (repeatable), N is a number or a parameter ==== //
+ASTNode* Parser::parse_lag(ASTNode* series){
+    while (match(Tokentype::LeftSBracket)) {
+        auto node = make_node<ASTLag>();
+        consume_token(Tokentype::LeftSBracket);
+        node->series = series;
+        node->bars = parse_bar_count();
+        consume_token(Tokentype::RightSBracket);
+        series = node;
+    }
+    return series;
+}
+
+bool Parser::same_bar_count(const ASTNode* left, const ASTNode* right){
+    const auto* l = node_cast<ASTValueNode>(left);
+    const auto* r = node_cast<ASTValueNode>(right);
+    return l && r && l->value.index() == r->value.index() &&
+           (std::holds_alternative<double>(l->value) ? std::get<double>(l->value) == std::get<double>(r->value)
+                                                     : std::get<std::string>(l->value) == std::get<std::string>(r->value));
+}
+
+ASTNode* Parser::parse_indicators(){
 
-    auto indicator_block = std::make_shared<ASTBlock>();
+    auto indicator_block = make_node<ASTBlock>(&arena());
     indicator_block->block_type = Tokentype::Indicators;
 
     if (!match(Tokentype::Indicators)){
@@ -275,8 +314,8 @@ std::shared_ptr<ASTNode> Parser::parse_indicators(){
     while (match(Tokentype::Identifier)){
 
         // ====== Keep track of all variables (identifiers) of type ASTAssignment ====== //
-        auto assignment_operator = std::make_shared<ASTAssignment>();
-        assignment_operator->name = current_token().value;;
+        auto assignment_operator = make_node<ASTAssignment>();
+        assignment_operator->name = std::string(current_token().value);
         consume_token(Tokentype::Identifier);
 
         // ====== Checks if syntax structure is correct '=' required after assignement ====== //
@@ -294,22 +333,59 @@ std::shared_ptr<ASTNode> Parser::parse_indicators(){
     return indicator_block;
 }
 
-std::shared_ptr<ASTNode> Parser::parse_comparison(){
+ASTNode* Parser::parse_comparison(){
     auto left = parse_arithmetics();
 
+    while (true) {
+        if (current_token().operator_type.has_value() &&
+           (current_token().operator_type == OperatorType::Less ||
+            current_token().operator_type == OperatorType::Greater)) {
 
-    while (current_token().operator_type.has_value() &&
-       (current_token().operator_type == OperatorType::Less ||
-        current_token().operator_type == OperatorType::Greater)) {
+            update_node<ASTComparison>(left, [&]() {
+                return parse_arithmetics();
+            });
+        }
+        // ==== 'crosses_above' / 'crosses_below' operators ==== //
+        else if (current_token().operator_type.has_value() &&
+                (current_token().operator_type == OperatorType::CrossesAbove ||
+                 current_token().operator_type == OperatorType::CrossesBelow)) {
 
-        update_node<ASTComparison>(left, [&]() {
-            return parse_arithmetics();
-        });
+            update_node<ASTCrosses>(left, [&]() {
+                return parse_arithmetics();
+            });
+        }
+        else if (match(Tokentype::Crosses)) {
+            parse_crosses(left);
+        }
+        else break;
     }
     return left;
 }
 
-std::shared_ptr<ASTNode> Parser::parse_arithmetics(){
+// ==== 'a crosses above b' / 'a crosses below b' -> same node as the word operators ==== //
+void Parser::parse_crosses(ASTNode*& left){
+    const Token& crosses = current_token();
+    consume_token(Tokentype::Crosses);
+
+    std::string op;
+    if (match(Tokentype::Above)) op = "crosses_above";
+    else if (match(Tokentype::Below)) op = "crosses_below";
+    else throw_error();
+    consume_token(current_token().token_type);
+
+    auto right = parse_arithmetics();
+
+    auto node = make_node<ASTCrosses>();
+    node->op = op;
+    node->origin_op = Origin::Domain;
+    node->left = left;
+    node->right = right;
+    node->line = static_cast<uint32_t>(crosses.lineNum);
+    node->col = static_cast<uint32_t>(crosses.colNum);
+    left = node;
+}
+
+ASTNode* Parser::parse_arithmetics(){
     auto left = parse_factor();
 
     while (current_token().operator_type.has_value() &&
@@ -326,7 +402,7 @@ std::shared_ptr<ASTNode> Parser::parse_arithmetics(){
 }
 
 
-std::shared_ptr<ASTNode> Parser::parse_expression(){
+ASTNode* Parser::parse_expression(){
     auto left = parse_term();
 
     while (current_token().operator_type.has_value() &&
@@ -339,15 +415,15 @@ std::shared_ptr<ASTNode> Parser::parse_expression(){
     return left;
 }
 
-std::shared_ptr<ASTNode> Parser::parse_term(){
+ASTNode* Parser::parse_term(){
 
-    auto left = parse_comparison();
+    auto left = parse_temporal();
 
     while (current_token().operator_type.has_value() &&
        (current_token().operator_type == OperatorType::And)) {
 
         update_node<ASTExpression>(left, [&]() {
-            return parse_comparison();
+            return parse_temporal();
         });
     }
 
@@ -355,13 +431,79 @@ std::shared_ptr<ASTNode> Parser::parse_term(){
 
 }
 
-std::shared_ptr<ASTNode> Parser::parse_factor() {
+// ==== 'cond for N bars', 'cond for K of N bars', 'cond within N bars' ==== //
+ASTNode* Parser::parse_temporal(){
+    auto left = parse_comparison();
+
+    while (match(Tokentype::For) || match(Tokentype::Within)) {
+        const Token& keyword = current_token();
+        const bool within = match(Tokentype::Within);
+        consume_token(keyword.token_type);
+
+        auto node = make_node<ASTTemporal>(within ? temporalOp::Within : temporalOp::For);
+        node->condition = left;
+        node->window = parse_bar_count();
+
+        if (!within && match(Tokentype::Of)) {
+            consume_token(Tokentype::Of);
+            node->required = node->window;
+            node->window = parse_bar_count();
+        }
+        consume_token(Tokentype::Bars);
+
+        node->line = static_cast<uint32_t>(keyword.lineNum);
+        node->col = static_cast<uint32_t>(keyword.colNum);
+        left = node;
+    }
+    return left;
+}
+
+// ==== Number of bars: literal or parameter name ==== //
+ASTNode* Parser::parse_bar_count(){
+    if (match(Tokentype::Number)) {
+        auto node = make_node<ASTValueNode>(str_to_number(current_token().value));
+        consume_token(Tokentype::Number);
+        return node;
+    }
+    if (match(Tokentype::Identifier)) {
+        auto node = make_node<ASTValueNode>(std::string(current_token().value));
+        consume_token(Tokentype::Identifier);
+        return node;
+    }
+    throw_error();
+    return nullptr;
+}
+
+// ==== bars_since(cond) / count(cond, N) / highest_since(cond, series) ==== //
+ASTNode* Parser::parse_temporal_function(temporalOp op){
+    auto node = make_node<ASTTemporal>(op);
+    consume_token(Tokentype::Identifier);
+    consume_token(Tokentype::LeftParen);
+
+    node->condition = parse_expression();
+
+    if (op == temporalOp::Count) {
+        consume_token(Tokentype::Comma);
+        node->window = parse_bar_count();
+    }
+    else if (op == temporalOp::HighestSince) {
+        consume_token(Tokentype::Comma);
+        node->series = parse_arithmetics();
+    }
+
+    consume_token(Tokentype::RightParen);
+    return node;
+}
+
+ASTNode* Parser::parse_factor() {
 
     if (is_function_call()) {
-        return parse_function();
+        auto temporal = TemporalFunctions.find(std::string(current_token().value));
+        if (temporal != TemporalFunctions.end()) return parse_lag(parse_temporal_function(temporal->second));
+        return parse_lag(parse_function());
     }
     else if (current_token().token_type == Tokentype::Number) {
-        auto node = std::make_shared<ASTValueNode>(std::stod(current_token().value));
+        auto node = make_node<ASTValueNode>(str_to_number(current_token().value));
         consume_token(Tokentype::Number);
         return node;
     }
@@ -369,19 +511,19 @@ std::shared_ptr<ASTNode> Parser::parse_factor() {
         consume_token(Tokentype::LeftParen);
         auto node = parse_expression();
         consume_token(Tokentype::RightParen);
-        return node;
+        return parse_lag(node);
     }
     else if (match(Tokentype::Identifier)) {
-        auto node = std::make_shared<ASTValueNode>(current_token().value); 
+        auto node = make_node<ASTValueNode>(std::string(current_token().value));
         consume_token(Tokentype::Identifier);
-        return node;
+        return parse_lag(node);
     }
 
     throw_error();
     return nullptr;
 }
 
-// std::shared_ptr<ASTNode> Parser::parse_language_operators(){
+// ASTNode* Parser::parse_language_operators(){
 //     auto left = parse_expression();
 
 //     while (current_token().operator_type.has_value()){
@@ -395,8 +537,8 @@ std::shared_ptr<ASTNode> Parser::parse_factor() {
 
 
 // ==== Parses actions when condition is met ==== //
-std::shared_ptr<ASTAction> Parser::parse_action() {
-    auto action = std::make_shared<ASTAction>();
+ASTAction* Parser::parse_action() {
+    auto action = make_node<ASTAction>();
 
     if (match(Tokentype::Buy)) {
         action->type = ActionType::Buy;
@@ -406,7 +548,7 @@ std::shared_ptr<ASTAction> Parser::parse_action() {
             action->all = true;
             consume_token(Tokentype::All);
         } else {
-            action->quantity = std::stod(current_token().value);
+            action->quantity = str_to_number(current_token().value);
             consume_token(Tokentype::Number);
         }
     }
@@ -418,7 +560,7 @@ std::shared_ptr<ASTAction> Parser::parse_action() {
             action->all = true;
             consume_token(Tokentype::All);
         } else {
-            action->quantity = std::stod(current_token().value);
+            action->quantity = str_to_number(current_token().value);
             consume_token(Tokentype::Number);
         }
     }
@@ -428,11 +570,11 @@ std::shared_ptr<ASTAction> Parser::parse_action() {
 }
 
 // ==== Complete 'strategy' block ==== //
-std::shared_ptr<Strategy> Parser::append_strategy_blocks() {
+Strategy* Parser::append_strategy_blocks() {
 
     // ==== Node <Strategy> ==== //
     // ** Containts strategy name and entries (vector of nodes) ** // 
-    auto strategy = std::make_shared<Strategy>();
+    auto strategy = make_node<Strategy>(&arena());
 
     // ==== Seen tokentypes , avoids block repitition, safety check ==== //
     std::unordered_set<Tokentype> seen_types;
@@ -446,7 +588,7 @@ std::shared_ptr<Strategy> Parser::append_strategy_blocks() {
 
             // ==== Get current token type and call block parser ==== //
             auto type = current_token().token_type;
-            auto block_node = it->second();
+            auto block_node = (this->*it->second)();
 
             // ==== Pushes block into 'strategy' tree and marks block as seen ==== //
             strategy->blocks.push_back(block_node);
@@ -488,12 +630,12 @@ bool Parser::required_blocks_in(const std::unordered_set<Tokentype>& types){
 // - Returns list of nodemaps, since 
 // ====================================================== //
 
-std::shared_ptr<ASTNode> Parser::parse_data(){
+ASTNode* Parser::parse_data(){
     if (!match(Tokentype::Data)){
         throw std::runtime_error("Can't find data block. No data to make calculations on.");
     }
 
-    auto list = std::make_shared<ASTList>();
+    auto list = make_node<ASTList>(&arena());
 
     consume_token(Tokentype::Data);
     consume_token(Tokentype::LeftSBracket);
@@ -514,8 +656,8 @@ std::shared_ptr<ASTNode> Parser::parse_data(){
 }
 
 // ==== Utility function to parse entry/exit ==== //
-std::shared_ptr<ASTNode> Parser::parse_block_entry_exit(Tokentype blockType) {
-    auto block = std::make_shared<ASTBlock>();
+ASTNode* Parser::parse_block_entry_exit(Tokentype blockType) {
+    auto block = make_node<ASTBlock>(&arena());
 
     if (match(blockType)) {
         consume_token(blockType);
@@ -552,17 +694,17 @@ std::shared_ptr<ASTNode> Parser::parse_block_entry_exit(Tokentype blockType) {
 }
 
 // ==== Parse exit block ==== //
-std::shared_ptr<ASTNode> Parser::parse_entry() {
+ASTNode* Parser::parse_entry() {
     return parse_block_entry_exit(Tokentype::Entry);
 }
 
 // ==== Parse entry block ==== //
-std::shared_ptr<ASTNode> Parser::parse_exit() {
+ASTNode* Parser::parse_exit() {
     return parse_block_entry_exit(Tokentype::Exit);
 }
 
 // ==== Build entier 'strategy' block ==== //
-std::shared_ptr<ASTNode> Parser::parse_strategy(){
+ASTNode* Parser::parse_strategy(){
 
     if (!match(Tokentype::Strategy)){
         throw std::runtime_error("Missing 'strategy' block.");
@@ -576,7 +718,7 @@ std::shared_ptr<ASTNode> Parser::parse_strategy(){
     }
 
     // ==== Saves strategy name ==== //
-    std::string name = current_token().value; 
+    std::string name(current_token().value); 
     consume_token(Tokentype::Identifier);
     
     consume_token(Tokentype::LeftBrace);
@@ -591,7 +733,7 @@ std::shared_ptr<ASTNode> Parser::parse_strategy(){
     return strategy;
 }
 
-void Parser::exec_config_parser(std::shared_ptr<ASTRoot>& root){
+void Parser::exec_config_parser(ASTRoot* root){
     if (root->config) {
         throw std::runtime_error("Duplicate 'config' block.");
     }
@@ -602,7 +744,7 @@ void Parser::exec_config_parser(std::shared_ptr<ASTRoot>& root){
     }
 }
 
-void Parser::exec_strategy_parser(std::shared_ptr<ASTRoot>& root){
+void Parser::exec_strategy_parser(ASTRoot* root){
     if (root->strategy){
         throw std::runtime_error("Duplicate 'strategy' block.");
     }
@@ -617,13 +759,12 @@ void Parser::exec_strategy_parser(std::shared_ptr<ASTRoot>& root){
 }
 
 // ==== Organizes all block parsers in one function ==== //
-std::shared_ptr<ASTNode> Parser::parse() {
+// ==== Nodes are allocated in the tree's arena, the tree is handed out read-only ==== //
+std::shared_ptr<const syntaxTree> Parser::parse() {
     g_logger.report("[PARSER] Parse started.");
-    auto root = std::make_shared<ASTRoot>();
+    auto root = make_node<ASTRoot>();
 
     // ==== Parse DSL in not order dependent manner ==== //
-    auto it = block_parsers.find(current_token().token_type);
-    
     while (pos_ < tokens_.size()) {
         if (match(Tokentype::Config)){
             exec_config_parser(root);
@@ -633,8 +774,22 @@ std::shared_ptr<ASTNode> Parser::parse() {
         else if (match(Tokentype::Strategy)){
             exec_strategy_parser(root);
         }
+        // ==== 'strategy' consumes End, reaching it here means the block is missing ==== //
+        else if (match(Tokentype::End)){
+            throw std::runtime_error("Missing 'strategy' block.");
+        }
+        else {
+            throw_error();
+        }
     }
 
-    return root;
+    tree_->set_root(root);
 
-}
+    // ==== Types, constants and kernels are resolved while the tree is still writable ==== //
+    semanticPass pass(*tree_);
+    pass.run();
+    g_logger.report(std::format("[PARSER] Semantic pass: {} constants folded, {} typed kernels.", pass.folded(), pass.kernels()));
+
+    return tree_;
+
+}
\ No newline at end of file
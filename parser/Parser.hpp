@@ -4,13 +4,14 @@
 #include "lexer/Token.hpp"
 #include "node/Node.hpp"
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 
 
 class Parser {
 public:
-    using BlockHandler = std::function<std::shared_ptr<ASTNode>(Parser&)>;
-    using ptrVector = std::vector<std::shared_ptr<ASTNode>>;
+    using BlockHandler = std::function<ASTNode*(Parser&)>;
+    using ptrVector = std::vector<ASTNode*>;
 
     // ====================================================== //
     //            Restriction on copy constructors
@@ -45,13 +46,19 @@ public:
     // ====================================================== //
 
 
-    std::shared_ptr<ASTNode> parse_comparison();
-    std::shared_ptr<ASTNode> parse_expression();
-    std::shared_ptr<ASTNode> parse_language_operators();
-    std::shared_ptr<ASTNode> parse_term();
-    std::shared_ptr<ASTNode> parse_arithmetics();
-    std::shared_ptr<ASTNode> parse_factor();
-    std::shared_ptr<ASTAction> parse_action();
+    ASTNode* parse_comparison();
+    void parse_crosses(ASTNode*& left);
+    ASTNode* parse_expression();
+    ASTNode* parse_language_operators();
+    ASTNode* parse_term();
+    ASTNode* parse_temporal();
+    ASTNode* parse_bar_count();
+    ASTNode* parse_temporal_function(temporalOp op);
+    ASTNode* parse_lag(ASTNode* series);
+    static bool same_bar_count(const ASTNode* left, const ASTNode* right);
+    ASTNode* parse_arithmetics();
+    ASTNode* parse_factor();
+    ASTAction* parse_action();
 
     // ====================================================== //
 
@@ -62,16 +69,16 @@ public:
     //                  Parse DSL blocks
     // ====================================================== //
 
-    std::shared_ptr<ASTNode> parse_config();
-    std::shared_ptr<ASTNode> parse_strategy();
-    std::shared_ptr<ASTNode> parse_parameters();
-    std::shared_ptr<ASTNode> parse_indicators();
-    std::shared_ptr<ASTNode> parse_entry();
-    std::shared_ptr<ASTNode> parse_exit();
-    std::shared_ptr<ASTNode> parse_block_entry_exit(Tokentype bloctype);
-    std::shared_ptr<ASTNode> parse_data();
+    ASTNode* parse_config();
+    ASTNode* parse_strategy();
+    ASTNode* parse_parameters();
+    ASTNode* parse_indicators();
+    ASTNode* parse_entry();
+    ASTNode* parse_exit();
+    ASTNode* parse_block_entry_exit(Tokentype bloctype);
+    ASTNode* parse_data();
 
-    std::shared_ptr<ASTNode> parse();
+    std::shared_ptr<const syntaxTree> parse();
 
     // ====================================================== //
     
@@ -80,14 +87,14 @@ public:
     // ====================================================== //
     //                   Utility functions
     // ====================================================== //
-    std::shared_ptr<ASTNode> parse_nested_block(Tokentype& block_name);
-    std::shared_ptr<ASTNode> parse_function();
-    std::shared_ptr<ASTNode> parse_argument();
-    std::shared_ptr<Strategy> append_strategy_blocks();
-    std::shared_ptr<ASTAssignment> create_assignment_node(const std::string& identifierName);
-    std::shared_ptr<ASTBlock> create_block_node(Tokentype block_type, NodeMap&& map);
-    void exec_config_parser(std::shared_ptr<ASTRoot>& root);
-    void exec_strategy_parser(std::shared_ptr<ASTRoot>& root);
+    ASTNode* parse_nested_block(Tokentype& block_name);
+    ASTNode* parse_function();
+    ASTNode* parse_argument();
+    Strategy* append_strategy_blocks();
+    ASTAssignment* create_assignment_node(const std::string& identifierName);
+    ASTBlock* create_block_node(Tokentype block_type, NodeMap&& map);
+    void exec_config_parser(ASTRoot* root);
+    void exec_strategy_parser(ASTRoot* root);
 
 
     std::string operator_to_string(OperatorType op);
@@ -100,14 +107,16 @@ public:
     // ====================================================== //
     //                      Variables
     // ====================================================== //
-    std::unordered_map<std::string, std::string> SpecialTypes;
+    // ==== Keys whose value may be a bare identifier (shared by every parser) ==== //
+    static const std::unordered_map<std::string, std::string> SpecialTypes;
+    static const std::unordered_map<std::string, temporalOp> TemporalFunctions;
     // ====================================================== //
 
     //----------------------------------------------------------------------------------------------------------------//
    
 
     // ---------------- Updates state of the left member while parsing conditions ---------------- //
-    void update_node(std::shared_ptr<ASTNode>& left);
+    void update_node(ASTNode*& left);
     void parse_key_value(std::string& key, NodeMap& map);
     void throw_error();
 
@@ -118,34 +127,56 @@ public:
 
     // === Binary node utility function === //
 
-    template <typename T>
-    void update_node(std::shared_ptr<ASTNode>& left ,std::function<std::shared_ptr<ASTNode>()> func){
+    template <typename T, typename Func>
+    void update_node(ASTNode*& left, Func&& func){
 
         // ==== Initialize parameters for logical , arithmetical nodes ==== //
-        std::string op = current_token().value;
+        std::string op(current_token().value);
         Origin origin_operator_type = current_token().operator_origin_;
+        const Token& op_token = current_token();
         // ================================================================ //
 
         consume_token(Tokentype::Operator);
         auto right = func();
         
         // ==== Create node of type T ==== //
-        auto node = std::make_shared<T>();
+        auto node = make_node<T>();
 
         // ==== Initialize parameters for logical , arithmetical nodes ==== //
         node->op = op;
         node->origin_op = origin_operator_type;
         node->left = left;
         node->right = right;
+        node->line = static_cast<uint32_t>(op_token.lineNum);
+        node->col = static_cast<uint32_t>(op_token.colNum);
         left = node;
         // ==== Initialize parameters for logical , arithmetical nodes ==== //
     }
 
     // ===================================== //
+
+    // ==== Every node of this parse is allocated in the tree's arena ==== //
+    astArena& arena(){
+        return tree_->arena();
+    }
+
+    // ==== Nodes take the position of the token being parsed ==== //
+    template <typename T, typename... Args>
+    T* make_node(Args&&... args){
+        T* node = arena().make<T>(std::forward<Args>(args)...);
+        if (pos_ < tokens_.size()){
+            node->line = static_cast<uint32_t>(tokens_[pos_].lineNum);
+            node->col = static_cast<uint32_t>(tokens_[pos_].colNum);
+        }
+        return node;
+    }
+
 private:
     std::vector<Token> tokens_;
     size_t pos_;
+    std::shared_ptr<syntaxTree> tree_;
     
-    std::unordered_map<Tokentype, std::function<std::shared_ptr<ASTNode>()>> block_parsers;
+    // ==== Block keyword -> parser member, built once for all parsers ==== //
+    static const std::unordered_map<Tokentype, ASTNode* (Parser::*)()> block_parsers;
 
 };
@@ -0,0 +1,192 @@
+#include "monteCarlo.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <future>
+#include <stdexcept>
+
+#include "config/slippageTable.hpp"
+#include "log/logHandler.hpp"
+#include "utils/threadPool.hpp"
+
+tradeSample tradeSample::fromResult(const backtestResult& result, double initialEquity){
+    tradeSample sample;
+    sample.initialEquity = initialEquity;
+    const auto& trades = result.trades;
+    sample.pnl = trades.pnl;
+    sample.notional.resize(trades.size());
+
+    for (size_t k = 0; k < trades.size(); k++){
+        sample.notional[k] = trades.qty[k] * (trades.entryPrice[k] + trades.exitPrice[k]);
+    }
+    return sample;
+}
+
+double monteCarloResult::percentile(std::vector<double> values, double q){
+    if (values.empty()) return 0.0;
+
+    const size_t idx = std::min(values.size() - 1, static_cast<size_t>(q * static_cast<double>(values.size() - 1) + 0.5));
+    std::nth_element(values.begin(), values.begin() + idx, values.end());
+    return values[idx];
+}
+
+// ====================================================== //
+//                  Counter-based RNG
+// - SplitMix64 finalizer over a mix of (seed, stream, counter)
+// - No state -> any path can be generated on any thread
+// ====================================================== //
+
+static uint64_t mix64(uint64_t z){
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t counterRandom(uint64_t seed, uint64_t stream, uint64_t counter){
+    return mix64(mix64(seed + 0x9e3779b97f4a7c15ULL * (stream + 1)) + 0x9e3779b97f4a7c15ULL * (counter + 1));
+}
+
+double counterUniform(uint64_t seed, uint64_t stream, uint64_t counter){
+    // 53 high bits -> [0, 1)
+    return static_cast<double>(counterRandom(seed, stream, counter) >> 11) * 0x1.0p-53;
+}
+
+// ==== Unbiased enough for trade counts (< 2^32), avoids modulo bias via multiply-shift ==== //
+static size_t counterIndex(uint64_t seed, uint64_t stream, uint64_t counter, size_t bound){
+    const auto r = static_cast<unsigned __int128>(counterRandom(seed, stream, counter)) * bound;
+    return static_cast<size_t>(r >> 64);
+}
+
+// ====================================================== //
+//                      Path kernels
+// - All kernels fill a per-path pnl buffer, then one shared
+//   pass computes final return and max drawdown
+// ====================================================== //
+
+static void shufflePath(const tradeSample& sample, uint64_t seed, uint64_t path, std::vector<double>& pnl){
+    pnl = sample.pnl;
+    for (size_t i = pnl.size(); i > 1; i--){
+        std::swap(pnl[i - 1], pnl[counterIndex(seed, path, i, i)]);
+    }
+}
+
+// ==== trades: path length, returns may be shorter (cut at the sample's ruin) ==== //
+static void bootstrapPath(const std::vector<double>& returns, size_t trades, size_t blockSize, double initialEquity,
+                          uint64_t seed, uint64_t path, std::vector<double>& pnl){
+    const size_t n = returns.size();
+    pnl.resize(trades);
+
+    double equity = initialEquity;
+    size_t draw{0};
+    for (size_t i = 0; i < trades; draw++){
+        size_t start = counterIndex(seed, path, draw, n);
+        for (size_t b = 0; b < blockSize && i < trades; b++, i++){
+            pnl[i] = equity * returns[(start + b) % n];
+            equity += pnl[i];
+        }
+    }
+}
+
+static void slippagePath(const tradeSample& sample, double meanSlippageBps, uint64_t seed, uint64_t path, std::vector<double>& pnl){
+    pnl.resize(sample.pnl.size());
+    for (size_t i = 0; i < pnl.size(); i++){
+        // ==== Uniform on [0, 2 * mean] bps of traded value ==== //
+        const double bps = 2.0 * meanSlippageBps * counterUniform(seed, path, i);
+        pnl[i] = sample.pnl[i] - sample.notional[i] * bps / 10000.0;
+    }
+}
+
+static void pathStatistics(const std::vector<double>& pnl, double initialEquity, double& finalReturn, double& maxDrawdown){
+    double equity = initialEquity;
+    double peak = initialEquity;
+    double drawdown = 0.0;
+
+    for (double p : pnl){
+        equity += p;
+        // ==== Ruin: the account cannot trade on, later trades are not applied ==== //
+        if (equity <= 0.0){
+            equity = 0.0;
+            drawdown = 1.0;
+            break;
+        }
+        peak = std::max(peak, equity);
+        drawdown = std::max(drawdown, (peak - equity) / peak);
+    }
+
+    finalReturn = (equity - initialEquity) / initialEquity;
+    maxDrawdown = drawdown;
+}
+
+monteCarloResult runMonteCarlo(const tradeSample& sample, const monteCarloOptions& options){
+    if (sample.initialEquity <= 0.0){
+        throw std::runtime_error("Monte Carlo: initial equity must be > 0");
+    }
+    if (sample.pnl.empty()){
+        throw std::runtime_error("Monte Carlo: no closed trades to resample");
+    }
+    if (options.paths == 0){
+        throw std::runtime_error("Monte Carlo: number of paths must be > 0");
+    }
+    if (options.method == resampleMethod::BlockBootstrap && options.blockSize == 0){
+        throw std::runtime_error("Monte Carlo: block size must be > 0");
+    }
+
+    // ==== Per-trade returns on the equity before the trade (bootstrap input), no return after ruin ==== //
+    std::vector<double> returns;
+    returns.reserve(sample.pnl.size());
+    double equity = sample.initialEquity;
+    for (double pnl : sample.pnl){
+        returns.push_back(std::max(-1.0, pnl / equity));
+        equity += pnl;
+        if (equity <= 0.0){
+            g_logger.report(std::format("[MONTECARLO] Sample ruined after {} of {} trades, bootstrap uses those only",
+                returns.size(), sample.pnl.size()));
+            break;
+        }
+    }
+
+    double meanSlippageBps{0};
+    if (options.method == resampleMethod::SlippageShock){
+        auto it = slippageTable.find(options.regime);
+        if (it == slippageTable.end()) throw std::runtime_error("Unknown slippageRegime");
+        meanSlippageBps = it->second.at("slippage");
+    }
+
+    monteCarloResult result;
+    result.finalReturn.resize(options.paths);
+    result.maxDrawdown.resize(options.paths);
+
+    threadPool pool(options.threads);
+    const size_t chunk = (options.paths + pool.size() - 1) / pool.size();
+
+    // ==== Each task writes a disjoint slice of the output ==== //
+    std::vector<std::future<void>> pending;
+    for (size_t first = 0; first < options.paths; first += chunk){
+        const size_t last = std::min(first + chunk, options.paths);
+        pending.push_back(pool.submit([&, first, last](){
+            std::vector<double> pnl;
+            pnl.reserve(sample.pnl.size());
+
+            for (size_t path = first; path < last; path++){
+                switch (options.method){
+                    case resampleMethod::Shuffle:
+                        shufflePath(sample, options.seed, path, pnl);
+                        break;
+                    case resampleMethod::BlockBootstrap:
+                        bootstrapPath(returns, sample.pnl.size(), options.blockSize, sample.initialEquity, options.seed, path, pnl);
+                        break;
+                    case resampleMethod::SlippageShock:
+                        slippagePath(sample, meanSlippageBps, options.seed, path, pnl);
+                        break;
+                }
+                pathStatistics(pnl, sample.initialEquity, result.finalReturn[path], result.maxDrawdown[path]);
+            }
+        }));
+    }
+
+    for (auto& future : pending) future.get();
+
+    g_logger.report(std::format("[MONTECARLO] {} paths over {} trades done", options.paths, sample.pnl.size()));
+    return result;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "config/configTypes.hpp"
+#include "backtester/backtestResult.hpp"
+
+// ====================================================== //
+//           Monte Carlo robustness on trade sequences
+// - Works on compact per-trade arrays (no trade structs/strings)
+// - Each path owns an RNG stream keyed by (seed, path, draw):
+//   results do not depend on the number of threads
+// - Equity is floored at 0: a path stops at ruin (-100%),
+//   bootstrap returns stop at the sample's ruin trade
+// ====================================================== //
+
+enum class resampleMethod {
+    Shuffle,          // permute trade order
+    BlockBootstrap,   // resample per-trade returns in circular blocks
+    SlippageShock     // original order, random extra slippage per trade
+};
+
+struct monteCarloOptions {
+    resampleMethod method = resampleMethod::Shuffle;
+    size_t paths = 1000;
+    size_t blockSize = 5;
+    uint64_t seed = 42;
+    size_t threads = 0;                 // 0 -> hardware concurrency
+    Slippage regime = Slippage::base;   // slippageTable row used by SlippageShock
+};
+
+// ==== Closed trades as columns ==== //
+struct tradeSample {
+    double initialEquity = 0.0;
+    std::vector<double> pnl;
+    std::vector<double> notional;       // entry + exit traded value, base of slippage cost
+
+    static tradeSample fromResult(const backtestResult& result, double initialEquity);
+};
+
+struct monteCarloResult {
+    std::vector<double> finalReturn;    // per path, fraction of initial equity
+    std::vector<double> maxDrawdown;    // per path, fraction of running peak
+
+    static double percentile(std::vector<double> values, double q);
+};
+
+// ==== Counter-based generator: value depends only on its inputs ==== //
+uint64_t counterRandom(uint64_t seed, uint64_t stream, uint64_t counter);
+double counterUniform(uint64_t seed, uint64_t stream, uint64_t counter);
+
+monteCarloResult runMonteCarlo(const tradeSample& sample, const monteCarloOptions& options);
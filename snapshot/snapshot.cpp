@@ -0,0 +1,115 @@
+#include "snapshot.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <format>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char SNAPSHOT_MAGIC[8] = {'O', 'C', 'T', 'S', 'N', 'A', 'P', '\0'};
+
+struct snapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t payloadSize;
+    uint64_t checksum;
+};
+
+// ==== FNV-1a 64 ==== //
+uint64_t checksum(const char* data, size_t size){
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < size; i++){
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// ==== Closes the descriptor on every exit path ==== //
+struct fileDescriptor {
+    int fd;
+    ~fileDescriptor() { if (fd >= 0) ::close(fd); }
+};
+
+}
+
+void writeSnapshotFile(const std::string& path, const std::vector<char>& payload){
+    const std::string tmpPath = path + ".tmp";
+    const size_t total = sizeof(snapshotHeader) + payload.size();
+
+    fileDescriptor file{::open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)};
+    if (file.fd < 0) {
+        throw std::runtime_error(std::format("Unable to open snapshot {} (errno {})", tmpPath, errno));
+    }
+    if (::ftruncate(file.fd, static_cast<off_t>(total)) != 0) {
+        throw std::runtime_error(std::format("Unable to size snapshot {} (errno {})", tmpPath, errno));
+    }
+
+    void* map = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+    if (map == MAP_FAILED) {
+        throw std::runtime_error(std::format("Unable to map snapshot {} (errno {})", tmpPath, errno));
+    }
+
+    snapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.payloadSize = payload.size();
+    header.checksum = checksum(payload.data(), payload.size());
+
+    auto* out = static_cast<char*>(map);
+    std::memcpy(out, &header, sizeof(header));
+    if (!payload.empty()) std::memcpy(out + sizeof(header), payload.data(), payload.size());
+
+    const bool synced = ::msync(map, total, MS_SYNC) == 0;
+    ::munmap(map, total);
+
+    if (!synced || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error(std::format("Unable to commit snapshot {} (errno {})", path, errno));
+    }
+}
+
+mappedSnapshot::mappedSnapshot(const std::string& path){
+    fileDescriptor file{::open(path.c_str(), O_RDONLY)};
+    if (file.fd < 0) {
+        throw std::runtime_error(std::format("Unable to open snapshot {} (errno {})", path, errno));
+    }
+
+    struct stat info{};
+    if (::fstat(file.fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(snapshotHeader)) {
+        throw std::runtime_error(std::format("Snapshot {} is too small", path));
+    }
+
+    mapSize_ = static_cast<size_t>(info.st_size);
+    map_ = ::mmap(nullptr, mapSize_, PROT_READ, MAP_PRIVATE, file.fd, 0);
+    if (map_ == MAP_FAILED) {
+        map_ = nullptr;
+        throw std::runtime_error(std::format("Unable to map snapshot {} (errno {})", path, errno));
+    }
+
+    snapshotHeader header;
+    std::memcpy(&header, map_, sizeof(header));
+    payload_ = static_cast<const char*>(map_) + sizeof(header);
+    payloadSize_ = mapSize_ - sizeof(header);
+
+    const char* error = nullptr;
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) error = "is not a snapshot";
+    else if (header.version != SNAPSHOT_VERSION) error = "has an unsupported version";
+    else if (header.payloadSize != payloadSize_) error = "is truncated";
+    else if (header.checksum != checksum(payload_, payloadSize_)) error = "is corrupted";
+
+    if (error) {
+        ::munmap(map_, mapSize_);
+        map_ = nullptr;
+        throw std::runtime_error(std::format("Snapshot {} {}", path, error));
+    }
+}
+
+mappedSnapshot::~mappedSnapshot(){
+    if (map_) ::munmap(map_, mapSize_);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// ====================================================== //
+//                   Binary snapshots
+// - Layout: header (magic, version, payload size, checksum)
+//   followed by the raw payload, host byte order
+// - Writer appends into one reusable buffer, reader walks
+//   the memory-mapped file in place (no copy, no parsing)
+// - Only meant to be read back by the same build/platform
+// ====================================================== //
+
+#define SNAPSHOT_VERSION 4
+
+class snapshotWriter {
+    private:
+        std::vector<char> buffer_;
+
+    public:
+        void clear() { buffer_.clear(); }
+        const std::vector<char>& bytes() const { return buffer_; }
+
+        template <typename T>
+        void put(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "snapshot values must be trivially copyable");
+            const auto* raw = reinterpret_cast<const char*>(&value);
+            buffer_.insert(buffer_.end(), raw, raw + sizeof(T));
+        }
+
+        template <typename T>
+        void putVector(const std::vector<T>& values) {
+            static_assert(std::is_trivially_copyable_v<T>, "snapshot values must be trivially copyable");
+            put<uint64_t>(values.size());
+            const auto* raw = reinterpret_cast<const char*>(values.data());
+            buffer_.insert(buffer_.end(), raw, raw + values.size() * sizeof(T));
+        }
+
+        void putString(const std::string& value) {
+            put<uint64_t>(value.size());
+            buffer_.insert(buffer_.end(), value.begin(), value.end());
+        }
+};
+
+class snapshotReader {
+    private:
+        const char* data_;
+        size_t size_;
+        size_t offset_ = 0;
+
+        const char* take(size_t n) {
+            if (n > size_ - offset_) throw std::runtime_error("Snapshot is truncated");
+            const char* at = data_ + offset_;
+            offset_ += n;
+            return at;
+        }
+
+    public:
+        snapshotReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+        template <typename T>
+        T get() {
+            static_assert(std::is_trivially_copyable_v<T>, "snapshot values must be trivially copyable");
+            T value;
+            std::memcpy(&value, take(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        void getVector(std::vector<T>& values) {
+            const auto n = get<uint64_t>();
+            if (n > (size_ - offset_) / sizeof(T)) throw std::runtime_error("Snapshot is truncated");
+            values.resize(n);
+            std::memcpy(values.data(), take(n * sizeof(T)), n * sizeof(T));
+        }
+
+        std::string getString() {
+            const auto n = get<uint64_t>();
+            const char* at = take(n);
+            return std::string(at, n);
+        }
+
+        bool done() const { return offset_ == size_; }
+};
+
+// ==== Writes <path>.tmp through mmap, then renames over <path> (old snapshot survives a crash) ==== //
+void writeSnapshotFile(const std::string& path, const std::vector<char>& payload);
+
+// ====================================================== //
+//              Read-only mapping of a snapshot
+// - Header and checksum are validated on open
+// ====================================================== //
+class mappedSnapshot {
+    private:
+        void* map_ = nullptr;
+        size_t mapSize_ = 0;
+        const char* payload_ = nullptr;
+        size_t payloadSize_ = 0;
+
+    public:
+        explicit mappedSnapshot(const std::string& path);
+        ~mappedSnapshot();
+
+        mappedSnapshot(const mappedSnapshot&) = delete;
+        mappedSnapshot& operator=(const mappedSnapshot&) = delete;
+
+        snapshotReader reader() const { return snapshotReader(payload_, payloadSize_); }
+};
@@ -1,4 +1,5 @@
 #include "polygonDataFeed.hpp"
+#include "utils/timeIndex.hpp"
 #include <iostream>
 
 polygonDataFeed::polygonDataFeed(polygonClient&& client) : client_(std::move(client)) {};
@@ -7,7 +8,8 @@ std::unordered_map<std::string, AnyValue> polygonDataFeed::loadBars(const std::s
     
     nlohmann::json json = client_.fetchData(ticker,multiplier,from,to,timespan);
 
-    std::vector<double> open, high, low, close, volume, timestamp;
+    std::vector<double> open, high, low, close, volume;
+    timeSeries timestamp;
 
     auto n = json["results"].size();
     open.reserve(n);
@@ -23,7 +25,7 @@ std::unordered_map<std::string, AnyValue> polygonDataFeed::loadBars(const std::s
         low.emplace_back(bar["l"].get<double>());
         close.emplace_back(bar["c"].get<double>());
         volume.emplace_back(bar["v"].get<double>());
-        timestamp.emplace_back(static_cast<double>(bar["t"].get<int64_t>()));
+        timestamp.emplace_back(msToNs(bar["t"].get<int64_t>()));
     }
 
     const auto base = ticker + "_";
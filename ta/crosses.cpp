@@ -0,0 +1,176 @@
+#include "crosses.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+// ==== AVX2 kernel is built for a target("avx2") clone and picked at run time, no -mavx2 needed ==== //
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CROSS_AVX2_KERNEL 1
+#include <immintrin.h>
+#else
+#define CROSS_AVX2_KERNEL 0
+#endif
+
+// ================================================================================== //
+// Per block of up to 64 bars:
+//   now    -> bit j: strict comparison holds on bar base + j (> for above, < for below)
+//   before -> bit j: weak comparison holds on bar base + j   (<= for above, >= for below)
+// All comparisons are ordered (false on NaN).
+// ================================================================================== //
+
+namespace {
+
+template <bool Above>
+inline bool strict_cmp(double l, double r){
+    if constexpr (Above) return l > r;
+    else return l < r;
+}
+
+template <bool Above>
+inline bool weak_cmp(double l, double r){
+    if constexpr (Above) return l <= r;
+    else return l >= r;
+}
+
+template <bool Above, bool Threshold>
+inline void block_masks_tail(const double* left, const double* right, double threshold, size_t j, size_t count, uint64_t& now, uint64_t& before){
+    for (; j < count; ++j){
+        const double r = Threshold ? threshold : right[j];
+        now |= static_cast<uint64_t>(strict_cmp<Above>(left[j], r)) << j;
+        before |= static_cast<uint64_t>(weak_cmp<Above>(left[j], r)) << j;
+    }
+}
+
+template <bool Above, bool Threshold>
+inline void block_masks(const double* left, const double* right, double threshold, size_t count, uint64_t& now, uint64_t& before){
+    now = 0;
+    before = 0;
+    block_masks_tail<Above, Threshold>(left, right, threshold, 0, count, now, before);
+}
+
+#if CROSS_AVX2_KERNEL
+template <bool Above, bool Threshold>
+__attribute__((target("avx2"))) inline void block_masks_avx2(const double* left, const double* right, double threshold, size_t count,
+                                                            uint64_t& now, uint64_t& before){
+    constexpr int STRICT = Above ? _CMP_GT_OQ : _CMP_LT_OQ;
+    constexpr int WEAK = Above ? _CMP_LE_OQ : _CMP_GE_OQ;
+    const __m256d t = _mm256_set1_pd(threshold);
+
+    now = 0;
+    before = 0;
+    size_t j = 0;
+    for (; j + 4 <= count; j += 4){
+        const __m256d l = _mm256_loadu_pd(left + j);
+        const __m256d r = Threshold ? t : _mm256_loadu_pd(right + j);
+        now |= static_cast<uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(l, r, STRICT))) << j;
+        before |= static_cast<uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(l, r, WEAK))) << j;
+    }
+    block_masks_tail<Above, Threshold>(left, right, threshold, j, count, now, before);
+}
+#endif
+
+template <bool Above, bool Threshold, bool Avx2>
+inline void cross_kernel(const double* left, const double* right, double threshold, size_t n, uint64_t* words){
+    // ==== Weak comparison of the last bar of the previous block, 0 before bar 0 ==== //
+    uint64_t carry = 0;
+
+    for (size_t w = 0, base = 0; base < n; ++w, base += 64){
+        const size_t count = std::min<size_t>(64, n - base);
+        const double* right_block = Threshold ? nullptr : right + base;
+        uint64_t now, before;
+#if CROSS_AVX2_KERNEL
+        if constexpr (Avx2) block_masks_avx2<Above, Threshold>(left + base, right_block, threshold, count, now, before);
+        else
+#endif
+        block_masks<Above, Threshold>(left + base, right_block, threshold, count, now, before);
+
+        words[w] = now & ((before << 1) | carry);
+        carry = (before >> (count - 1)) & 1u;
+    }
+}
+
+#if CROSS_AVX2_KERNEL
+template <bool Above, bool Threshold>
+__attribute__((target("avx2"))) void cross_kernel_avx2(const double* left, const double* right, double threshold, size_t n, uint64_t* words){
+    cross_kernel<Above, Threshold, true>(left, right, threshold, n, words);
+}
+#endif
+
+template <bool Threshold>
+void run_kernel(const double* left, const double* right, double threshold, size_t n, crossDirection direction, crossKernel kernel,
+                uint64_t* words){
+    if (kernel == crossKernel::Auto){
+        kernel = cross_kernel_available(crossKernel::AVX2) ? crossKernel::AVX2 : crossKernel::Scalar;
+    } else if (!cross_kernel_available(kernel)){
+        throw std::runtime_error("crosses: AVX2 kernel is not available on this CPU.");
+    }
+
+#if CROSS_AVX2_KERNEL
+    if (kernel == crossKernel::AVX2){
+        if (direction == crossDirection::Above) cross_kernel_avx2<true, Threshold>(left, right, threshold, n, words);
+        else cross_kernel_avx2<false, Threshold>(left, right, threshold, n, words);
+        return;
+    }
+#endif
+
+    if (direction == crossDirection::Above) cross_kernel<true, Threshold, false>(left, right, threshold, n, words);
+    else cross_kernel<false, Threshold, false>(left, right, threshold, n, words);
+}
+
+}
+
+bool cross_kernel_available(crossKernel kernel){
+    if (kernel != crossKernel::AVX2) return true;
+#if CROSS_AVX2_KERNEL
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void cross_mask(const double* left, const double* right, size_t n, crossDirection direction, uint64_t* words, crossKernel kernel){
+    run_kernel<false>(left, right, 0.0, n, direction, kernel, words);
+}
+
+void cross_mask(const double* left, double threshold, size_t n, crossDirection direction, uint64_t* words, crossKernel kernel){
+    run_kernel<true>(left, nullptr, threshold, n, direction, kernel, words);
+}
+
+std::vector<bool> cross_signals(const std::vector<double>& left, const std::vector<double>& right, crossDirection direction){
+    if (left.size() != right.size()){
+        throw std::runtime_error("crosses: both series must have the same length.");
+    }
+    std::vector<uint64_t> words(signal_words(left.size()));
+    cross_mask(left.data(), right.data(), left.size(), direction, words.data());
+    return unpack_signals(words, left.size());
+}
+
+std::vector<bool> cross_signals(const std::vector<double>& left, double threshold, crossDirection direction){
+    std::vector<uint64_t> words(signal_words(left.size()));
+    cross_mask(left.data(), threshold, left.size(), direction, words.data());
+    return unpack_signals(words, left.size());
+}
+
+// ==== Bar start has no valid previous bar on at least one side: the kernel's bar 0, never a cross ==== //
+std::vector<bool> cross_signals(const Octurn::seriesView& left, const Octurn::seriesView& right, crossDirection direction){
+    if (left.size != right.size){
+        throw std::runtime_error("crosses: both series must have the same length.");
+    }
+    const size_t start = std::max(left.lag, right.lag);
+    if (start >= left.size) return std::vector<bool>(left.size, false);
+
+    const size_t n = left.size - start;
+    std::vector<uint64_t> words(signal_words(n));
+    cross_mask(left.data + (start - left.lag), right.data + (start - right.lag), n, direction, words.data());
+    return unpack_signals(words, left.size, start);
+}
+
+std::vector<bool> cross_signals(const Octurn::seriesView& left, double threshold, crossDirection direction){
+    if (left.lag >= left.size) return std::vector<bool>(left.size, false);
+
+    const size_t n = left.size - left.lag;
+    std::vector<uint64_t> words(signal_words(n));
+    cross_mask(left.data, threshold, n, direction, words.data());
+    return unpack_signals(words, left.size, left.lag);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ta/signalMask.hpp"
+#include "types/types.hpp"
+
+// ================================================================================== //
+// @brief Crossing signals (crosses above / crosses below)
+//
+//   left crosses above right on bar i  <=>  left[i-1] <= right[i-1] && left[i] > right[i]
+//   left crosses below right on bar i  <=>  left[i-1] >= right[i-1] && left[i] < right[i]
+//
+// @attention
+//   * Bar 0 never crosses (no previous bar)
+//   * Ordered comparisons: a NaN on either bar (indicator warm-up) gives no signal
+//   * One pass over the inputs, 64 bars per step: both comparisons are packed into
+//     bit masks (AVX2 compares when the CPU has them, checked once at run time),
+//     the crossing is now & (before << 1), no comparison vector is materialized
+// ================================================================================== //
+
+enum class crossDirection { Above, Below };
+
+// ==== Auto: AVX2 when available, else scalar. Both give the same masks ==== //
+enum class crossKernel { Auto, Scalar, AVX2 };
+
+bool cross_kernel_available(crossKernel kernel);
+
+// ==== words: signal_words(n), bit (i % 64) of words[i / 64] is set when bar i crosses ==== //
+// ==== An explicit kernel the CPU lacks throws ==== //
+void cross_mask(const double* left, const double* right, size_t n, crossDirection direction, uint64_t* words,
+                crossKernel kernel = crossKernel::Auto);
+void cross_mask(const double* left, double threshold, size_t n, crossDirection direction, uint64_t* words,
+                crossKernel kernel = crossKernel::Auto);
+
+// ==== Same as the masks, unpacked into the signal type the backtester takes ==== //
+std::vector<bool> cross_signals(const std::vector<double>& left, const std::vector<double>& right, crossDirection direction);
+std::vector<bool> cross_signals(const std::vector<double>& left, double threshold, crossDirection direction);
+
+// ==== Lagged operands read in place: the kernel runs from the first bar valid on both sides ==== //
+std::vector<bool> cross_signals(const Octurn::seriesView& left, const Octurn::seriesView& right, crossDirection direction);
+std::vector<bool> cross_signals(const Octurn::seriesView& left, double threshold, crossDirection direction);
@@ -0,0 +1,21 @@
+#include "signalMask.hpp"
+
+#include <bit>
+
+std::vector<uint64_t> pack_signals(const std::vector<bool>& signals){
+    std::vector<uint64_t> words(signal_words(signals.size()), 0);
+    for (size_t i = 0; i < signals.size(); ++i){
+        words[i / 64] |= static_cast<uint64_t>(signals[i]) << (i % 64);
+    }
+    return words;
+}
+
+std::vector<bool> unpack_signals(const std::vector<uint64_t>& words, size_t n, size_t offset){
+    std::vector<bool> signals(n, false);
+    for (size_t w = 0; w < words.size(); ++w){
+        for (uint64_t bits = words[w]; bits; bits &= bits - 1){
+            signals[offset + w * 64 + static_cast<size_t>(std::countr_zero(bits))] = true;
+        }
+    }
+    return signals;
+}
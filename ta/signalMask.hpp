@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ================================================================================== //
+// @brief Packed signals: bit (i % 64) of words[i / 64] holds bar i
+//
+// @attention
+//   * Bits past the last bar are always 0
+//   * Kernels over signals (ta/crosses, ta/temporal) work on words, the Visitor
+//     and the backtester keep std::vector<bool>: these convert at the boundary
+// ================================================================================== //
+
+// ==== Words needed for n bars ==== //
+constexpr size_t signal_words(size_t n){
+    return (n + 63) / 64;
+}
+
+std::vector<uint64_t> pack_signals(const std::vector<bool>& signals);
+
+// ==== Only set bits are written: signals are sparse. Bit i lands on bar offset + i ==== //
+std::vector<bool> unpack_signals(const std::vector<uint64_t>& words, size_t n, size_t offset = 0);
@@ -25,7 +25,7 @@
 // ================================================================================== //
 
 std::vector<double> MA(const multiValue& args,
-                       std::unordered_map<std::string, AnyValue>& variables_,std::unordered_map<std::string, AnyValue>& data_) 
+                       std::unordered_map<std::string, AnyValue>& variables_,const std::unordered_map<std::string, AnyValue>& data_) 
 {
     std::vector<double> result;
 
@@ -43,7 +43,11 @@ std::vector<double> MA(const multiValue& args,
     if (std::holds_alternative<std::string>(args[0])) {
         // args[0] is the name of a data series in `data`
         series_name = std::get<std::string>(args[0]);
-        series      = std::get<std::vector<double>>(data_[series_name]);
+        auto it = data_.find(series_name);
+        if (it == data_.end()) {
+            throw std::runtime_error("MA: series passed to the function is not loaded.");
+        }
+        series      = std::get<std::vector<double>>(it->second);
     } else {
         // args[0] is already a vector<double>
         series = std::get<std::vector<double>>(args[0]);
@@ -106,7 +110,7 @@ std::vector<double> MA(const multiValue& args,
 //         Values range from 0 to 100. Early values before the period are NaN.
 // ================================================================================== //
 std::vector<double> RSI(const multiValue& args,
-                        std::unordered_map<std::string, AnyValue>& variables_,std::unordered_map<std::string, AnyValue>& data_) 
+                        std::unordered_map<std::string, AnyValue>& variables_,const std::unordered_map<std::string, AnyValue>& data_) 
 {
     // --- 1. Extract and validate inputs --- //
 
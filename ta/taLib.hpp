@@ -4,5 +4,5 @@
 using Octurn::multiValue;
 using Octurn::AnyValue;
 
-std::vector<double> MA(const multiValue& args, std::unordered_map<std::string,AnyValue>& variables_,std::unordered_map<std::string, AnyValue>& data_);
-std::vector<double> RSI(const multiValue& args, std::unordered_map<std::string,AnyValue>& variables_,std::unordered_map<std::string, AnyValue>& data_);
+std::vector<double> MA(const multiValue& args, std::unordered_map<std::string,AnyValue>& variables_,const std::unordered_map<std::string, AnyValue>& data_);
+std::vector<double> RSI(const multiValue& args, std::unordered_map<std::string,AnyValue>& variables_,const std::unordered_map<std::string, AnyValue>& data_);
@@ -0,0 +1,139 @@
+#include "temporal.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+inline bool bit(const uint64_t* words, size_t i){
+    return (words[i / 64] >> (i % 64)) & 1u;
+}
+
+// ==== Bits [from, 64) of a word, 0 when from >= 64 ==== //
+inline uint64_t bits_from(size_t from){
+    return from >= 64 ? 0 : ~uint64_t{0} << from;
+}
+
+// ==== Bits [0, to) of a word ==== //
+inline uint64_t bits_below(size_t to){
+    return to >= 64 ? ~uint64_t{0} : (uint64_t{1} << to) - 1;
+}
+
+}
+
+// ==== Run-length scan ==== //
+void held_for(const uint64_t* words, size_t n, size_t bars, uint64_t* out){
+    size_t run = 0;
+
+    for (size_t w = 0, base = 0; base < n; ++w, base += 64){
+        const size_t count = std::min<size_t>(64, n - base);
+        const uint64_t word = words[w];
+
+        if (word == 0){
+            run = 0;
+            out[w] = 0;
+            continue;
+        }
+        // ==== Whole block set: bar base + j holds when run + j + 1 >= bars ==== //
+        if (count == 64 && word == ~uint64_t{0}){
+            out[w] = bits_from(run + 1 >= bars ? 0 : bars - run - 1);
+            run += 64;
+            continue;
+        }
+
+        uint64_t result = 0;
+        for (size_t j = 0; j < count; ++j){
+            run = ((word >> j) & 1u) ? run + 1 : 0;
+            result |= static_cast<uint64_t>(run >= bars) << j;
+        }
+        out[w] = result;
+    }
+}
+
+// ==== Sliding popcount: + the bar entering the window, - the bar leaving it ==== //
+void held_count(const uint64_t* words, size_t n, size_t window, size_t required, uint64_t* out){
+    size_t held = 0;
+
+    for (size_t w = 0, base = 0; base < n; ++w, base += 64){
+        const size_t count = std::min<size_t>(64, n - base);
+        uint64_t result = 0;
+
+        for (size_t j = 0; j < count; ++j){
+            const size_t i = base + j;
+            held += bit(words, i);
+            if (i >= window) held -= bit(words, i - window);
+            result |= static_cast<uint64_t>(held >= required) << j;
+        }
+        out[w] = result;
+    }
+}
+
+// ==== Last set bar scan ==== //
+void within_bars(const uint64_t* words, size_t n, size_t bars, uint64_t* out){
+    // ==== Bars up to (not including) this index are still in reach of the last set bar ==== //
+    size_t reach = 0;
+
+    for (size_t w = 0, base = 0; base < n; ++w, base += 64){
+        const size_t count = std::min<size_t>(64, n - base);
+        const uint64_t word = words[w];
+
+        if (word == 0){
+            out[w] = (reach > base) ? bits_below(reach - base) & bits_below(count) : 0;
+            continue;
+        }
+
+        uint64_t result = 0;
+        for (size_t j = 0; j < count; ++j){
+            const size_t i = base + j;
+            if ((word >> j) & 1u) reach = i + bars;
+            result |= static_cast<uint64_t>(i < reach) << j;
+        }
+        out[w] = result;
+    }
+}
+
+void count_window(const uint64_t* words, size_t n, size_t window, double* out){
+    size_t held = 0;
+    for (size_t i = 0; i < n; ++i){
+        held += bit(words, i);
+        if (i >= window) held -= bit(words, i - window);
+        out[i] = static_cast<double>(held);
+    }
+}
+
+void bars_since(const uint64_t* words, size_t n, double* out){
+    bool seen = false;
+    size_t last = 0;
+
+    for (size_t w = 0, base = 0; base < n; ++w, base += 64){
+        const size_t count = std::min<size_t>(64, n - base);
+        const uint64_t word = words[w];
+
+        for (size_t j = 0; j < count; ++j){
+            const size_t i = base + j;
+            if ((word >> j) & 1u){
+                seen = true;
+                last = i;
+            }
+            out[i] = seen ? static_cast<double>(i - last) : NaN;
+        }
+    }
+}
+
+void highest_since(const uint64_t* words, const double* values, size_t n, double* out){
+    double highest = NaN;
+    bool seen = false;
+
+    for (size_t i = 0; i < n; ++i){
+        if (bit(words, i)){
+            seen = true;
+            highest = values[i];
+        } else if (seen && (std::isnan(highest) || values[i] > highest)){
+            highest = values[i];
+        }
+        out[i] = highest;
+    }
+}
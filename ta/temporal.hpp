@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "ta/signalMask.hpp"
+
+// ================================================================================== //
+// @brief Temporal operators over packed signals (see ta/signalMask.hpp)
+//
+//   held_for       -> bar i: signal set on bars i-N+1 .. i           (run length >= N)
+//   held_count     -> bar i: signal set on at least K of bars i-N+1 .. i
+//   within_bars    -> bar i: signal set on at least one of bars i-N+1 .. i
+//   count_window   -> number of set bars among i-N+1 .. i
+//   bars_since     -> bars since the last set bar (0 on a set bar)
+//   highest_since  -> highest value since the last set bar, that bar included
+//
+// @attention
+//   * One pass each, O(n) whatever the window: a running length / last set bar /
+//     sliding popcount is carried instead of rescanning N bars. Empty words skip
+//     the per-bar work when the state allows it
+//   * Windows are cut at bar 0: the first bars count over fewer than N bars,
+//     so held_for / held_count stay false until enough bars are set
+//   * bars_since / highest_since are NaN until the signal has been set once;
+//     NaN values are skipped by highest_since
+//   * Input words must have 0 past the last bar, output words are the same shape
+// ================================================================================== //
+
+void held_for(const uint64_t* words, size_t n, size_t bars, uint64_t* out);
+void held_count(const uint64_t* words, size_t n, size_t window, size_t required, uint64_t* out);
+void within_bars(const uint64_t* words, size_t n, size_t bars, uint64_t* out);
+
+void count_window(const uint64_t* words, size_t n, size_t window, double* out);
+void bars_since(const uint64_t* words, size_t n, double* out);
+void highest_since(const uint64_t* words, const double* values, size_t n, double* out);
@@ -0,0 +1,208 @@
+#include "tests/testSupport.hpp"
+
+#include <filesystem>
+#include <stdexcept>
+
+#include "backtester/portfolioBacktester.hpp"
+#include "config/slippageTable.hpp"
+#include "execution/executionEngine.hpp"
+
+// ====================================================== //
+//                  Checkpoint / resume
+// - One snapshot taken mid-run, a fresh backtester
+//   resumes from it and finishes the run
+// - Trades, equity and the equity curve must equal the
+//   uninterrupted run bit for bit
+// - Tickers are staggered on the timeline: ticker k's bar i
+//   sits at timeline position 3 * i + k
+// - Snapshots mid-run, and exactly at an entry / exit:
+//   the resumed run starts on the event's step or right
+//   after it
+// - Book orders live at the snapshot resume with it
+// ====================================================== //
+
+static const std::vector<std::string> TICKERS{"A", "B", "C"};
+
+// ==== Tickers of case `index`, staggered by 1000 ns: bar i of ticker k is timeline step 3 * i + k ==== //
+struct fixtureRun {
+    fixtureCase market;
+    const std::unordered_map<std::string, AnyValue>& data;
+    std::vector<std::vector<bool>> entries;
+    std::vector<std::vector<bool>> exits;
+
+    fixtureRun(uint32_t index, size_t bars, bool signals) : market(index, TICKERS, bars, 1000), data(*market.data) {
+        for (size_t k = 0; k < TICKERS.size(); k++){
+            entries.push_back(signals ? fixtureSignals(market.rng, bars, 7) : std::vector<bool>(bars, false));
+            exits.push_back(signals ? fixtureSignals(market.rng, bars, 9) : std::vector<bool>(bars, false));
+        }
+    }
+
+    void setup(portfolioBacktester& backtester, size_t tickers) const {
+        for (size_t k = 0; k < tickers; k++) backtester.addTicker(TICKERS[k], entries[k], exits[k]);
+    }
+};
+
+// ==== Book orders on every ticker: a TWAP and a resting stop are live at bar 200 ==== //
+static void submitOrders(portfolioBacktester& backtester, const std::unordered_map<std::string, AnyValue>& data){
+    for (uint32_t k = 0; k < TICKERS.size(); k++){
+        const auto& open = std::get<std::vector<double>>(data.at(TICKERS[k] + "_open"));
+
+        order limit{orderKind::Limit, ordertype::Buy, 5.0};
+        limit.limitPrice = open[40] * 0.98;
+        order trailing{orderKind::TrailingStop, ordertype::Sell, 5.0};
+        trailing.trailBps = 200;
+        order twap{orderKind::TWAP, ordertype::Buy, 30.0};
+        twap.slices = 40;
+        order stop{orderKind::Stop, ordertype::Sell, 10.0};
+        stop.stopPrice = open[190] * 0.97;
+
+        backtester.submitOrder(k, limit, 40);
+        backtester.submitOrder(k, trailing, 60);
+        backtester.submitOrder(k, twap, 180);
+        backtester.submitOrder(k, stop, 190);
+    }
+}
+
+// ==== Snapshot in the middle of the TWAPs: pending orders and the ledger must come back ==== //
+static void bookOrdersAcrossSnapshot(const std::string& path){
+    const fixtureRun fixture(0, 400, false);
+
+    std::unordered_map<std::string, AnyValue> variables;
+    config cfg(&variables);
+    cfg.equity = 10000;
+    cfg.commissionBps = 0.5;
+    cfg.spread = 1;
+    cfg.cashYieldBps = 300;
+    cfg.slippage = ExecutionEngine::getSlippageParams(cfg, slippageTable);
+
+    portfolioBacktester uninterrupted(fixture.data, cfg);
+    fixture.setup(uninterrupted, TICKERS.size());
+    submitOrders(uninterrupted, fixture.data);
+    uninterrupted.execute();
+    const auto expected = uninterrupted.result();
+
+    portfolioBacktester interrupted(fixture.data, cfg);
+    fixture.setup(interrupted, TICKERS.size());
+    submitOrders(interrupted, fixture.data);
+    interrupted.enableCheckpoints(path, 3 * 200 + 1);
+    interrupted.execute();
+
+    // ==== No submitOrder() on the resumed run: its orders come from the snapshot ==== //
+    portfolioBacktester resumed(fixture.data, cfg);
+    fixture.setup(resumed, TICKERS.size());
+    resumed.resume(path);
+
+    size_t pending = 0;
+    for (uint32_t k = 0; k < TICKERS.size(); k++) pending += resumed.executionLayer_.orders().pending(k);
+    CHECK(pending >= TICKERS.size());
+
+    resumed.execute();
+    const auto actual = resumed.result();
+
+    const auto& expectedLedger = uninterrupted.executionLayer_.ledger();
+    const auto& actualLedger = resumed.executionLayer_.ledger();
+    for (uint32_t k = 0; k < TICKERS.size(); k++){
+        CHECK(actualLedger.position(k).netQty == expectedLedger.position(k).netQty);
+        CHECK(actualLedger.position(k).avgCost == expectedLedger.position(k).avgCost);
+        CHECK(actualLedger.position(k).realizedPnL == expectedLedger.position(k).realizedPnL);
+    }
+    CHECK(actual.metrics.equityCurve() == expected.metrics.equityCurve());
+    CHECK(actual.realizedPnL == expected.realizedPnL);
+    CHECK(actual.finalEquity == expected.finalEquity);
+}
+
+// ==== One snapshot after step `at - 1`: the resumed run must finish exactly like the uninterrupted one ==== //
+static void checkResume(const fixtureRun& fixture, const config& cfg, const backtestResult& expected, size_t at, const std::string& path){
+    config runCfg = cfg;
+    portfolioBacktester interrupted(fixture.data, runCfg);
+    fixture.setup(interrupted, TICKERS.size());
+    interrupted.enableCheckpoints(path, at);
+    interrupted.execute();
+
+    portfolioBacktester resumed(fixture.data, runCfg);
+    fixture.setup(resumed, TICKERS.size());
+    resumed.resume(path);
+    resumed.execute();
+    const auto actual = resumed.result();
+
+    CHECK(actual.tradeCount() == expected.tradeCount());
+    CHECK(actual.trades.entryIdx == expected.trades.entryIdx);
+    CHECK(actual.trades.exitIdx == expected.trades.exitIdx);
+    CHECK(actual.trades.pnl == expected.trades.pnl);
+    CHECK(actual.realizedPnL == expected.realizedPnL);
+    CHECK(actual.finalEquity == expected.finalEquity);
+    CHECK(actual.metrics.equityCurve() == expected.metrics.equityCurve());
+    CHECK(actual.metrics.summary().sharpe == expected.metrics.summary().sharpe);
+}
+
+int main(){
+    const size_t bars = 400;
+    const size_t timeline = bars * TICKERS.size();
+    const auto path = (std::filesystem::temp_directory_path() / "octurnCheckpointTest.bin").string();
+
+    size_t openAtCheckpoint = 0;
+    size_t atEvents = 0;
+    for (uint32_t run = 0; run < 12; run++){
+        const fixtureRun fixture(run, bars, true);
+
+        std::unordered_map<std::string, AnyValue> variables;
+        config cfg(&variables);
+        cfg.equity = 10000;
+        cfg.riskPerTrade = 0.2;
+        cfg.stopLossBps = 80;
+        cfg.takeProfitBps = 100;
+        cfg.commissionBps = 0.5;
+        cfg.spread = 1;
+        cfg.cashYieldBps = (run % 2) ? 300 : 0;
+        cfg.marginRateBps = (run % 3) ? 500 : 0;
+        cfg.slippage = ExecutionEngine::getSlippageParams(cfg, slippageTable);
+
+        portfolioBacktester uninterrupted(fixture.data, cfg);
+        fixture.setup(uninterrupted, TICKERS.size());
+        uninterrupted.execute();
+        const auto expected = uninterrupted.result();
+        CHECK(expected.tradeCount() > 0);
+
+        // ==== A single snapshot at `at`, anywhere in the second half of the run ==== //
+        const size_t at = timeline / 2 + run * (timeline / 2) / 12 + 1;
+        checkResume(fixture, cfg, expected, at, path);
+
+        const auto& trades = expected.trades;
+        for (size_t t = 0; t < trades.size(); t++){
+            const size_t k = trades.tickerId[t];
+            openAtCheckpoint += (3 * trades.entryIdx[t] + k < at && at <= 3 * trades.exitIdx[t] + k);
+        }
+
+        // ==== Exactly at an event: resume on an entry's step, on an exit's step, or right after the exit ==== //
+        for (size_t t = 0; t < trades.size(); t++){
+            const size_t k = trades.tickerId[t];
+            const size_t step = (run % 3 == 0) ? 3 * trades.entryIdx[t] + k : 3 * trades.exitIdx[t] + k + (run % 3 == 2);
+            // ==== Second half only: the next multiple of `step` is past the end, this snapshot is the last one ==== //
+            if (step > timeline / 2 && step < timeline){
+                checkResume(fixture, cfg, expected, step, path);
+                atEvents++;
+                break;
+            }
+        }
+
+        // ==== A snapshot only resumes the portfolio it was taken on ==== //
+        portfolioBacktester other(fixture.data, cfg);
+        fixture.setup(other, TICKERS.size() - 1);
+        bool refused = false;
+        try {
+            other.resume(path);
+        } catch (const std::runtime_error&){
+            refused = true;
+        }
+        CHECK(refused);
+    }
+
+    // ==== Positions were open across the snapshot, not only a flat book ==== //
+    CHECK(openAtCheckpoint > 0);
+    CHECK(atEvents >= 10);
+
+    bookOrdersAcrossSnapshot(path);
+
+    std::filesystem::remove(path);
+    return testResult("checkpointTest");
+}
@@ -0,0 +1,84 @@
+#include "tests/testSupport.hpp"
+
+#include <cmath>
+#include <limits>
+
+#include "ta/crosses.hpp"
+
+// ====================================================== //
+//                   Crossing kernels
+// - Scalar and AVX2 masks against the definition in
+//   crosses.hpp, bar by bar
+// - Values come from a few levels so ties (weak vs strict
+//   compare) are common, NaN gaps mark warm-up bars
+// - Lengths straddle the 4-lane and 64-bar block edges
+// ====================================================== //
+
+static std::vector<double> levels(fixtureRng& rng, size_t n){
+    std::vector<double> values(n);
+    for (auto& value : values){
+        value = rng.oneIn(11) ? std::numeric_limits<double>::quiet_NaN() : std::floor(rng.uniform() * 4.0);
+    }
+    return values;
+}
+
+static bool reference(double previousLeft, double previousRight, double left, double right, crossDirection direction){
+    if (direction == crossDirection::Above) return previousLeft <= previousRight && left > right;
+    return previousLeft >= previousRight && left < right;
+}
+
+static std::vector<uint64_t> masks(const std::vector<double>& left, const std::vector<double>* right, double threshold,
+                                   crossDirection direction, crossKernel kernel){
+    std::vector<uint64_t> words(signal_words(left.size()));
+    if (right) cross_mask(left.data(), right->data(), left.size(), direction, words.data(), kernel);
+    else cross_mask(left.data(), threshold, left.size(), direction, words.data(), kernel);
+    return words;
+}
+
+static void checkKernels(const std::vector<double>& left, const std::vector<double>* right, double threshold, crossDirection direction,
+                         bool avx2){
+    const auto scalar = masks(left, right, threshold, direction, crossKernel::Scalar);
+
+    bool matches = true;
+    for (size_t i = 0; i < left.size(); i++){
+        const bool expected = i > 0 && reference(left[i - 1], right ? (*right)[i - 1] : threshold,
+                                                  left[i], right ? (*right)[i] : threshold, direction);
+        matches &= ((scalar[i / 64] >> (i % 64)) & 1u) == expected;
+    }
+    CHECK(matches);
+
+    CHECK(masks(left, right, threshold, direction, crossKernel::Auto) == scalar);
+    if (avx2) CHECK(masks(left, right, threshold, direction, crossKernel::AVX2) == scalar);
+}
+
+int main(){
+    const bool avx2 = cross_kernel_available(crossKernel::AVX2);
+    if (!avx2) std::printf("crossesTest: no AVX2 on this CPU, scalar kernel only\n");
+
+    fixtureRng rng(FIXTURE_SEED);
+    for (size_t n : {0, 1, 3, 4, 5, 63, 64, 65, 127, 128, 130, 257, 1000}){
+        const auto left = levels(rng, n);
+        const auto right = levels(rng, n);
+        for (auto direction : {crossDirection::Above, crossDirection::Below}){
+            checkKernels(left, &right, 0.0, direction, avx2);
+            checkKernels(left, nullptr, 2.0, direction, avx2);
+        }
+    }
+
+    // ==== Lagged views start the kernel mid-array, on an unaligned pointer: bars before the lag read as NaN ==== //
+    const auto left = levels(rng, 300);
+    const auto right = levels(rng, 300);
+    for (size_t lag : {1, 3, 5, 70}){
+        const Octurn::seriesView lagged{left.data(), left.size(), lag};
+        const Octurn::seriesView view{right.data(), right.size(), 2};
+        const auto signals = cross_signals(lagged, view, crossDirection::Below);
+
+        bool matches = signals.size() == left.size();
+        for (size_t i = 1; matches && i < left.size(); i++){
+            matches = signals[i] == reference(lagged[i - 1], view[i - 1], lagged[i], view[i], crossDirection::Below);
+        }
+        CHECK(matches && !signals[0]);
+    }
+
+    return testResult("crossesTest");
+}
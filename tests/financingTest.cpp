@@ -0,0 +1,123 @@
+#include "tests/testSupport.hpp"
+
+#include <cmath>
+
+#include "backtester/portfolioBacktester.hpp"
+#include "config/configRules.hpp"
+#include "config/slippageTable.hpp"
+#include "execution/executionEngine.hpp"
+#include "utils/timeIndex.hpp"
+
+// ====================================================== //
+//                  Financing accruals
+// - Flat daily bars, one long held from bar 1 to bar 201
+// - A leveraged long (longInitMargin < 1) borrows cash:
+//   margin interest must match simple interest on the
+//   negative cash balance, settled at the exit only
+// - A fully funded long borrows nothing, idle cash earns
+//   the cash yield
+// ====================================================== //
+
+static const size_t BARS = 250;
+static const size_t ENTRY_SIGNAL = 0;
+static const size_t EXIT_SIGNAL = 200;
+
+static std::unordered_map<std::string, AnyValue> flatBars(){
+    Octurn::timeSeries stamps;
+    for (size_t i = 0; i < BARS; i++) stamps.push_back(static_cast<int64_t>(i) * NS_PER_DAY);
+
+    return {
+        {"X_open", std::vector<double>(BARS, 100.0)},
+        {"X_high", std::vector<double>(BARS, 101.0)},
+        {"X_low", std::vector<double>(BARS, 99.5)},
+        {"X_close", std::vector<double>(BARS, 100.0)},
+        {"X_volume", std::vector<double>(BARS, 1e9)},
+        {"X_timestamp", stamps}
+    };
+}
+
+static backtestResult runLong(const std::unordered_map<std::string, AnyValue>& data, double longInitMargin, double riskPerTrade,
+                              double marginRateBps, double cashYieldBps){
+    std::unordered_map<std::string, AnyValue> variables;
+    config cfg(&variables);
+    cfg.equity = 10000;
+    cfg.riskPerTrade = riskPerTrade;
+    cfg.stopLossBps = 80;
+    cfg.longInitMargin = longInitMargin;
+    cfg.marginRateBps = marginRateBps;
+    cfg.cashYieldBps = cashYieldBps;
+    cfg.slippage = ExecutionEngine::getSlippageParams(cfg, slippageTable);
+
+    std::vector<bool> entries(BARS), exits(BARS);
+    entries[ENTRY_SIGNAL] = true;
+    exits[EXIT_SIGNAL] = true;
+
+    portfolioBacktester backtester(data, cfg);
+    backtester.addTicker("X", entries, exits);
+    backtester.execute();
+    return backtester.result();
+}
+
+static double notionalOf(const backtestResult& result){
+    return result.trades.qty[0] * result.trades.entryPrice[0];
+}
+
+int main(){
+    const auto data = flatBars();
+
+    // ==== Held over timeline steps [ENTRY_SIGNAL + 1, EXIT_SIGNAL + 1), settled every step while open ==== //
+    const double held = static_cast<double>(EXIT_SIGNAL - ENTRY_SIGNAL);
+    const double afterExit = static_cast<double>(BARS - 1 - (EXIT_SIGNAL + 1));
+
+    // ==== Leveraged long: 1.2% risk over an 80 bps stop buys ~1.5x equity, the cash balance goes negative ==== //
+    const auto unfinanced = runLong(data, 0.5, 1.2, 0, 0);
+    const auto financed = runLong(data, 0.5, 1.2, 500, 0);
+    CHECK(unfinanced.tradeCount() == 1 && financed.tradeCount() == 1);
+
+    if (unfinanced.tradeCount() == 1 && financed.tradeCount() == 1){
+        const double borrowed = notionalOf(unfinanced) - 10000.0;
+        CHECK(borrowed > 4000.0);
+
+        const double daily = 0.05 / 365.0;
+        const double expected = borrowed * daily * held;
+        const double charged = unfinanced.finalEquity - financed.finalEquity;
+        CHECK(charged > 0.0);
+        CHECK(std::abs(charged - expected) < 1e-6 * expected);
+
+        // ==== Interest is an account charge, the trade itself is unchanged ==== //
+        CHECK(financed.trades.pnl == unfinanced.trades.pnl);
+    }
+
+    // ==== Fully funded long: a margin rate costs nothing, idle cash earns the yield ==== //
+    const auto funded = runLong(data, 1.0, 0.6, 0, 0);
+    const auto fundedRated = runLong(data, 1.0, 0.6, 500, 0);
+    const auto fundedYield = runLong(data, 1.0, 0.6, 500, 300);
+    CHECK(funded.tradeCount() == 1 && fundedYield.tradeCount() == 1);
+    CHECK(fundedRated.finalEquity == funded.finalEquity);
+
+    if (funded.tradeCount() == 1 && fundedYield.tradeCount() == 1){
+        CHECK(notionalOf(funded) < 10000.0);
+
+        // ==== Settled at the entry, the exit and the last bar; yield credited at the entry also grows the position sized from free cash ==== //
+        const double daily = 0.03 / 365.0;
+        const double pnl = fundedYield.trades.pnl[0];
+        const double beforeEntry = 10000.0 * daily;
+        const double whileHeld = (10000.0 + beforeEntry - notionalOf(fundedYield)) * daily * held;
+        const double afterClose = (10000.0 + beforeEntry + whileHeld + pnl) * daily * afterExit;
+        const double expected = beforeEntry + whileHeld + afterClose;
+        const double earned = fundedYield.finalEquity - (10000.0 + pnl);
+        CHECK(std::abs(earned - expected) < 1e-6 * expected);
+    }
+
+    // ==== Rates are validated like the other config rules ==== //
+    std::unordered_map<std::string, AnyValue> variables;
+    config cfg(&variables);
+    for (const char* rate : {"borrowRateBps", "marginRateBps", "cashYieldBps"}){
+        std::string err;
+        CHECK(!cfgRules.at(rate).validate(AnyValue{-1.0}, cfg, err) && !err.empty());
+        CHECK(cfgRules.at(rate).validate(AnyValue{250.0}, cfg, err));
+    }
+    CHECK(cfg.cashYieldBps == 250.0);
+
+    return testResult("financingTest");
+}
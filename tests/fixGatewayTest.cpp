@@ -0,0 +1,94 @@
+#include "tests/testSupport.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "account/account.hpp"
+#include "gateway/fixAcceptorSim.hpp"
+#include "gateway/fixGateway.hpp"
+
+// ====================================================== //
+//              FIX gateway <-> acceptor simulator
+// - Round trip over a loopback session on FIX 4.2 and 4.4
+// - Fill path: entry / exit decisions reach the ledger
+//   and the account at the simulator's prices
+// - Reject path: an unpriced symbol is rejected, nothing
+//   is booked and a later exit has nothing to flatten
+// ====================================================== //
+
+// ==== Polls until `expected` more reports were applied, false on timeout ==== //
+static bool awaitReports(fixGateway& gateway, size_t expected){
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    size_t applied = 0;
+    while (applied < expected && std::chrono::steady_clock::now() < deadline){
+        applied += gateway.poll();
+        if (applied < expected) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return applied == expected;
+}
+
+static void roundTrip(fixVersion version){
+    std::unordered_map<std::string, AnyValue> variables;
+    config cfg(&variables);
+    cfg.commissionBps = 1;
+    account paperAccount(100000.0);
+
+    fixAcceptorSim simulator(version);
+    simulator.start();
+    simulator.setPrice("AAA", 100.0);
+
+    fixSessionSettings settings;
+    settings.port = simulator.port();
+    settings.version = version;
+
+    fixGateway gateway(paperAccount, cfg, settings);
+    gateway.start();
+    CHECK(gateway.loggedOn());
+    const uint32_t priced = gateway.addTicker("AAA");
+    const uint32_t unpriced = gateway.addTicker("BBB");
+
+    // ==== Fill path: buy 10 at 100, sell them at 110 ==== //
+    CHECK(gateway.onDecision(priced, action::Entry, 10.0) != FIX_NO_ORDER);
+    CHECK(awaitReports(gateway, 1));
+    CHECK(gateway.ledger().position(priced).netQty == 10.0);
+    CHECK(gateway.ledger().position(priced).avgCost == 100.0);
+    CHECK(std::abs(paperAccount.availableFreeCash() - (100000.0 - 1000.0 - 0.1)) < 1e-9);
+
+    simulator.setPrice("AAA", 110.0);
+    CHECK(gateway.onDecision(priced, action::Exit, 0.0) != FIX_NO_ORDER);
+    CHECK(awaitReports(gateway, 1));
+    CHECK(gateway.ledger().position(priced).netQty == 0.0);
+    CHECK(gateway.onDecision(priced, action::Exit, 0.0) == FIX_NO_ORDER);
+
+    const double roundTripPnL = 100.0 - 0.1 - 0.11;
+    CHECK(std::abs(gateway.ledger().realizedPnL() - roundTripPnL) < 1e-9);
+    CHECK(std::abs(paperAccount.availableFreeCash() - (100000.0 + roundTripPnL)) < 1e-9);
+
+    // ==== Reject path: no price for BBB, the entry is rejected and its exit sends nothing ==== //
+    CHECK(gateway.onDecision(unpriced, action::Entry, 5.0) != FIX_NO_ORDER);
+    CHECK(awaitReports(gateway, 1));
+    CHECK(gateway.ordersRejected() == 1);
+    CHECK(simulator.ordersRejected() == 1);
+    CHECK(gateway.ledger().position(unpriced).netQty == 0.0);
+    CHECK(gateway.onDecision(unpriced, action::Exit, 0.0) == FIX_NO_ORDER);
+    CHECK(std::abs(paperAccount.availableFreeCash() - (100000.0 + roundTripPnL)) < 1e-9);
+
+    // ==== A limit order needs no reference price, it fills at its limit ==== //
+    gateway.submit(unpriced, ordertype::Buy, 5.0, 50.0);
+    CHECK(awaitReports(gateway, 1));
+    CHECK(gateway.ledger().position(unpriced).netQty == 5.0);
+    CHECK(gateway.ledger().position(unpriced).avgCost == 50.0);
+
+    gateway.stop();
+    CHECK(gateway.ordersSent() == 4);
+    CHECK(simulator.ordersFilled() == 3);
+    CHECK(gateway.latency().count == gateway.ordersSent());
+    simulator.stop();
+}
+
+int main(){
+    roundTrip(fixVersion::FIX42);
+    roundTrip(fixVersion::FIX44);
+    return testResult("fixGatewayTest");
+}
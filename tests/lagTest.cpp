@@ -0,0 +1,113 @@
+#include "tests/testSupport.hpp"
+
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include "interpreter/Interpreter.hpp"
+#include "lexer/Lexer.hpp"
+#include "marketDataView/DataLayer.hpp"
+#include "parser/Parser.hpp"
+
+// ====================================================== //
+//              Lags and views vs shifted copies
+// - A[k] (a view over the stored series), (A > B)[k] (an
+//   evaluated signal shifted in place), MA(x[k], n) (the
+//   call's own lag) and crosses over a lagged side, against
+//   copies shifted by hand, NaN / false before bar k
+// - k is a parameter swept past the series length, up to a
+//   value no size_t can hold: clamped, nothing valid left
+// ====================================================== //
+
+static const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+static const char* SCRIPTS[] = {
+    "data [ { ticker: X timespan: day multiplier: 1 from: 2025-01-01 to: 2025-12-31 } ] "
+    "strategy Views { parameters { k: 1 } "
+    "indicators { A = MA(X_close, 3) B = MA(X_close, 12) M = MA(X_close, 5) P = MA(X_close[2], 5) } "
+    "entry { when A[k] > B } exit { when (A > B)[k] } }",
+
+    "data [ { ticker: X timespan: day multiplier: 1 from: 2025-01-01 to: 2025-12-31 } ] "
+    "strategy Crosses { parameters { k: 1 } "
+    "indicators { A = MA(X_close, 3) B = MA(X_close, 12) } "
+    "entry { when A crosses_above B[k] } exit { when A[k] crosses_below B } }",
+};
+
+static std::vector<double> shifted(const std::vector<double>& values, double bars){
+    std::vector<double> out(values.size(), NaN);
+    for (size_t i = 0; i < values.size(); i++){
+        if (static_cast<double>(i) >= bars) out[i] = values[i - static_cast<size_t>(bars)];
+    }
+    return out;
+}
+
+static std::vector<bool> shifted(const std::vector<bool>& values, double bars){
+    std::vector<bool> out(values.size(), false);
+    for (size_t i = 0; i < values.size(); i++){
+        if (static_cast<double>(i) >= bars) out[i] = values[i - static_cast<size_t>(bars)];
+    }
+    return out;
+}
+
+static std::vector<bool> crosses(const std::vector<double>& left, const std::vector<double>& right, bool above){
+    std::vector<bool> out(left.size(), false);
+    for (size_t i = 1; i < left.size(); i++){
+        out[i] = above ? (left[i - 1] <= right[i - 1] && left[i] > right[i]) : (left[i - 1] >= right[i - 1] && left[i] < right[i]);
+    }
+    return out;
+}
+
+static bool sameSeries(const std::vector<double>& a, const std::vector<double>& b){
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++){
+        if (!(a[i] == b[i] || (std::isnan(a[i]) && std::isnan(b[i])))) return false;
+    }
+    return true;
+}
+
+static void checkScript(size_t script, const std::shared_ptr<const std::unordered_map<std::string, AnyValue>>& data){
+    Lexer lexer(SCRIPTS[script]);
+    Parser parser(lexer.get_tokens());
+    Interpreter interpreter(parser.parse(), MarketDataView(data));
+    interpreter.run();
+
+    auto& variables = interpreter.get_variables();
+    const auto a = std::get<std::vector<double>>(variables["A"]);
+    const auto b = std::get<std::vector<double>>(variables["B"]);
+    const double n = static_cast<double>(a.size());
+
+    if (script == 0){
+        // ==== The call's lag: MA over the close two bars back ==== //
+        CHECK(sameSeries(std::get<std::vector<double>>(variables["P"]), shifted(std::get<std::vector<double>>(variables["M"]), 2)));
+    }
+
+    for (double k : {0.0, 1.0, 3.0, 64.0, 65.0, n - 1, n, n + 5, 1e300}){
+        const auto [entries, exits] = interpreter.evaluate_signals({{"k", k}});
+
+        std::vector<bool> above(a.size()), expectedEntries, expectedExits;
+        for (size_t i = 0; i < a.size(); i++) above[i] = a[i] > b[i];
+
+        if (script == 0){
+            const auto lagged = shifted(a, k);
+            expectedEntries.resize(a.size());
+            for (size_t i = 0; i < a.size(); i++) expectedEntries[i] = lagged[i] > b[i];
+            expectedExits = shifted(above, k);
+        } else {
+            expectedEntries = crosses(a, shifted(b, k), true);
+            expectedExits = crosses(shifted(a, k), b, false);
+        }
+
+        CHECK(entries == expectedEntries);
+        CHECK(exits == expectedExits);
+    }
+}
+
+int main(){
+    for (uint32_t run = 0; run < 3; run++){
+        const fixtureCase fixture(run, {"X"}, 100 + run * 90);
+        checkScript(0, fixture.data);
+        checkScript(1, fixture.data);
+    }
+
+    return testResult("lagTest");
+}
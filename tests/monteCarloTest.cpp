@@ -0,0 +1,83 @@
+#include "tests/testSupport.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "robustness/monteCarlo.hpp"
+
+// ====================================================== //
+//                Monte Carlo robustness
+// - Same seed on 1 and 8 threads: every path, hence every
+//   percentile, is identical for each resampling method
+// - A sample with a trade larger than the account: paths
+//   stop at ruin (-100%, drawdown 1), never below, no NaN
+// ====================================================== //
+
+static tradeSample fixtureSample(fixtureRng& rng, size_t trades){
+    tradeSample sample;
+    sample.initialEquity = 10000.0;
+    for (size_t k = 0; k < trades; k++){
+        sample.pnl.push_back(400.0 * (rng.uniform() - 0.45));
+        sample.notional.push_back(20000.0 + 10000.0 * rng.uniform());
+    }
+    return sample;
+}
+
+static void threadCounts(const tradeSample& sample){
+    for (auto method : {resampleMethod::Shuffle, resampleMethod::BlockBootstrap, resampleMethod::SlippageShock}){
+        monteCarloOptions options;
+        options.method = method;
+        options.paths = 997;   // not a multiple of either pool's chunk
+        options.seed = FIXTURE_SEED;
+
+        options.threads = 1;
+        const auto single = runMonteCarlo(sample, options);
+        options.threads = 8;
+        const auto pooled = runMonteCarlo(sample, options);
+
+        CHECK(single.finalReturn == pooled.finalReturn);
+        CHECK(single.maxDrawdown == pooled.maxDrawdown);
+        CHECK(monteCarloResult::percentile(single.finalReturn, 0.05) == monteCarloResult::percentile(pooled.finalReturn, 0.05));
+
+        // ==== Other seed, other paths: the comparison above is not between constants (a shuffle keeps the final return) ==== //
+        options.seed = FIXTURE_SEED + 1;
+        CHECK(runMonteCarlo(sample, options).maxDrawdown != pooled.maxDrawdown);
+    }
+}
+
+static void ruin(){
+    tradeSample sample;
+    sample.initialEquity = 1000.0;
+    sample.pnl = {50.0, -2000.0, 300.0, 80.0, -40.0};
+    sample.notional = {5000.0, 5000.0, 5000.0, 5000.0, 5000.0};
+
+    for (auto method : {resampleMethod::Shuffle, resampleMethod::BlockBootstrap, resampleMethod::SlippageShock}){
+        monteCarloOptions options;
+        options.method = method;
+        options.paths = 200;
+        options.blockSize = 2;
+
+        const auto result = runMonteCarlo(sample, options);
+        bool bounded = true;
+        size_t ruined = 0;
+        for (size_t path = 0; path < options.paths; path++){
+            const double finalReturn = result.finalReturn[path];
+            const double drawdown = result.maxDrawdown[path];
+            bounded &= std::isfinite(finalReturn) && finalReturn >= -1.0;
+            bounded &= std::isfinite(drawdown) && drawdown >= 0.0 && drawdown <= 1.0;
+            if (finalReturn == -1.0){
+                ruined++;
+                bounded &= drawdown == 1.0;
+            }
+        }
+        CHECK(bounded);
+        CHECK(ruined > 0);
+    }
+}
+
+int main(){
+    fixtureRng rng(FIXTURE_SEED);
+    threadCounts(fixtureSample(rng, 150));
+    ruin();
+    return testResult("monteCarloTest");
+}
@@ -0,0 +1,249 @@
+#include "tests/testSupport.hpp"
+
+#include <cmath>
+
+#include "account/account.hpp"
+#include "backtester/portfolioBacktester.hpp"
+#include "config/slippageTable.hpp"
+#include "execution/executionEngine.hpp"
+#include "execution/orderBook.hpp"
+
+// ====================================================== //
+//                     Order book
+// - Cancelled orders leave stale entries in the working /
+//   trailing lists, their slot may be reused right away:
+//   the new order must never run under the old entry
+// - Nothing trades before the bar it was submitted for
+// - Fills reach the position ledger through the engine
+// - In a portfolio run book orders are processed on their
+//   ticker's bars and settled on the account
+// ====================================================== //
+
+static void scalePrices(std::unordered_map<std::string, AnyValue>& data, const std::string& ticker, double factor){
+    for (const char* field : {"_open", "_high", "_low", "_close"}){
+        for (auto& price : std::get<std::vector<double>>(data[ticker + field])) price *= factor;
+    }
+}
+
+static double openOf(const std::unordered_map<std::string, AnyValue>& data, const std::string& ticker, size_t bar){
+    return std::get<std::vector<double>>(data.at(ticker + "_open"))[bar];
+}
+
+static double filledQty(const std::vector<orderFill>& fills){
+    double qty = 0.0;
+    for (const auto& fill : fills) qty += fill.qty;
+    return qty;
+}
+
+// ==== Far-away limit: keeps the ticker's book live so processBar() walks its lists ==== //
+static void restingOrder(orderBook& book, uint32_t tickerId){
+    order limit{orderKind::Limit, ordertype::Buy, 1.0};
+    limit.limitPrice = 0.01;
+    book.submit(tickerId, limit, 0);
+}
+
+// ==== Market order cancelled on A, its slot reused on B: A's bar must not fill B at A's open ==== //
+static void cancelThenOtherTicker(const std::unordered_map<std::string, AnyValue>& data, const config& cfg){
+    orderBook book(data, cfg);
+    const uint32_t a = book.addTicker("A");
+    const uint32_t b = book.addTicker("B");
+    restingOrder(book, a);
+
+    const uint64_t cancelled = book.submit(a, {orderKind::Market, ordertype::Buy, 10.0}, 5);
+    CHECK(book.cancel(cancelled));
+    CHECK(!book.cancel(cancelled));
+    const uint64_t live = book.submit(b, {orderKind::Market, ordertype::Buy, 10.0}, 5);
+    CHECK((live & 0xffffffffu) == (cancelled & 0xffffffffu));
+
+    CHECK(book.processBar(a, 5).empty());
+    CHECK(book.pending(b) == 1);
+
+    const auto& fills = book.processBar(b, 5);
+    CHECK(fills.size() == 1);
+    if (fills.size() == 1){
+        CHECK(fills[0].orderId == live);
+        CHECK(fills[0].tickerId == b);
+        CHECK(fills[0].price >= openOf(data, "B", 5) && fills[0].price < openOf(data, "B", 5) * 1.01);
+    }
+    CHECK(book.pending(b) == 0);
+}
+
+// ==== Trailing stop cancelled on A and reused on B: A's bars must not trigger it ==== //
+static void cancelTrailingThenOtherTicker(const std::unordered_map<std::string, AnyValue>& data, const config& cfg){
+    orderBook book(data, cfg);
+    const uint32_t a = book.addTicker("A");
+    const uint32_t b = book.addTicker("B");
+    restingOrder(book, a);
+
+    order trailing{orderKind::TrailingStop, ordertype::Sell, 10.0};
+    trailing.trailBps = 1;
+    CHECK(book.cancel(book.submit(a, trailing, 5)));
+
+    // ==== Peak far above A's prices: on A's bars this would trigger at once ==== //
+    trailing.stopPrice = openOf(data, "B", 5) * 1.5;
+    trailing.trailBps = 5000;
+    book.submit(b, trailing, 5);
+
+    for (size_t bar = 5; bar < 10; bar++) CHECK(book.processBar(a, bar).empty());
+    CHECK(book.pending(b) == 1);
+}
+
+// ==== TWAP cancelled and resubmitted on the same slot: one slice per bar, not two ==== //
+static void cancelResubmitTwap(const std::unordered_map<std::string, AnyValue>& data, const config& cfg){
+    orderBook book(data, cfg);
+    const uint32_t a = book.addTicker("A");
+
+    order twap{orderKind::TWAP, ordertype::Buy, 100.0};
+    twap.slices = 4;
+    CHECK(book.cancel(book.submit(a, twap, 5)));
+    const uint64_t live = book.submit(a, twap, 5);
+
+    for (size_t bar = 5; bar < 9; bar++){
+        const auto& fills = book.processBar(a, bar);
+        CHECK(fills.size() == 1);
+        CHECK(filledQty(fills) == 25.0);
+        CHECK(fills.empty() || fills[0].orderId == live);
+    }
+    CHECK(book.processBar(a, 9).empty());
+    CHECK(book.pending(a) == 0);
+}
+
+// ==== Orders submitted for a later bar: earlier bars must not fill them (no lookahead) ==== //
+static void notBeforeSubmitBar(const std::unordered_map<std::string, AnyValue>& data, const config& cfg){
+    orderBook book(data, cfg);
+    const uint32_t a = book.addTicker("A");
+
+    // ==== Each of these would fill on any bar it is processed at ==== //
+    order limit{orderKind::Limit, ordertype::Buy, 1.0};
+    limit.limitPrice = openOf(data, "A", 0) * 100.0;
+    order stop{orderKind::Stop, ordertype::Sell, 1.0};
+    stop.stopPrice = openOf(data, "A", 0) * 100.0;
+    order trailing{orderKind::TrailingStop, ordertype::Sell, 1.0};
+    trailing.trailBps = 1;
+    trailing.stopPrice = openOf(data, "A", 0) * 100.0;
+
+    for (const order& request : {order{orderKind::Market, ordertype::Buy, 1.0}, limit, stop, trailing}){
+        book.submit(a, request, 10);
+    }
+
+    for (size_t bar = 5; bar < 10; bar++) CHECK(book.processBar(a, bar).empty());
+    CHECK(book.pending(a) == 4);
+
+    const auto& fills = book.processBar(a, 10);
+    CHECK(fills.size() == 4);
+    for (const auto& fill : fills) CHECK(fill.bar == 10);
+    CHECK(book.pending(a) == 0);
+}
+
+// ==== The engine routes book fills into its ledger ==== //
+static void engineLedger(const std::unordered_map<std::string, AnyValue>& data, config cfg){
+    account paperAccount(100000.0);
+    ExecutionEngine engine(data, cfg, paperAccount);
+    engine.addTicker("A");
+    const uint32_t b = engine.addTicker("B");
+
+    engine.orders().submit(b, {orderKind::Market, ordertype::Buy, 10.0}, 3);
+    const auto& fills = engine.processOrders(b, 3);
+    CHECK(fills.size() == 1);
+    CHECK(engine.ledger().position(b).netQty == 10.0);
+    CHECK(fills.empty() || engine.ledger().position(b).avgCost == fills[0].price);
+}
+
+// ==== Flat bars at 100, one bar dipping to `low` and one spiking to `high` ==== //
+static void flatTicker(std::unordered_map<std::string, AnyValue>& data, const std::string& ticker, size_t bars,
+                       size_t dipBar, double low, size_t spikeBar, double high){
+    std::vector<double> lows(bars, 99.5), highs(bars, 100.5);
+    lows[dipBar] = low;
+    highs[spikeBar] = high;
+
+    Octurn::timeSeries stamps;
+    for (size_t i = 0; i < bars; i++) stamps.push_back(static_cast<int64_t>(i) * 1000);
+
+    data[ticker + "_open"] = std::vector<double>(bars, 100.0);
+    data[ticker + "_high"] = highs;
+    data[ticker + "_low"] = lows;
+    data[ticker + "_close"] = std::vector<double>(bars, 100.0);
+    data[ticker + "_volume"] = std::vector<double>(bars, 1e9);
+    data[ticker + "_timestamp"] = stamps;
+}
+
+// ==== Limit in / limit out on P, a stop entry left open on Q: cash, PnL and equity follow the fills ==== //
+static void portfolioOrders(){
+    const size_t bars = 60;
+    std::unordered_map<std::string, AnyValue> data;
+    flatTicker(data, "P", bars, 20, 95.0, 40, 110.0);
+    flatTicker(data, "Q", bars, 10, 99.0, 30, 106.0);
+
+    std::unordered_map<std::string, AnyValue> variables;
+    config cfg(&variables);
+    cfg.equity = 10000;
+    cfg.commissionBps = 1;
+    cfg.spread = 0;
+    cfg.slippage = ExecutionEngine::getSlippageParams(cfg, slippageTable);
+
+    const std::vector<bool> none(bars, false);
+    portfolioBacktester backtester(data, cfg);
+    const uint32_t p = backtester.addTicker("P", none, none);
+    const uint32_t q = backtester.addTicker("Q", none, none);
+
+    order buyLimit{orderKind::Limit, ordertype::Buy, 10.0};
+    buyLimit.limitPrice = 96.0;
+    order sellLimit{orderKind::Limit, ordertype::Sell, 10.0};
+    sellLimit.limitPrice = 108.0;
+    order buyStop{orderKind::Stop, ordertype::Buy, 5.0};
+    buyStop.stopPrice = 105.0;
+
+    backtester.submitOrder(p, buyLimit, 5);
+    backtester.submitOrder(p, sellLimit, 25);
+    backtester.submitOrder(q, buyStop, 5);
+    backtester.execute();
+    const auto result = backtester.result();
+
+    const auto& ledger = backtester.executionLayer_.ledger();
+    CHECK(ledger.position(p).netQty == 0.0);
+    CHECK(ledger.position(q).netQty == 5.0);
+    CHECK(ledger.position(q).avgCost >= 105.0);
+
+    // ==== Resting limits fill at their level, commission on both legs ==== //
+    const double roundTrip = (108.0 - 96.0) * 10.0 - (96.0 + 108.0) * 10.0 * 1e-4;
+    const double stopCommission = ledger.position(q).avgCost * 5.0 * 1e-4;
+    CHECK(std::abs(ledger.position(p).realizedPnL - roundTrip) < 1e-9);
+    CHECK(std::abs(result.realizedPnL - (roundTrip - stopCommission)) < 1e-9);
+    CHECK(result.trades.size() == 0);
+
+    // ==== Q is held at its average cost, marked at the last open ==== //
+    const double openQ = (100.0 - ledger.position(q).avgCost) * 5.0;
+    CHECK(std::abs(result.finalEquity - (10000.0 + roundTrip - stopCommission + openQ)) < 1e-9);
+    CHECK(std::abs(backtester.account_.availableFreeCash() - (10000.0 + roundTrip - stopCommission - ledger.position(q).avgCost * 5.0)) < 1e-9);
+
+    // ==== While P is held (bars 20..39) its unrealized gain is in the equity curve ==== //
+    const auto& curve = result.metrics.equityCurve();
+    CHECK(curve.size() == bars);
+    if (curve.size() == bars){
+        CHECK(curve[15] == 10000.0);
+        CHECK(std::abs(curve[25] - (10000.0 + 4.0 * 10.0 - 96.0 * 10.0 * 1e-4)) < 1e-9);
+    }
+}
+
+int main(){
+    fixtureRng rng(FIXTURE_SEED);
+    std::unordered_map<std::string, AnyValue> data;
+    addFixtureBars(data, "A", 20, rng);
+    addFixtureBars(data, "B", 20, rng);
+    scalePrices(data, "B", 3.0);
+
+    std::unordered_map<std::string, AnyValue> variables;
+    config cfg(&variables);
+    cfg.commissionBps = 0.5;
+    cfg.spread = 1;
+    cfg.slippage = ExecutionEngine::getSlippageParams(cfg, slippageTable);
+
+    cancelThenOtherTicker(data, cfg);
+    cancelTrailingThenOtherTicker(data, cfg);
+    cancelResubmitTwap(data, cfg);
+    notBeforeSubmitBar(data, cfg);
+    engineLedger(data, cfg);
+    portfolioOrders();
+
+    return testResult("orderBookTest");
+}
@@ -0,0 +1,123 @@
+#include "tests/testSupport.hpp"
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+#include "compiler/staticStrategy.hpp"
+#include "interpreter/Interpreter.hpp"
+#include "lexer/Lexer.hpp"
+#include "marketDataView/DataLayer.hpp"
+#include "parser/Parser.hpp"
+
+using namespace Octurn::embed;
+
+// ====================================================== //
+//             Static strategies vs the interpreter
+// - The same strategy written in the DSL and with the
+//   header-only embed API, on the same fixture bars
+// - Entry/Exit must be equal bar for bar, indicator values
+//   bit-identical: the header claims to repeat taLib
+// - C++ precedence differs from the DSL's, the static side
+//   is parenthesized to the DSL's grouping
+// - Edges: exactly as many bars as the longest period (one
+//   valid bar), and flat stretches where the averages tie
+//   and RSI has neither gains nor losses
+// ====================================================== //
+
+static const char* SCRIPT =
+    "data [ { ticker: X timespan: day multiplier: 1 from: 2025-01-01 to: 2025-12-31 } ] "
+    "strategy Parity { parameters { fast: 5 } "
+    "indicators { F = MA(X_close, 5) S = MA(X_close, 20) R = RSI(X_close, 14) M = MA(MA(X_close, 3), 7) } "
+    "entry { when F > S and R < 70 or (F + 1) * 2 > S * 2 } "
+    "exit { when F < S or M > F and R > 30 } }";
+
+static const char* CROSS_SCRIPT =
+    "data [ { ticker: X timespan: day multiplier: 1 from: 2025-01-01 to: 2025-12-31 } ] "
+    "strategy Crosses { parameters { fast: 5 } "
+    "indicators { F = MA(X_close, 5) S = MA(X_close, 20) R = RSI(X_close, 14) } "
+    "entry { when F crosses_above S } "
+    "exit { when F crosses_below S or R crosses_below 30 } }";
+
+static Interpreter interpret(const char* source, const std::shared_ptr<const std::unordered_map<std::string, AnyValue>>& data){
+    Lexer lexer(source);
+    Parser parser(lexer.get_tokens());
+    Interpreter interpreter(parser.parse(), MarketDataView(data));
+    interpreter.run();
+    return interpreter;
+}
+
+static bool sameBits(const std::vector<double>& a, const std::vector<double>& b){
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+static size_t checkParity(const std::shared_ptr<const std::unordered_map<std::string, AnyValue>>& data){
+    const auto close = column(*data, "X_close");
+
+    auto interpreter = interpret(SCRIPT, data);
+    const auto [entries, exits] = interpreter.evaluate_signals({});
+    const auto [staticEntries, staticExits] = signals(
+        (MA<5>(close) > MA<20>(close) && RSI<14>(close) < 70) || (MA<5>(close) + 1) * 2 > MA<20>(close) * 2,
+        MA<5>(close) < MA<20>(close) || (MA<7>(MA<3>(close)) > MA<5>(close) && RSI<14>(close) > 30));
+    CHECK(staticEntries == entries);
+    CHECK(staticExits == exits);
+
+    auto& variables = interpreter.get_variables();
+    std::vector<double> nested(close.size()), rsi(close.size());
+    values(MA<7>(MA<3>(close)), nested);
+    values(RSI<14>(close), rsi);
+    CHECK(sameBits(nested, std::get<std::vector<double>>(variables["M"])));
+    CHECK(sameBits(rsi, std::get<std::vector<double>>(variables["R"])));
+
+    auto crossInterpreter = interpret(CROSS_SCRIPT, data);
+    const auto [crossEntries, crossExits] = crossInterpreter.evaluate_signals({});
+    const auto [staticCrossEntries, staticCrossExits] = signals(
+        crossesAbove(MA<5>(close), MA<20>(close)),
+        crossesBelow(MA<5>(close), MA<20>(close)) || crossesBelow(RSI<14>(close), 30));
+    CHECK(staticCrossEntries == crossEntries);
+    CHECK(staticCrossExits == crossExits);
+
+    size_t crossings = 0;
+    for (bool entry : staticCrossEntries) crossings += entry;
+    return crossings;
+}
+
+// ==== Closes held flat over [from, to): MAs converge and tie, RSI sees no move ==== //
+static void flatten(std::unordered_map<std::string, AnyValue>& data, size_t from, size_t to){
+    auto& close = std::get<std::vector<double>>(data["X_close"]);
+    for (size_t i = from; i < to && i < close.size(); i++) close[i] = close[from];
+}
+
+int main(){
+    size_t crossings = 0;
+    for (uint32_t run = 0; run < 8; run++){
+        const fixtureCase fixture(run, {"X"}, 300 + run * 50);
+        crossings += checkParity(fixture.data);
+    }
+
+    // ==== The fixtures must actually cross, or the crossing parity is vacuous ==== //
+    CHECK(crossings > 0);
+
+    for (size_t bars : {20, 21, 64}){
+        const fixtureCase fixture(8, {"X"}, bars);
+        checkParity(fixture.data);
+    }
+
+    const fixtureCase flat(9, {"X"}, 200);
+    flatten(*flat.data, 40, 90);
+    flatten(*flat.data, 150, 200);
+    checkParity(flat.data);
+
+    // ==== Fewer bars than a period: refused like taLib, not read out of bounds ==== //
+    std::vector<double> tooShort(3, 1.0);
+    std::vector<uint8_t> out(tooShort.size());
+    bool refused = false;
+    try {
+        evaluate(MA<5>(series(tooShort)) > 1, out);
+    } catch (const std::runtime_error&){
+        refused = true;
+    }
+    CHECK(refused);
+
+    return testResult("staticStrategyTest");
+}
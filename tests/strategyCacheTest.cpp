@@ -0,0 +1,121 @@
+#include "tests/testSupport.hpp"
+
+#include <atomic>
+#include <format>
+#include <stdexcept>
+#include <thread>
+
+#include "engine/strategyCache.hpp"
+
+// ====================================================== //
+//                    Strategy cache
+// - Whitespace-insensitive keys: a reformatted script hits
+// - Concurrent misses on one script compile it once, every
+//   caller gets the same compiled strategy
+// - LRU within a shard: the least recently used entry goes
+// - A failed compilation leaves nothing behind
+// ====================================================== //
+
+#define THREADS 8
+
+static std::string script(size_t id){
+    return std::format(
+        "data [ {{ ticker: X timespan: day multiplier: 1 from: 2025-01-01 to: 2025-12-31 }} ] "
+        "strategy S{} {{ parameters {{ fast: 5 }} "
+        "indicators {{ F = MA(X_close, fast) S = MA(X_close, 20) }} "
+        "entry {{ when F > S }} exit {{ when F < S }} }}", id);
+}
+
+// ==== Same shard as strategyCache::shardOf ==== //
+static size_t shardOf(const std::string& source){
+    return (strategyCache::hashOf(strategyCache::normalize(source)) >> 32) % 16;
+}
+
+static void whitespace(){
+    strategyCache cache;
+    bool hit = true;
+    const auto compiled = cache.get(script(1), &hit);
+    CHECK(!hit && compiled->name == "S1" && compiled->parameters.at("fast") == 5.0);
+
+    std::string spaced;
+    for (const char c : script(1)) spaced += (c == ' ') ? std::string("\n\t  ") : std::string(1, c);
+    CHECK(cache.get("  " + spaced + "\r\n", &hit) == compiled);
+    CHECK(hit);
+    CHECK(cache.size() == 1 && cache.hits() == 1 && cache.misses() == 1);
+}
+
+static void concurrentMisses(){
+    strategyCache cache;
+    std::atomic<size_t> ready{0};
+    std::atomic<size_t> compilations{0};
+    strategyCache::compiledPtr results[THREADS];
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREADS; t++){
+        threads.emplace_back([&, t](){
+            ready++;
+            while (ready.load() < THREADS) std::this_thread::yield();
+            bool hit = true;
+            results[t] = cache.get(script(2), &hit);
+            if (!hit) compilations++;
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    CHECK(compilations == 1);
+    CHECK(cache.misses() == 1 && cache.hits() == THREADS - 1);
+    for (const auto& result : results) CHECK(result && result == results[0]);
+}
+
+static void leastRecentlyUsed(){
+    // ==== 32 entries over 16 shards: two per shard ==== //
+    strategyCache cache(32);
+
+    std::vector<std::string> sameShard;
+    for (size_t id = 100; sameShard.size() < 3; id++){
+        if (sameShard.empty() || shardOf(script(id)) == shardOf(sameShard.front())) sameShard.push_back(script(id));
+    }
+
+    bool hit = false;
+    cache.get(sameShard[0]);
+    cache.get(sameShard[1]);
+    cache.get(sameShard[0], &hit);   // touched: [1] is now the oldest
+    CHECK(hit);
+    cache.get(sameShard[2]);
+
+    CHECK(cache.size() == 2);
+    cache.get(sameShard[0], &hit);
+    CHECK(hit);
+    cache.get(sameShard[1], &hit);
+    CHECK(!hit);
+}
+
+static void failedCompile(){
+    strategyCache cache;
+    const std::string broken = "strategy Broken { entry { when } }";
+
+    for (int attempt = 0; attempt < 2; attempt++){
+        bool threw = false;
+        try {
+            cache.get(broken);
+        } catch (const std::exception&){
+            threw = true;
+        }
+        CHECK(threw);
+        CHECK(cache.size() == 0);
+    }
+    // ==== Both attempts compiled: the failure was not served from the cache ==== //
+    CHECK(cache.misses() == 2 && cache.hits() == 0);
+
+    bool hit = true;
+    cache.get(script(3), &hit);
+    CHECK(!hit && cache.size() == 1);
+}
+
+int main(){
+    whitespace();
+    concurrentMisses();
+    leastRecentlyUsed();
+    failedCompile();
+    return testResult("strategyCacheTest");
+}
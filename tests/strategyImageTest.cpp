@@ -0,0 +1,95 @@
+#include "tests/testSupport.hpp"
+
+#include <memory>
+#include <stdexcept>
+
+#include "compiler/strategyImage.hpp"
+#include "interpreter/Interpreter.hpp"
+#include "lexer/Lexer.hpp"
+#include "marketDataView/DataLayer.hpp"
+#include "parser/Parser.hpp"
+
+// ====================================================== //
+//            Strategy image vs the tree interpreter
+// - The image the API publishes is run by the worker with
+//   Interpreter(image, ...): Entry/Exit must match the tree
+//   bar for bar, with and without parameter overrides
+// - Scripts cover arithmetic, nested calls, crosses, lags
+//   (constant and parameter) and temporal conditions
+// - A flipped byte is refused by the checksum
+// ====================================================== //
+
+static const char* SCRIPTS[] = {
+    "config { equity: 10000 riskPerTrade: 1 } "
+    "data [ { ticker: X timespan: day multiplier: 1 from: 2025-01-01 to: 2025-12-31 } ] "
+    "strategy Mixed { parameters { fast: 5 slow: 20 } "
+    "indicators { F = MA(X_close, fast) S = MA(X_close, slow) R = RSI(X_close, 14) M = MA(MA(X_close, 3), 7) } "
+    "entry { when F > S and R < 70 or (F + 1) * 2 > S * 2 } "
+    "exit { when F < S or M > F and R > 30 } }",
+
+    "data [ { ticker: X timespan: day multiplier: 1 from: 2025-01-01 to: 2025-12-31 } ] "
+    "strategy Crosses { parameters { fast: 5 back: 2 } "
+    "indicators { F = MA(X_close, fast) S = MA(X_close, 20) P = MA(X_close[1], 3) } "
+    "entry { when F crosses_above S or F[1] crosses_above S[back] } "
+    "exit { when F crosses_below S[2] or P[1] > F } }",
+
+    "data [ { ticker: X timespan: day multiplier: 1 from: 2025-01-01 to: 2025-12-31 } ] "
+    "strategy Temporal { parameters { fast: 5 } "
+    "indicators { F = MA(X_close, fast) S = MA(X_close, 20) } "
+    "entry { when F > S for 3 bars } "
+    "exit { when F < S within 2 bars } }",
+};
+
+using sharedData = std::shared_ptr<const std::unordered_map<std::string, AnyValue>>;
+
+static std::shared_ptr<const syntaxTree> parse(const char* source){
+    Lexer lexer(source);
+    Parser parser(lexer.get_tokens());
+    return parser.parse();
+}
+
+static void checkScript(const char* source, const sharedData& data, const std::unordered_map<std::string, double>& overrides){
+    const auto tree = parse(source);
+    Interpreter reference(tree, MarketDataView(data));
+    reference.run();
+    const auto expected = reference.evaluate_signals(overrides);
+
+    const auto bytes = strategyImage::build(*tree);
+    const strategyImage image(bytes.data(), bytes.size());
+    Interpreter worker(image, MarketDataView(data));
+    worker.run();
+    const auto signals = worker.evaluate_signals(overrides);
+
+    CHECK(signals.first == expected.first);
+    CHECK(signals.second == expected.second);
+
+    // ==== Vacuous if neither side ever fires ==== //
+    bool fired = false;
+    for (bool entry : expected.first) fired |= entry;
+    CHECK(fired);
+}
+
+int main(){
+    for (uint32_t run = 0; run < 3; run++){
+        const fixtureCase fixture(run, {"X"}, 150 + run * 120);
+        const sharedData data = fixture.data;
+
+        for (const char* script : SCRIPTS){
+            checkScript(script, data, {});
+        }
+        checkScript(SCRIPTS[0], data, {{"fast", 3}, {"slow", 30}});
+        checkScript(SCRIPTS[1], data, {{"back", 4}});
+    }
+
+    auto bytes = strategyImage::build(*parse(SCRIPTS[0]));
+    bytes[bytes.size() / 2] ^= 0x5a;
+    bool refused = false;
+    try {
+        strategyImage corrupted(bytes.data(), bytes.size());
+    } catch (const std::runtime_error&){
+        refused = true;
+    }
+    CHECK(refused);
+
+    return testResult("strategyImageTest");
+}
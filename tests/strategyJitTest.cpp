@@ -0,0 +1,152 @@
+#include "tests/testSupport.hpp"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <memory>
+
+#include "backtester/walkForward.hpp"
+#include "compiler/strategyJit.hpp"
+#include "interpreter/Interpreter.hpp"
+#include "lexer/Lexer.hpp"
+#include "marketDataView/DataLayer.hpp"
+#include "parser/Parser.hpp"
+
+// ====================================================== //
+//                Strategy JIT vs the Visitor
+// - verify = true: every kernel the JIT takes is also run
+//   through the Visitor, any difference throws
+// - Arithmetic, crosses (one bar back), constant lags and
+//   parameters passed as scalars across a sweep
+// - A second JIT on the same cache loads, a cache or object
+//   writable by others is refused and runs interpreted
+// - Skipped when no C++ compiler is found
+// ====================================================== //
+
+static const char* SCRIPTS[] = {
+    "data [ { ticker: X timespan: day multiplier: 1 from: 2025-01-01 to: 2025-12-31 } ] "
+    "strategy Mixed { parameters { fast: 5 } "
+    "indicators { F = MA(X_close, 5) S = MA(X_close, 20) R = RSI(X_close, 14) P = MA(X_close[1], 3) } "
+    "entry { when F > S and R < 70 or (F + 1) * 2 > S * 2 } "
+    "exit { when F < S or F[2] > S[1] and P[1] > F } }",
+
+    "data [ { ticker: X timespan: day multiplier: 1 from: 2025-01-01 to: 2025-12-31 } ] "
+    "strategy Crosses { parameters { fast: 5 } "
+    "indicators { F = MA(X_close, 5) S = MA(X_close, 20) R = RSI(X_close, 14) } "
+    "entry { when F crosses_above S or F[1] crosses_above S[3] } "
+    "exit { when F crosses_below S[2] or R crosses_below 30 } }",
+};
+
+static const char* SWEEP_SCRIPT =
+    "config { equity: 10000 riskPerTrade: 1 stopLossBps: 80 } "
+    "data [ { ticker: X timespan: day multiplier: 1 from: 2025-01-01 to: 2025-12-31 } ] "
+    "strategy Sweep { parameters { gap: 1 } "
+    "indicators { F = MA(X_close, 5) S = MA(X_close, 20) } "
+    "entry { when F - S > gap } exit { when F + gap < S } }";
+
+using sharedData = std::shared_ptr<const std::unordered_map<std::string, AnyValue>>;
+
+static std::shared_ptr<const syntaxTree> parse(const char* source){
+    Lexer lexer(source);
+    Parser parser(lexer.get_tokens());
+    return parser.parse();
+}
+
+static std::pair<std::vector<bool>, std::vector<bool>> signalsOf(const char* source, const sharedData& data,
+                                                                  std::shared_ptr<strategyJit> jit,
+                                                                  const std::unordered_map<std::string, double>& overrides = {}){
+    Interpreter interpreter(parse(source), MarketDataView(data));
+    if (jit) interpreter.set_jit(std::move(jit));
+    interpreter.run();
+    return interpreter.evaluate_signals(overrides);
+}
+
+static std::shared_ptr<strategyJit> makeJit(const std::filesystem::path& cache){
+    jitOptions options;
+    options.cacheDir = cache;
+    options.verify = true;
+    return std::make_shared<strategyJit>(options);
+}
+
+// ==== Every script through a fresh JIT, false if verify threw ==== //
+static bool checkScripts(const sharedData& data, const std::shared_ptr<strategyJit>& jit){
+    try {
+        for (const char* script : SCRIPTS){
+            CHECK(signalsOf(script, data, jit) == signalsOf(script, data, nullptr));
+        }
+        for (double gap : {0.0, 0.5, 2.0}){
+            CHECK(signalsOf(SWEEP_SCRIPT, data, jit, {{"gap", gap}}) == signalsOf(SWEEP_SCRIPT, data, nullptr, {{"gap", gap}}));
+        }
+    } catch (const std::exception& e){
+        std::fprintf(stderr, "strategyJitTest: %s\n", e.what());
+        return false;
+    }
+    return true;
+}
+
+static void checkWalkForward(const sharedData& data, const std::filesystem::path& cache){
+    const parameterGrid grid{{"gap", {0.0, 0.5, 1.0}}};
+    walkForwardOptions options{100, 50};
+    const auto interpreted = walkForwardScript(parse(SWEEP_SCRIPT), MarketDataView(data), grid, options);
+
+    options.jit = makeJit(cache);
+    const auto native = walkForwardScript(parse(SWEEP_SCRIPT), MarketDataView(data), grid, options);
+
+    CHECK(native.size() == interpreted.size());
+    for (size_t w = 0; w < native.size() && w < interpreted.size(); w++){
+        CHECK(native[w].bestCandidate == interpreted[w].bestCandidate);
+        CHECK(native[w].outOfSample.realizedPnL == interpreted[w].outOfSample.realizedPnL);
+    }
+    CHECK(options.jit->compiled() + options.jit->loadedFromDisk() > 0);
+}
+
+int main(){
+    const char* compiler = std::getenv("OCTURN_JIT_CXX");
+    const auto probe = std::format("\"{}\" --version > /dev/null 2>&1", (compiler && *compiler) ? compiler : "c++");
+    if (std::system(probe.c_str()) != 0){
+        std::printf("strategyJitTest: no C++ compiler found, skipped\n");
+        return 0;
+    }
+
+    const auto cache = std::filesystem::temp_directory_path() / std::format("octurn-jit-test-{}", ::getpid());
+    std::filesystem::remove_all(cache);
+
+    for (uint32_t run = 0; run < 3; run++){
+        const fixtureCase fixture(run, {"X"}, 200 + run * 150);
+        const sharedData data = fixture.data;
+
+        auto jit = makeJit(cache);
+        CHECK(checkScripts(data, jit));
+        // ==== All six conditions are typed: none may silently fall back ==== //
+        CHECK(jit->compiled() + jit->loadedFromDisk() == 6);
+
+        // ==== Same expressions, new process state: every kernel comes from disk ==== //
+        auto warm = makeJit(cache);
+        CHECK(checkScripts(data, warm));
+        CHECK(warm->compiled() == 0 && warm->loadedFromDisk() == jit->compiled() + jit->loadedFromDisk());
+    }
+
+    const fixtureCase fixture(3, {"X"}, 400);
+    const sharedData data = fixture.data;
+    checkWalkForward(data, cache);
+
+    // ==== Objects writable by others are never loaded: rebuilt (owner-only again) ==== //
+    for (const auto& entry : std::filesystem::directory_iterator(cache)){
+        if (entry.path().extension() == ".so") ::chmod(entry.path().c_str(), 0666);
+    }
+    auto planted = makeJit(cache);
+    CHECK(checkScripts(data, planted));
+    CHECK(planted->loadedFromDisk() == 0 && planted->compiled() > 0);
+
+    // ==== A group/world-writable cache disables the JIT, the Visitor still gives the signals ==== //
+    ::chmod(cache.c_str(), 0777);
+    auto shared = makeJit(cache);
+    CHECK(checkScripts(data, shared));
+    CHECK(shared->compiled() == 0 && shared->loadedFromDisk() == 0);
+
+    std::filesystem::remove_all(cache);
+    return testResult("strategyJitTest");
+}
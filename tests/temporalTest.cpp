@@ -0,0 +1,199 @@
+#include "tests/testSupport.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include "interpreter/Interpreter.hpp"
+#include "lexer/Lexer.hpp"
+#include "marketDataView/DataLayer.hpp"
+#include "parser/Parser.hpp"
+#include "ta/signalMask.hpp"
+#include "ta/temporal.hpp"
+
+// ====================================================== //
+//            Temporal kernels vs a naive rescan
+// - Each kernel against an O(n * N) reference that
+//   rescans the window on every bar
+// - Signals mix random bars with all-ones runs longer than
+//   a word and whole set / empty words: the whole-word fast
+//   paths and the carry across word boundaries
+// - Windows straddle 64, lengths straddle word edges
+// - The DSL forms ('for N bars', 'for K of N bars',
+//   'within N bars', count, bars_since, highest_since)
+//   through the interpreter against the same references
+// ====================================================== //
+
+static const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+static std::vector<bool> signalBars(fixtureRng& rng, size_t n){
+    std::vector<bool> signal(n);
+    for (size_t i = 0; i < n;){
+        if (rng.oneIn(6)){
+            // ==== A run of set bars, often longer than a word ==== //
+            const size_t run = 1 + static_cast<size_t>(rng.uniform() * 160.0);
+            for (size_t j = i; j < std::min(n, i + run); j++) signal[j] = true;
+            i += run;
+        } else if (rng.oneIn(8)){
+            i += 64 + static_cast<size_t>(rng.uniform() * 64.0);   // empty stretch
+        } else {
+            signal[i] = rng.oneIn(3);
+            i++;
+        }
+    }
+    return signal;
+}
+
+// ==== Set bars among i-window+1 .. i, cut at bar 0 ==== //
+static size_t setIn(const std::vector<bool>& signal, size_t i, size_t window){
+    size_t count = 0;
+    for (size_t j = (i + 1 >= window) ? i + 1 - window : 0; j <= i; j++) count += signal[j];
+    return count;
+}
+
+static double barsSinceAt(const std::vector<bool>& signal, size_t i){
+    for (size_t j = i + 1; j-- > 0;){
+        if (signal[j]) return static_cast<double>(i - j);
+    }
+    return NaN;
+}
+
+static double highestSinceAt(const std::vector<bool>& signal, const std::vector<double>& values, size_t i){
+    const double since = barsSinceAt(signal, i);
+    if (std::isnan(since)) return NaN;
+    double highest = NaN;
+    for (size_t j = i - static_cast<size_t>(since); j <= i; j++){
+        if (!std::isnan(values[j]) && (std::isnan(highest) || values[j] > highest)) highest = values[j];
+    }
+    return highest;
+}
+
+static bool sameValue(double a, double b){
+    return (std::isnan(a) && std::isnan(b)) || a == b;
+}
+
+static void checkKernels(const std::vector<bool>& signal, const std::vector<double>& values){
+    const size_t n = signal.size();
+    const auto words = pack_signals(signal);
+    std::vector<uint64_t> out(words.size());
+    std::vector<double> numbers(n);
+
+    for (size_t window : {1, 2, 5, 63, 64, 65, 100, 130, 200}){
+        held_for(words.data(), n, window, out.data());
+        const auto held = unpack_signals(out, n);
+        within_bars(words.data(), n, window, out.data());
+        const auto within = unpack_signals(out, n);
+        count_window(words.data(), n, window, numbers.data());
+
+        bool matches = true;
+        for (size_t i = 0; i < n; i++){
+            const size_t set = setIn(signal, i, window);
+            matches &= held[i] == (i + 1 >= window && set == window);
+            matches &= within[i] == (set > 0);
+            matches &= numbers[i] == static_cast<double>(set);
+        }
+        CHECK(matches);
+
+        for (size_t required : {size_t{1}, window / 2, window - 1}){
+            if (required == 0 || required >= window) continue;
+            held_count(words.data(), n, window, required, out.data());
+            const auto atLeast = unpack_signals(out, n);
+
+            bool countMatches = true;
+            for (size_t i = 0; i < n; i++) countMatches &= atLeast[i] == (setIn(signal, i, window) >= required);
+            CHECK(countMatches);
+        }
+    }
+
+    bars_since(words.data(), n, numbers.data());
+    bool matches = true;
+    for (size_t i = 0; i < n; i++) matches &= sameValue(numbers[i], barsSinceAt(signal, i));
+    CHECK(matches);
+
+    highest_since(words.data(), values.data(), n, numbers.data());
+    matches = true;
+    for (size_t i = 0; i < n; i++) matches &= sameValue(numbers[i], highestSinceAt(signal, values, i));
+    CHECK(matches);
+}
+
+static const char* SCRIPTS[] = {
+    "data [ { ticker: X timespan: day multiplier: 1 from: 2025-01-01 to: 2025-12-31 } ] "
+    "strategy Held { parameters { fast: 5 } "
+    "indicators { F = MA(X_close, 3) S = MA(X_close, 30) } "
+    "entry { when F > S for 3 of 7 bars or F > S for 70 bars } "
+    "exit { when F < S within 80 bars and F < S for 4 bars } }",
+
+    "data [ { ticker: X timespan: day multiplier: 1 from: 2025-01-01 to: 2025-12-31 } ] "
+    "strategy Since { parameters { fast: 5 } "
+    "indicators { F = MA(X_close, 3) S = MA(X_close, 30) C = MA(X_close, 1) } "
+    "entry { when count(F > S, 70) > 20 and bars_since(F crosses_above S) < 10 } "
+    "exit { when highest_since(F crosses_above S, C) * 100 > C * 101 } }",
+};
+
+// ==== Same conditions, rebuilt from the interpreter's F / S / C with the references above ==== //
+static std::pair<std::vector<bool>, std::vector<bool>> expected(size_t script, std::unordered_map<std::string, AnyValue>& variables){
+    const auto& fast = std::get<std::vector<double>>(variables["F"]);
+    const auto& slow = std::get<std::vector<double>>(variables["S"]);
+    const size_t n = fast.size();
+
+    std::vector<bool> above(n), below(n), crossed(n);
+    for (size_t i = 0; i < n; i++){
+        above[i] = fast[i] > slow[i];
+        below[i] = fast[i] < slow[i];
+        crossed[i] = i > 0 && fast[i - 1] <= slow[i - 1] && fast[i] > slow[i];
+    }
+
+    std::vector<bool> entries(n), exits(n);
+    for (size_t i = 0; i < n; i++){
+        if (script == 0){
+            entries[i] = setIn(above, i, 7) >= 3 || (i + 1 >= 70 && setIn(above, i, 70) == 70);
+            exits[i] = setIn(below, i, 80) > 0 && i + 1 >= 4 && setIn(below, i, 4) == 4;
+        } else {
+            const auto& close = std::get<std::vector<double>>(variables["C"]);
+            entries[i] = setIn(above, i, 70) > 20 && barsSinceAt(crossed, i) < 10;
+            exits[i] = highestSinceAt(crossed, close, i) * 100 > close[i] * 101;
+        }
+    }
+    return {entries, exits};
+}
+
+static void checkScripts(const std::shared_ptr<const std::unordered_map<std::string, AnyValue>>& data){
+    for (size_t script = 0; script < std::size(SCRIPTS); script++){
+        Lexer lexer(SCRIPTS[script]);
+        Parser parser(lexer.get_tokens());
+        Interpreter interpreter(parser.parse(), MarketDataView(data));
+        interpreter.run();
+
+        const auto signals = interpreter.evaluate_signals({});
+        const auto reference = expected(script, interpreter.get_variables());
+        CHECK(signals.first == reference.first);
+        CHECK(signals.second == reference.second);
+
+        // ==== Both sides must fire somewhere, or the comparison is vacuous ==== //
+        CHECK(std::find(reference.first.begin(), reference.first.end(), true) != reference.first.end());
+        CHECK(std::find(reference.second.begin(), reference.second.end(), true) != reference.second.end());
+    }
+}
+
+int main(){
+    fixtureRng rng(FIXTURE_SEED);
+    for (size_t n : {1, 63, 64, 65, 127, 128, 129, 300, 1000}){
+        for (int draw = 0; draw < 4; draw++){
+            const auto signal = signalBars(rng, n);
+            std::vector<double> values(n);
+            for (auto& value : values) value = rng.oneIn(9) ? NaN : std::floor(rng.uniform() * 50.0);
+            checkKernels(signal, values);
+        }
+
+        checkKernels(std::vector<bool>(n, true), std::vector<double>(n, 1.0));
+        checkKernels(std::vector<bool>(n, false), std::vector<double>(n, 1.0));
+    }
+
+    for (uint32_t run = 0; run < 2; run++){
+        const fixtureCase fixture(run, {"X"}, 250 + run * 350);
+        checkScripts(fixture.data);
+    }
+
+    return testResult("temporalTest");
+}
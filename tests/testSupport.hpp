@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "types/types.hpp"
+
+using Octurn::AnyValue;
+
+// ====================================================== //
+//                     Test support
+// - CHECK counts failures and keeps going, main() returns
+//   testResult() so ctest sees a non-zero exit code
+// - Fixtures are seeded random walks built from raw
+//   mt19937 draws, the same bars on every standard library
+// ====================================================== //
+
+inline int testFailures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { testFailures++; std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); } \
+} while (0)
+
+inline int testResult(const char* name){
+    if (testFailures) std::fprintf(stderr, "%s: %d check(s) failed\n", name, testFailures);
+    else std::printf("%s: ok\n", name);
+    return testFailures ? 1 : 0;
+}
+
+struct fixtureRng {
+    std::mt19937 engine;
+
+    explicit fixtureRng(uint32_t seed) : engine(seed) {}
+
+    double uniform() { return engine() / 4294967296.0; }     // [0, 1)
+    bool oneIn(uint32_t n) { return engine() % n == 0; }
+};
+
+// ==== <ticker>_open/high/low/close/volume/timestamp, `offsetNs` staggers tickers on the timeline ==== //
+inline void addFixtureBars(std::unordered_map<std::string, AnyValue>& data, const std::string& ticker, size_t bars,
+                           fixtureRng& rng, double volume = 1e7, int64_t offsetNs = 0){
+    std::vector<double> open, high, low, close, vol;
+    Octurn::timeSeries stamps;
+    double price = 100.0;
+
+    for (size_t i = 0; i < bars; i++){
+        price *= 1.0 + 0.02 * (rng.uniform() - 0.5);
+        const double width = 0.004 + 0.01 * rng.uniform();
+        open.push_back(price);
+        high.push_back(price * (1.0 + width));
+        low.push_back(price * (1.0 - width * rng.uniform()));
+        close.push_back(low.back() + (high.back() - low.back()) * rng.uniform());
+        vol.push_back(volume);
+        stamps.push_back(static_cast<int64_t>(i) * 3000 + offsetNs);
+    }
+
+    data[ticker + "_open"] = open;
+    data[ticker + "_high"] = high;
+    data[ticker + "_low"] = low;
+    data[ticker + "_close"] = close;
+    data[ticker + "_volume"] = vol;
+    data[ticker + "_timestamp"] = stamps;
+}
+
+inline std::vector<bool> fixtureSignals(fixtureRng& rng, size_t bars, uint32_t oneIn){
+    std::vector<bool> signal(bars);
+    for (size_t i = 0; i < bars; i++) signal[i] = rng.oneIn(oneIn);
+    return signal;
+}
+
+// ====================================================== //
+//                     Fixture cases
+// - Case i is the same market in every test: one seed
+//   sequence for the suite, tests pick cases, not seeds
+// - Ticker k is staggered by k * staggerNs on the timeline
+// - rng continues past the bars: signals drawn from it
+//   belong to the same case
+// ====================================================== //
+
+#define FIXTURE_SEED 1000u
+
+struct fixtureCase {
+    std::shared_ptr<std::unordered_map<std::string, AnyValue>> data;
+    fixtureRng rng;
+
+    fixtureCase(uint32_t index, const std::vector<std::string>& tickers, size_t bars, int64_t staggerNs = 0)
+        : data(std::make_shared<std::unordered_map<std::string, AnyValue>>()), rng(FIXTURE_SEED + index) {
+        for (size_t k = 0; k < tickers.size(); k++){
+            addFixtureBars(*data, tickers[k], bars, rng, 1e7, static_cast<int64_t>(k) * staggerNs);
+        }
+    }
+};
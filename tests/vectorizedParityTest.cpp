@@ -0,0 +1,134 @@
+#include "tests/testSupport.hpp"
+
+#include <functional>
+
+#include "backtester/portfolioBacktester.hpp"
+#include "backtester/vectorizedBacktester.hpp"
+#include "config/slippageTable.hpp"
+#include "execution/executionEngine.hpp"
+
+// ====================================================== //
+//        Vectorized fast path vs portfolio event loop
+// - Same fixture bars, signals and config through both
+// - Trades, PnL and the equity curve must match exactly,
+//   not within a tolerance: the fast path claims to
+//   replay the event loop, not to approximate it
+// - Random cases, then hand-made bars for the trigger
+//   edges: gaps through the stop or past the target, a
+//   stop on the entry bar or on the signal exit's bar, a
+//   bar touching stop and target
+// ====================================================== //
+
+static bool sameTrades(const tradeLog& a, const tradeLog& b){
+    return a.side == b.side && a.entryIdx == b.entryIdx && a.exitIdx == b.exitIdx && a.qty == b.qty
+        && a.entryPrice == b.entryPrice && a.exitPrice == b.exitPrice && a.pnl == b.pnl;
+}
+
+// ==== Both paths on the same inputs, the fast path's result when they agree ==== //
+static backtestResult checkParity(const std::unordered_map<std::string, AnyValue>& data, config& cfg,
+                                  const std::vector<bool>& entries, const std::vector<bool>& exits, size_t begin, size_t end){
+    cfg.slippage = ExecutionEngine::getSlippageParams(cfg, slippageTable);
+
+    vectorizedBacktester fastPath(data, cfg);
+    backtestResult fast;
+    CHECK(fastPath.run("X", entries, exits, fast, begin, end));
+
+    portfolioBacktester eventLoop(data, cfg);
+    eventLoop.addTicker("X", entries, exits, begin, end);
+    eventLoop.execute();
+    const backtestResult slow = eventLoop.result();
+
+    CHECK(fast.tradeCount() == slow.tradeCount());
+    CHECK(sameTrades(fast.trades, slow.trades));
+    CHECK(fast.realizedPnL == slow.realizedPnL);
+    CHECK(fast.finalEquity == slow.finalEquity);
+    CHECK(fast.metrics.equityCurve() == slow.metrics.equityCurve());
+    return fast;
+}
+
+static void randomCases(){
+    const size_t bars = 300;
+
+    for (uint32_t run = 0; run < 40; run++){
+        fixtureCase fixture(run, {"X"}, bars);
+        const auto entries = fixtureSignals(fixture.rng, bars, 7);
+        const auto exits = fixtureSignals(fixture.rng, bars, 9);
+
+        std::unordered_map<std::string, AnyValue> variables;
+        config cfg(&variables);
+        cfg.equity = 10000;
+        cfg.riskPerTrade = 0.1 * (1 + run % 5);
+        cfg.stopLossBps = 80;
+        cfg.takeProfitBps = (run % 4) * 50;
+        cfg.commissionBps = 0.5;
+        cfg.spread = 1;
+        cfg.impactModel = static_cast<ImpactModel>(run % 4);
+
+        const auto fast = checkParity(*fixture.data, cfg, entries, exits, run % 50, bars - run % 30);
+        CHECK(fast.tradeCount() > 0);
+    }
+}
+
+// ====================================================== //
+//                  Hand-made trigger edges
+// - Flat bars at 100, entry signal on bar 10 (filled at
+//   bar 11's open), signal exit on bar 20 (bar 21's open)
+// - Stop 80 bps, target 100 bps under the entry fill
+// ====================================================== //
+
+#define EDGE_BARS 40
+
+static void setBar(std::unordered_map<std::string, AnyValue>& data, size_t bar, double open, double high, double low, double close){
+    std::get<std::vector<double>>(data["X_open"])[bar] = open;
+    std::get<std::vector<double>>(data["X_high"])[bar] = high;
+    std::get<std::vector<double>>(data["X_low"])[bar] = low;
+    std::get<std::vector<double>>(data["X_close"])[bar] = close;
+}
+
+static void edgeCase(const std::function<void(std::unordered_map<std::string, AnyValue>&)>& shape, size_t exitBar){
+    std::unordered_map<std::string, AnyValue> data;
+    Octurn::timeSeries stamps;
+    for (size_t i = 0; i < EDGE_BARS; i++) stamps.push_back(static_cast<int64_t>(i) * 3000);
+    for (const char* field : {"X_open", "X_high", "X_low", "X_close"}) data[field] = std::vector<double>(EDGE_BARS, 100.0);
+    data["X_volume"] = std::vector<double>(EDGE_BARS, 1e7);
+    data["X_timestamp"] = stamps;
+    shape(data);
+
+    std::vector<bool> entries(EDGE_BARS, false), exits(EDGE_BARS, false);
+    entries[10] = true;
+    exits[20] = true;
+
+    std::unordered_map<std::string, AnyValue> variables;
+    config cfg(&variables);
+    cfg.equity = 10000;
+    cfg.riskPerTrade = 0.5;
+    cfg.stopLossBps = 80;
+    cfg.takeProfitBps = 100;
+    cfg.commissionBps = 0.5;
+    cfg.spread = 1;
+
+    const auto fast = checkParity(data, cfg, entries, exits, 0, EDGE_BARS);
+    CHECK(fast.tradeCount() == 1);
+    if (fast.tradeCount() == 1) CHECK(fast.trades.exitIdx[0] == exitBar);
+}
+
+static void edgeCases(){
+    // ==== Nothing touched: the signal exit ==== //
+    edgeCase([](auto&){}, 21);
+    // ==== Gap down through the stop: the bar opens below it ==== //
+    edgeCase([](auto& data){ setBar(data, 15, 95.0, 95.5, 94.0, 95.0); }, 15);
+    // ==== Gap up past the target ==== //
+    edgeCase([](auto& data){ setBar(data, 15, 105.0, 106.0, 104.5, 105.0); }, 15);
+    // ==== Stop touched on the entry bar itself ==== //
+    edgeCase([](auto& data){ setBar(data, 11, 100.0, 100.0, 98.0, 99.0); }, 11);
+    // ==== Stop touched on the bar the signal exit fills at the open ==== //
+    edgeCase([](auto& data){ setBar(data, 21, 100.0, 100.0, 98.0, 98.5); }, 21);
+    // ==== One bar spans both stop and target ==== //
+    edgeCase([](auto& data){ setBar(data, 15, 100.0, 102.0, 98.0, 100.0); }, 15);
+}
+
+int main(){
+    randomCases();
+    edgeCases();
+    return testResult("vectorizedParityTest");
+}
@@ -0,0 +1,111 @@
+#include "tests/testSupport.hpp"
+
+#include <memory>
+
+#include "backtester/backtestRunner.hpp"
+#include "backtester/walkForward.hpp"
+#include "interpreter/Interpreter.hpp"
+#include "lexer/Lexer.hpp"
+#include "marketDataView/DataLayer.hpp"
+#include "parser/Parser.hpp"
+
+// ====================================================== //
+//                     Walk-forward
+// - Window split for rolling and anchored runs
+// - walkForwardScript (the --walkforward driver) against
+//   a sequential replay: per window, best in-sample
+//   candidate and its out-of-sample run must match
+// ====================================================== //
+
+static const char* SCRIPT =
+    "config { equity: 10000 riskPerTrade: 1 stopLossBps: 80 } "
+    "data [ { ticker: X timespan: day multiplier: 1 from: 2025-01-01 to: 2025-12-31 } ] "
+    "strategy Cross { parameters { fast: 5 slow: 20 } "
+    "indicators { F = MA(X_close, fast) S = MA(X_close, slow) } "
+    "entry { when F > S } exit { when F < S } }";
+
+static void checkSplit(){
+    const auto rolling = splitWalkForward(400, {100, 50});
+    CHECK(rolling.size() == 6);
+    CHECK(rolling[1].inSampleBegin == 50 && rolling[1].inSampleEnd == 150);
+    CHECK(rolling[1].outOfSampleBegin == 150 && rolling[1].outOfSampleEnd == 200);
+    CHECK(rolling.back().outOfSampleEnd == 400);
+
+    const auto anchored = splitWalkForward(400, {100, 50, true});
+    CHECK(anchored.size() == rolling.size());
+    CHECK(anchored[3].inSampleBegin == 0 && anchored[3].inSampleEnd == rolling[3].inSampleEnd);
+}
+
+static std::shared_ptr<const syntaxTree> parseScript(){
+    Lexer lexer(SCRIPT);
+    Parser parser(lexer.get_tokens());
+    return parser.parse();
+}
+
+// ==== Replays every window sequentially, returns the number of trades seen ==== //
+static size_t checkReplay(const std::vector<walkForwardResult>& results, const std::vector<strategyCandidate>& candidates,
+                          const std::unordered_map<std::string, AnyValue>& data, const config& base){
+    size_t trades = 0;
+    for (const auto& result : results){
+        const auto& window = result.window;
+
+        size_t best = 0;
+        double bestEquity = 0.0;
+        for (size_t c = 0; c < candidates.size(); c++){
+            config cfg = base;
+            const auto inSample = runBacktest(data, cfg, "X", candidates[c].entries, candidates[c].exits,
+                                              window.inSampleBegin, window.inSampleEnd);
+            if (c == 0 || inSample.finalEquity > bestEquity){
+                best = c;
+                bestEquity = inSample.finalEquity;
+            }
+        }
+
+        config cfg = base;
+        const auto outOfSample = runBacktest(data, cfg, "X", candidates[best].entries, candidates[best].exits,
+                                             window.outOfSampleBegin, window.outOfSampleEnd);
+
+        CHECK(result.bestCandidate == best);
+        CHECK(result.parameters == candidates[best].parameters);
+        CHECK(result.inSample.finalEquity == bestEquity);
+        CHECK(result.outOfSample.finalEquity == outOfSample.finalEquity);
+        CHECK(result.outOfSample.trades.pnl == outOfSample.trades.pnl);
+        trades += result.inSample.tradeCount() + result.outOfSample.tradeCount();
+    }
+    return trades;
+}
+
+int main(){
+    checkSplit();
+
+    const fixtureCase fixture(0, {"X"}, 400);
+    const std::shared_ptr<const std::unordered_map<std::string, AnyValue>> shared = fixture.data;
+
+    const parameterGrid grid{{"fast", {3, 5, 8}}, {"slow", {20, 30}}};
+    const walkForwardOptions options{100, 50, false, 2};
+    const auto tree = parseScript();
+
+    const auto results = walkForwardScript(tree, MarketDataView(shared), grid, options);
+    CHECK(results.size() == 6);
+
+    Interpreter interpreter(tree, MarketDataView(shared));
+    interpreter.run();
+    const auto candidates = buildCandidates(interpreter, grid);
+    CHECK(candidates.size() == 6);
+    checkReplay(results, candidates, *shared, interpreter.get_config());
+
+    // ==== riskPerTrade 1 over an 80 bps stop asks for more than the free cash, rerun with a fractional risk so entries fill ==== //
+    config cfg = interpreter.get_config();
+    cfg.riskPerTrade = 0.3;
+    const auto sized = walkForward(*shared, cfg, "X").run(candidates, options);
+    CHECK(sized.size() == results.size());
+    CHECK(checkReplay(sized, candidates, *shared, cfg) > 0);
+
+    const auto report = walkForwardReport(sized);
+    CHECK(report.size() == sized.size());
+    CHECK(report[0]["parameters"]["fast"] == sized[0].parameters.at("fast"));
+    CHECK(report[0]["outOfSample"][1] == sized[0].window.outOfSampleEnd);
+    CHECK(report[0]["outOfSampleResult"]["trades"] == sized[0].outOfSample.tradeCount());
+
+    return testResult("walkForwardTest");
+}
@@ -0,0 +1,111 @@
+#include "positionLedger.hpp"
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+#include "execution/orderBook.hpp"
+#include "snapshot/snapshot.hpp"
+
+// ==== Residue of repeated partial reductions, relative to the position size ==== //
+#define FLAT_EPS 1e-12
+
+uint32_t positionLedger::addTicker(const std::string& ticker){
+    tickers_.push_back(ticker);
+    positions_.emplace_back();
+    return static_cast<uint32_t>(tickers_.size() - 1);
+}
+
+const std::string& positionLedger::tickerName(uint32_t tickerId) const {
+    if (tickerId >= tickers_.size()) throw std::runtime_error(std::format("Unknown ticker id {}", tickerId));
+    return tickers_[tickerId];
+}
+
+void positionLedger::hold(uint32_t tickerId){
+    auto& position = positions_[tickerId];
+    if (position.heldSlot != UINT32_MAX) return;
+
+    position.heldSlot = static_cast<uint32_t>(held_.size());
+    held_.push_back(tickerId);
+}
+
+// ==== Swap-and-pop, the moved ticker takes over the slot ==== //
+void positionLedger::flatten(uint32_t tickerId){
+    auto& position = positions_[tickerId];
+    position.netQty = 0.0;
+    position.avgCost = 0.0;
+    if (position.heldSlot == UINT32_MAX) return;
+
+    const uint32_t last = held_.back();
+    held_[position.heldSlot] = last;
+    positions_[last].heldSlot = position.heldSlot;
+    held_.pop_back();
+    position.heldSlot = UINT32_MAX;
+}
+
+// ====================================================== //
+//                        Fill
+// - Same direction: avgCost = (avg * |net| + price * qty) / (|net| + qty)
+// - Opposite: realize (price - avg) * closed on the reduced part
+// ====================================================== //
+
+double positionLedger::onFill(uint32_t tickerId, ordertype side, double qty, double price, double commission){
+    if (tickerId >= positions_.size()) throw std::runtime_error(std::format("Unknown ticker id {}", tickerId));
+    if (qty <= 0.0) return 0.0;
+
+    auto& position = positions_[tickerId];
+    const double signedQty = (side == ordertype::Buy) ? qty : -qty;
+    const double held = std::abs(position.netQty);
+
+    position.commission += commission;
+
+    if (position.netQty == 0.0 || (position.netQty > 0.0) == (signedQty > 0.0)){
+        position.avgCost = (position.avgCost * held + price * qty) / (held + qty);
+        position.netQty += signedQty;
+        position.realizedPnL -= commission;
+        hold(tickerId);
+        return -commission;
+    }
+
+    const double closed = std::min(qty, held);
+    const double direction = (position.netQty > 0.0) ? 1.0 : -1.0;
+    const double pnl = (price - position.avgCost) * closed * direction - commission;
+    position.realizedPnL += pnl;
+
+    const double next = position.netQty + signedQty;
+    if (std::abs(next) <= FLAT_EPS * std::max(held, qty)){
+        flatten(tickerId);
+    } else {
+        if ((next > 0.0) != (position.netQty > 0.0)) position.avgCost = price;
+        position.netQty = next;
+    }
+
+    return pnl;
+}
+
+double positionLedger::onFill(const orderFill& fill){
+    return onFill(fill.tickerId, fill.side, fill.qty, fill.price, fill.commission);
+}
+
+double positionLedger::realizedPnL() const {
+    double total{0};
+    for (const auto& position : positions_) total += position.realizedPnL;
+    return total;
+}
+
+void positionLedger::clear(){
+    for (auto& position : positions_) position = ledgerPosition{};
+    held_.clear();
+}
+
+void positionLedger::save(snapshotWriter& out) const {
+    out.putVector(positions_);
+    out.putVector(held_);
+}
+
+void positionLedger::load(snapshotReader& in){
+    const size_t tickers = positions_.size();
+    in.getVector(positions_);
+    in.getVector(held_);
+    if (positions_.size() != tickers) throw std::runtime_error("Ledger snapshot has a different ticker count");
+}
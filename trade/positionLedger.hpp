@@ -0,0 +1,76 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "marketTypes/marketTypes.hpp"
+
+struct orderFill;
+class snapshotWriter;
+class snapshotReader;
+
+struct ledgerPosition {
+    double netQty = 0.0;        // > 0 long, < 0 short
+    double avgCost = 0.0;       // VWAP of the open quantity
+    double realizedPnL = 0.0;   // net of commission
+    double commission = 0.0;
+    uint32_t heldSlot = UINT32_MAX;   // index into held(), UINT32_MAX when flat
+};
+
+// ====================================================== //
+//                 Net position ledger
+// - One running position per ticker id, fills update
+//   quantity / average cost / realized PnL in O(1)
+// - Reducing fills realize against the average cost,
+//   a fill through zero reopens the rest at its price
+// - held() lists the non-flat tickers only, marks and
+//   exposure cost O(tickers held) per bar
+// ====================================================== //
+class positionLedger {
+    private:
+        std::vector<std::string> tickers_;
+        std::vector<ledgerPosition> positions_;
+        std::vector<uint32_t> held_;
+
+        void hold(uint32_t tickerId);
+        void flatten(uint32_t tickerId);
+
+    public:
+        uint32_t addTicker(const std::string& ticker);
+        const std::string& tickerName(uint32_t tickerId) const;
+
+        // ==== Returns the PnL realized by this fill ==== //
+        double onFill(uint32_t tickerId, ordertype side, double qty, double price, double commission = 0.0);
+        double onFill(const orderFill& fill);
+
+        const ledgerPosition& position(uint32_t tickerId) const { return positions_[tickerId]; }
+        const std::vector<uint32_t>& held() const { return held_; }
+        double realizedPnL() const;
+
+        // ==== priceOf(tickerId) -> mark price, called for held tickers only ==== //
+        template <typename PriceOf>
+        double unrealizedPnL(PriceOf&& priceOf) const {
+            double total{0};
+            for (uint32_t id : held_){
+                const auto& position = positions_[id];
+                total += (priceOf(id) - position.avgCost) * position.netQty;
+            }
+            return total;
+        }
+
+        template <typename PriceOf>
+        double grossExposure(PriceOf&& priceOf) const {
+            double total{0};
+            for (uint32_t id : held_){
+                total += std::abs(priceOf(id) * positions_[id].netQty);
+            }
+            return total;
+        }
+
+        void clear();
+
+        // ==== Positions and the held list, tickers must be added in the same order before load() ==== //
+        void save(snapshotWriter& out) const;
+        void load(snapshotReader& in);
+};
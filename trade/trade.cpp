@@ -1,13 +1,36 @@
 #include "trade.hpp"
+#include "snapshot/snapshot.hpp"
 
-trade::trade(const std::string& ticker_):ticker(ticker_){
-    generateTradeID();
+trade::trade(const std::string& ticker_):ticker(ticker_){}
+
+void trade::changeTradeStatusToClosed(){
+    status = tradeStatus::CLOSED;
 }
 
-void trade::generateTradeID(){
-    ID = "[TRADE] " + ticker + " - " + timestamp.entryTimestamp; 
+void trade::save(snapshotWriter& out) const {
+    out.putString(ticker);
+    out.put(ID);
+    out.put(usedMargin);
+    out.put(borrowAccrued);
+    out.put(realizedPnL);
+    out.put(timestamp);
+    out.putVector(executionPrice);
+    out.put(type);
+    out.put(qty);
+    out.put(price);
+    out.put(status);
 }
 
-void trade::changeTradeStatusToClosed(){
-    status = tradeStatus::CLOSED;
-}
\ No newline at end of file
+void trade::load(snapshotReader& in){
+    ticker = in.getString();
+    ID = in.get<uint64_t>();
+    usedMargin = in.get<double>();
+    borrowAccrued = in.get<double>();
+    realizedPnL = in.get<double>();
+    timestamp = in.get<struct timestamp>();
+    in.getVector(executionPrice);
+    type = in.get<ordertype>();
+    qty = in.get<QtyState>();
+    price = in.get<PriceState>();
+    status = in.get<tradeStatus>();
+}
@@ -1,26 +1,34 @@
+#pragma once
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "marketTypes/marketTypes.hpp"
 
+class snapshotWriter;
+class snapshotReader;
+
 struct trade {
     std::string ticker;
-    std::string ID;
+    uint64_t ID = 0;
 
-    double usedMargin;
-    double borrowAccrued;
+    double usedMargin = 0.0;
+    double borrowAccrued = 0.0;
+    double realizedPnL = 0.0;
 
     timestamp timestamp;
 
     std::vector<PriceQty> executionPrice;
 
-    ordertype type;
+    ordertype type = ordertype::Buy;
     QtyState qty;
-    PriceState price;
+    PriceState price{};
 
-    tradeStatus status;
+    tradeStatus status = tradeStatus::PENDING;
     
     trade(const std::string& ticker_);
     
-    void generateTradeID();
     void changeTradeStatusToClosed();
+
+    void save(snapshotWriter& out) const;
+    void load(snapshotReader& in);
 };
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "tradeLog.hpp"
+
+#include <format>
+#include <sstream>
+#include <stdexcept>
+
+#include "utils/timeIndex.hpp"
+#include "snapshot/snapshot.hpp"
+
+uint32_t tradeLog::addTicker(const std::string& ticker){
+    tickers.push_back(ticker);
+    return static_cast<uint32_t>(tickers.size() - 1);
+}
+
+const std::string& tradeLog::tickerName(uint32_t id) const {
+    if (id >= tickers.size()) throw std::runtime_error(std::format("Trade log has no ticker with id {}", id));
+    return tickers[id];
+}
+
+void tradeLog::reserve(size_t n){
+    tickerId.reserve(n);
+    side.reserve(n);
+    entryIdx.reserve(n);
+    exitIdx.reserve(n);
+    qty.reserve(n);
+    entryPrice.reserve(n);
+    exitPrice.reserve(n);
+    pnl.reserve(n);
+}
+
+uint64_t tradeLog::append(uint32_t ticker, ordertype type, size_t entry, size_t exit,
+                          double filledQty, double avgPrice, double closePrice, double tradePnL){
+    tickerId.push_back(ticker);
+    side.push_back(static_cast<uint8_t>(type));
+    entryIdx.push_back(entry);
+    exitIdx.push_back(exit);
+    qty.push_back(filledQty);
+    entryPrice.push_back(avgPrice);
+    exitPrice.push_back(closePrice);
+    pnl.push_back(tradePnL);
+    return pnl.size() - 1;
+}
+
+void tradeLog::clear(){
+    tickerId.clear();
+    side.clear();
+    entryIdx.clear();
+    exitIdx.clear();
+    qty.clear();
+    entryPrice.clear();
+    exitPrice.clear();
+    pnl.clear();
+}
+
+void tradeLog::save(snapshotWriter& out) const {
+    out.putVector(tickerId);
+    out.putVector(side);
+    out.putVector(entryIdx);
+    out.putVector(exitIdx);
+    out.putVector(qty);
+    out.putVector(entryPrice);
+    out.putVector(exitPrice);
+    out.putVector(pnl);
+}
+
+void tradeLog::load(snapshotReader& in){
+    in.getVector(tickerId);
+    in.getVector(side);
+    in.getVector(entryIdx);
+    in.getVector(exitIdx);
+    in.getVector(qty);
+    in.getVector(entryPrice);
+    in.getVector(exitPrice);
+    in.getVector(pnl);
+}
+
+// ====================================================== //
+//                        Export
+// ====================================================== //
+
+static std::string barTime(const Octurn::timeSeries* stamps, size_t idx){
+    if (stamps && idx < stamps->size()) return formatStamp((*stamps)[idx]);
+    return std::to_string(idx);
+}
+
+static const Octurn::timeSeries* stampsOf(const std::vector<const Octurn::timeSeries*>& stamps, uint32_t id){
+    return id < stamps.size() ? stamps[id] : nullptr;
+}
+
+std::string tradeLog::label(uint64_t id, const Octurn::timeSeries* stamps) const {
+    return std::format("[TRADE] {} - {}", tickerName(tickerId[id]), barTime(stamps, entryIdx[id]));
+}
+
+nlohmann::json tradeLog::toJson(const std::vector<const Octurn::timeSeries*>& stamps) const {
+    nlohmann::json out = nlohmann::json::array();
+
+    for (size_t k = 0; k < size(); k++){
+        const auto* tickerStamps = stampsOf(stamps, tickerId[k]);
+        out.push_back({
+            {"id", k},
+            {"ticker", tickerName(tickerId[k])},
+            {"side", static_cast<ordertype>(side[k]) == ordertype::Buy ? "long" : "short"},
+            {"entry", barTime(tickerStamps, entryIdx[k])},
+            {"exit", barTime(tickerStamps, exitIdx[k])},
+            {"qty", qty[k]},
+            {"entryPrice", entryPrice[k]},
+            {"exitPrice", exitPrice[k]},
+            {"pnl", pnl[k]}
+        });
+    }
+
+    return out;
+}
+
+std::string tradeLog::toCsv(const std::vector<const Octurn::timeSeries*>& stamps) const {
+    std::ostringstream out;
+    out << "id,ticker,side,entry,exit,qty,entryPrice,exitPrice,pnl\n";
+
+    for (size_t k = 0; k < size(); k++){
+        const auto* tickerStamps = stampsOf(stamps, tickerId[k]);
+        out << k << ','
+            << tickerName(tickerId[k]) << ','
+            << (static_cast<ordertype>(side[k]) == ordertype::Buy ? "long" : "short") << ','
+            << barTime(tickerStamps, entryIdx[k]) << ','
+            << barTime(tickerStamps, exitIdx[k]) << ','
+            << qty[k] << ',' << entryPrice[k] << ',' << exitPrice[k] << ',' << pnl[k] << '\n';
+    }
+
+    return out.str();
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "marketTypes/marketTypes.hpp"
+#include "types/types.hpp"
+
+class snapshotWriter;
+class snapshotReader;
+
+// ====================================================== //
+//                 Columnar closed-trade log
+// - Row number = closed trade ID, tickers are uint32 ids
+//   into a name table filled once at setup
+// - Only numbers are stored, append() does not allocate
+//   once reserve() covered the run
+// - Ticker names / timestamps become strings in export only
+// ====================================================== //
+struct tradeLog {
+    std::vector<uint32_t> tickerId;
+    std::vector<uint8_t> side;
+    std::vector<size_t> entryIdx;
+    std::vector<size_t> exitIdx;
+    std::vector<double> qty;
+    std::vector<double> entryPrice;
+    std::vector<double> exitPrice;
+    std::vector<double> pnl;
+
+    std::vector<std::string> tickers;
+
+    uint32_t addTicker(const std::string& ticker);
+    const std::string& tickerName(uint32_t id) const;
+
+    void reserve(size_t n);
+    uint64_t append(uint32_t ticker, ordertype type, size_t entry, size_t exit,
+                    double filledQty, double avgPrice, double closePrice, double tradePnL);
+    void clear();
+
+    // ==== Columns only, the ticker table is rebuilt by setup ==== //
+    void save(snapshotWriter& out) const;
+    void load(snapshotReader& in);
+
+    size_t size() const { return pnl.size(); }
+
+    // ==== stamps[tickerId] (optional) renders entry/exit bar times ==== //
+    std::string label(uint64_t id, const Octurn::timeSeries* stamps = nullptr) const;
+    nlohmann::json toJson(const std::vector<const Octurn::timeSeries*>& stamps = {}) const;
+    std::string toCsv(const std::vector<const Octurn::timeSeries*>& stamps = {}) const;
+};
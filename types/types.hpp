@@ -1,7 +1,11 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
 #include <variant>
@@ -15,13 +19,33 @@ namespace Octurn {
     struct AnyValue;
     using multiValue = std::vector<AnyValue>;
     
-    using NodeMap = std::map<std::string, std::shared_ptr<ASTNode>>;
+    // ==== Children are owned by the arena of their syntax tree ==== //
+    using NodeMap = std::pmr::map<std::string, ASTNode*>;
     using taFunctionCall = std::function<std::vector<double>(const multiValue& args,
-                                                             std::unordered_map<std::string,AnyValue>& variables_,std::unordered_map<std::string, AnyValue>& data_)>;
+                                                             std::unordered_map<std::string,AnyValue>& variables_,const std::unordered_map<std::string, AnyValue>& data_)>;
 
-    struct AnyValue : std::variant<double, bool, std::string, multiValue, std::vector<double>,std::vector<bool>,std::vector<int>> {
-        using base = std::variant<double, bool, std::string, multiValue, std::vector<double>,std::vector<bool>,std::vector<int>>;
+    // ==== Epoch timestamps in nanoseconds (UTC), sorted ascending per ticker ==== //
+    using timeSeries = std::vector<int64_t>;
+
+    struct AnyValue : std::variant<double, bool, std::string, multiValue, std::vector<double>,std::vector<bool>,std::vector<int>,timeSeries> {
+        using base = std::variant<double, bool, std::string, multiValue, std::vector<double>,std::vector<bool>,std::vector<int>,timeSeries>;
         using base::base;
     };
 
+    // ==== Static shape of an expression, inferred before evaluation (Unknown = decided at runtime) ==== //
+    enum class valueType : uint8_t { Unknown, Number, Bool, Text, NumberSeries, BoolSeries };
+
+    // ==== Binary operator specialised for one pair of operand shapes ==== //
+    using binaryKernel = AnyValue (*)(AnyValue& left, AnyValue& right);
+
+    // ==== Lagged read of a series in place: bar i is data[i - lag], NaN (invalid) before bar lag ==== //
+    struct seriesView {
+        const double* data = nullptr;
+        size_t size = 0;
+        size_t lag = 0;
+
+        bool valid(size_t i) const { return i >= lag; }
+        double operator[](size_t i) const { return valid(i) ? data[i - lag] : std::numeric_limits<double>::quiet_NaN(); }
+    };
+
 }
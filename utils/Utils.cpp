@@ -1,6 +1,9 @@
 #include "Utils.hpp"
+#include <cstdlib>
+#include <cstring>
 #include <stdexcept>
 #include "types/types.hpp"
+#include "utils/timeIndex.hpp"
 
 using Octurn::AnyValue;
 using Octurn::multiValue;
@@ -8,16 +11,36 @@ using Octurn::multiValue;
 // ===============================================
 //           Converts string to boolean
 // ===============================================
-bool str_to_bool(const std::string& s) {
+bool str_to_bool(std::string_view s) {
     if (s == "true" || s == "1") return true;
     if (s == "false" || s == "0") return false;
-    throw std::invalid_argument("Invalid boolean string: " + s);
+    throw std::invalid_argument("Invalid boolean string: " + std::string(s));
+}
+
+// ===============================================
+//     Converts a number token without a copy
+//  - Tokens are short, strtod runs on a stack copy
+// ===============================================
+double str_to_number(std::string_view s) {
+    char digits[64];
+    if (s.empty() || s.size() >= sizeof(digits)) {
+        throw std::invalid_argument("Invalid number: " + std::string(s));
+    }
+    std::memcpy(digits, s.data(), s.size());
+    digits[s.size()] = '\0';
+
+    char* end = nullptr;
+    const double value = std::strtod(digits, &end);
+    if (end != digits + s.size()) {
+        throw std::invalid_argument("Invalid number: " + std::string(s));
+    }
+    return value;
 }
 
 // ===============================================
 //  Prints arrays of bools doubles or nested ones
 // ===============================================
-std::string print_any_value(AnyValue& value){
+std::string print_any_value(const AnyValue& value){
     std::string str = "[";
    
     return std::visit([&](const auto& val)->std::string {
@@ -36,6 +59,15 @@ std::string print_any_value(AnyValue& value){
                 double flt = val[i];
                 str += std::to_string(flt);
 
+                if (i+1<val.size()){
+                    str+=",";
+                }
+            }
+        } else if constexpr (std::is_same_v<T,Octurn::timeSeries>){
+            // ==== Timestamps stay int64 ns until printed ==== //
+            for (size_t i=0;i<val.size();i++){
+                str += formatStamp(val[i]);
+
                 if (i+1<val.size()){
                     str+=",";
                 }
@@ -63,9 +95,10 @@ void printVariables(Interpreter& interp){
     }
 
     std::cout << "\nData:\n";
-    for (auto& [key, value] : interp.get_data()) {
+    for (const auto& [key, value] : interp.get_data()) {
         if (std::holds_alternative<std::vector<bool>>(value) ||
-            std::holds_alternative<std::vector<double>>(value)) {
+            std::holds_alternative<std::vector<double>>(value) ||
+            std::holds_alternative<Octurn::timeSeries>(value)) {
             auto str = print_any_value(value);
             std::cout << "  " << key << " = " << str << "\n";
         }
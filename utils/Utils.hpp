@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include "interpreter/Interpreter.hpp"
 #include "types/types.hpp"
 
@@ -8,9 +9,12 @@
 // ===============================================
 
 // Used to convert tokenized version in real bool
-bool str_to_bool(const std::string& s);
+bool str_to_bool(std::string_view s);
 
-std::string print_any_value(Octurn::AnyValue& value);
+// Number token to double, throws on anything that is not a number
+double str_to_number(std::string_view s);
+
+std::string print_any_value(const Octurn::AnyValue& value);
 
 void printVariables(Interpreter& interp);
 
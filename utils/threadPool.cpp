@@ -0,0 +1,47 @@
+#include "utils/threadPool.hpp"
+
+#include <algorithm>
+
+threadPool::threadPool(size_t threads) {
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+        workers_.emplace_back([this](){ workerLoop(); });
+    }
+}
+
+// ==== Drains queued tasks before joining ==== //
+threadPool::~threadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+size_t threadPool::size() const {
+    return workers_.size();
+}
+
+void threadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this](){ return stopping_ || !tasks_.empty(); });
+
+            if (stopping_ && tasks_.empty()) return;
+
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+        task();
+    }
+}
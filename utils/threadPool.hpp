@@ -0,0 +1,51 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// ===============================================
+//              Fixed size thread pool
+// - Workers are started once and reused for every task
+// - submit() returns a future, exceptions thrown inside
+//   the task are rethrown on future.get()
+// ===============================================
+class threadPool {
+    public:
+        // 0 -> one worker per hardware thread
+        explicit threadPool(size_t threads = 0);
+        ~threadPool();
+
+        threadPool(const threadPool&) = delete;
+        threadPool& operator=(const threadPool&) = delete;
+
+        size_t size() const;
+
+        template <typename F>
+        auto submit(F&& task) -> std::future<std::invoke_result_t<F>> {
+            using R = std::invoke_result_t<F>;
+
+            auto packaged = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+            std::future<R> result = packaged->get_future();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                tasks_.emplace([packaged](){ (*packaged)(); });
+            }
+            cv_.notify_one();
+            return result;
+        }
+
+    private:
+        void workerLoop();
+
+        std::vector<std::thread> workers_;
+        std::queue<std::function<void()>> tasks_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stopping_ = false;
+};
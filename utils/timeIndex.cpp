@@ -0,0 +1,68 @@
+#include "utils/timeIndex.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <stdexcept>
+
+size_t stampLowerBound(const timeSeries& stamps, int64_t ns) {
+    return static_cast<size_t>(std::lower_bound(stamps.begin(), stamps.end(), ns) - stamps.begin());
+}
+
+size_t stampUpperBound(const timeSeries& stamps, int64_t ns) {
+    return static_cast<size_t>(std::upper_bound(stamps.begin(), stamps.end(), ns) - stamps.begin());
+}
+
+size_t stampToIndex(const timeSeries& stamps, int64_t ns) {
+    size_t upper = stampUpperBound(stamps, ns);
+    if (upper == 0) {
+        throw std::runtime_error(std::format("Timestamp {} precedes the first bar", formatStamp(ns)));
+    }
+    return upper - 1;
+}
+
+std::pair<size_t, size_t> stampRange(const timeSeries& stamps, int64_t fromNs, int64_t toNs) {
+    if (toNs < fromNs) {
+        throw std::runtime_error("Time range is inverted: 'to' precedes 'from'");
+    }
+    return {stampLowerBound(stamps, fromNs), stampUpperBound(stamps, toNs)};
+}
+
+// ====================================================== //
+//                  Date <-> epoch ns
+// - Civil calendar conversion is delegated to <chrono>
+// - No locale or timezone lookups, everything is UTC
+// ====================================================== //
+
+int64_t dateToStamp(const std::string& date) {
+    int y = 0;
+    unsigned m = 0, d = 0;
+    if (date.size() != 10 || date[4] != '-' || date[7] != '-') {
+        throw std::runtime_error(std::format("Invalid date '{}', expected YYYY-MM-DD", date));
+    }
+
+    y = std::stoi(date.substr(0, 4));
+    m = static_cast<unsigned>(std::stoi(date.substr(5, 2)));
+    d = static_cast<unsigned>(std::stoi(date.substr(8, 2)));
+
+    const std::chrono::year_month_day ymd{std::chrono::year{y}, std::chrono::month{m}, std::chrono::day{d}};
+    if (!ymd.ok()) {
+        throw std::runtime_error(std::format("Invalid date '{}'", date));
+    }
+
+    const auto days = std::chrono::sys_days{ymd}.time_since_epoch().count();
+    return static_cast<int64_t>(days) * NS_PER_DAY;
+}
+
+std::string formatStamp(int64_t ns) {
+    using namespace std::chrono;
+
+    const sys_time<nanoseconds> tp{nanoseconds{ns}};
+    const auto dayPoint = floor<days>(tp);
+    const year_month_day ymd{dayPoint};
+    const hh_mm_ss<seconds> hms{floor<seconds>(tp - dayPoint)};
+
+    return std::format("{:04}-{:02}-{:02} {:02}:{:02}:{:02}",
+        static_cast<int>(ymd.year()), static_cast<unsigned>(ymd.month()), static_cast<unsigned>(ymd.day()),
+        hms.hours().count(), hms.minutes().count(), hms.seconds().count());
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include "types/types.hpp"
+
+using Octurn::timeSeries;
+
+// ===============================================
+//      Epoch nanosecond timestamps helpers
+// - Timestamps are kept as int64 ns since epoch (UTC)
+// - All lookups assume an ascending series -> O(log n)
+// - Strings are produced only when printing/exporting
+// ===============================================
+
+inline constexpr int64_t NS_PER_MS = 1'000'000;
+inline constexpr int64_t NS_PER_SEC = 1'000'000'000;
+inline constexpr int64_t NS_PER_DAY = 86'400 * NS_PER_SEC;
+
+// Milliseconds (Polygon "t" field) to nanoseconds
+constexpr int64_t msToNs(int64_t ms) { return ms * NS_PER_MS; }
+
+// First index with stamp >= ns (stamps.size() if none)
+size_t stampLowerBound(const timeSeries& stamps, int64_t ns);
+
+// First index with stamp > ns (stamps.size() if none)
+size_t stampUpperBound(const timeSeries& stamps, int64_t ns);
+
+// Index of the last bar at or before ns, throws if ns precedes the series
+size_t stampToIndex(const timeSeries& stamps, int64_t ns);
+
+// Half-open index range [first, last) of bars with from <= stamp <= to
+std::pair<size_t, size_t> stampRange(const timeSeries& stamps, int64_t fromNs, int64_t toNs);
+
+// "YYYY-MM-DD" (DSL date token) to ns at 00:00:00 UTC
+int64_t dateToStamp(const std::string& date);
+
+// ns to "YYYY-MM-DD HH:MM:SS" (UTC), used only at output time
+std::string formatStamp(int64_t ns);